@@ -9,8 +9,11 @@
 //////////////////////////////////////////
 
 #include "MmcfeExtension.h"
+#include "MmcfeReweighting.h"
 #include "Libraries/Framework/Math/Approximation.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
 #include <math.h>
+#include <pthread.h>
 #include <Libraries/ProgressPrint/ProgressPrint.h>
 #include <Libraries/Simulator/Data/SimContext/SimulationContextAccess.h>
 
@@ -21,6 +24,30 @@
 #define MMCFE_HISTOCOL_NAME     "Histogram"
 #define MMCFE_TIMECOL_NAME      "TimeStamp"
 #define MMCFE_ALPHACOL_NAME     "Alpha"
+#define MMCFE_DELTATABLE_NAME   "LatticeDeltas"
+#define MMCFE_KEYENTRY_INTERVAL 50
+#define MMCFE_COMMIT_INTERVAL   32
+#define MMCFE_COMMIT_SECONDS    60
+
+// Type for a worker of the concurrent MMCFE execution. Each worker executes one alpha phase of a batch on its own context
+typedef struct MmcfeWorker
+{
+    // The simulation context of the worker, worker zero uses the main context
+    SimulationContext_t*    Context;
+
+    // The routine log of the alpha phase that is executed by the worker
+    MmcfeLog_t              Log;
+
+    // The thread handle of the worker
+    pthread_t               Thread;
+
+    // Flag that marks if the worker has an alpha phase in the current batch
+    bool_t                  IsActive;
+
+} MmcfeWorker_t;
+
+// Type for the worker span of the concurrent MMCFE execution
+typedef Span_t(MmcfeWorker_t, MmcfeWorkers) MmcfeWorkers_t;
 
 /* Extension interface implementation */
 
@@ -52,7 +79,7 @@ static const char* BuildDefaultLogDbFilePath(SCONTEXT_PARAMETER)
 static error_t TryGetLastDbLogEntry(sqlite3* db, MmcfeLog_t*restrict outLog)
 {
     debug_assert(outLog != NULL);
-    let sqlQuery = "SELECT Id, " MMCFE_PARAMSCOL_NAME " FROM " MMCFE_LOGTABLE_NAME " ORDER BY Id DESC";
+    let sqlQuery = "SELECT Id, " MMCFE_PARAMSCOL_NAME " FROM " MMCFE_LOGTABLE_NAME " ORDER BY " MMCFE_ALPHACOL_NAME " DESC, Id DESC";
     sqlite3_stmt* sqlStmt;
 
     var error = sqlite3_prepare_v2(db, sqlQuery, -1,&sqlStmt,NULL);
@@ -111,7 +138,8 @@ sqlite3* OpenMmcfeLogDatabase(const char* dbPath, MmcfeLog_t*restrict outLog)
     return db;
 }
 
-error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry)
+// Inserts an MMCFE log entry with the passed state data into the log table. An empty state is written as a zero length blob
+static error_t InsertMmcfeLogEntry(sqlite3* db, const MmcfeLog_t*restrict logEntry, const Buffer_t*restrict state)
 {
     let sqlQuery = "INSERT INTO " MMCFE_LOGTABLE_NAME " ("
                    MMCFE_TIMECOL_NAME       ", "
@@ -130,10 +158,10 @@ error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry)
     error = sqlite3_bind_text(sqlStmt, 1, timeStamp, -1, NULL);
     return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
 
-    let stateByteCount = span_ByteCount(logEntry->StateBuffer);
+    let stateByteCount = span_ByteCount(*state);
     return_if(stateByteCount > INT32_MAX, ERR_DATABASE);
 
-    error = sqlite3_bind_blob(sqlStmt, 2, logEntry->StateBuffer.Begin, stateByteCount, NULL);
+    error = (stateByteCount > 0) ? sqlite3_bind_blob(sqlStmt, 2, state->Begin, stateByteCount, NULL) : sqlite3_bind_zeroblob(sqlStmt, 2, 0);
     return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
 
     let histogramByteCount = (void*) logEntry->Histogram.Counters.End - (void*) logEntry->Histogram.Header;
@@ -155,6 +183,138 @@ error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry)
     return ERR_OK;
 }
 
+error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry)
+{
+    return InsertMmcfeLogEntry(db, logEntry, &logEntry->StateBuffer);
+}
+
+// Executes the passed sql statement without result rows on the passed database
+static error_t ExecuteSqlStatement(sqlite3* db, const char* sqlQuery)
+{
+    return sqlite3_exec(db, sqlQuery, NULL, NULL, NULL) == SQLITE_OK ? ERR_OK : ERR_DATABASE;
+}
+
+error_t OpenMmcfeLogWriter(MmcfeLogWriter_t*restrict writer, sqlite3* db, const int32_t storageMode)
+{
+    let createQuery = "CREATE TABLE IF NOT EXISTS " MMCFE_DELTATABLE_NAME " ("
+                      "Id INTEGER PRIMARY KEY, LogEntryId INTEGER NOT NULL, PreviousEntryId INTEGER NOT NULL, Changes BLOB NOT NULL)";
+
+    nullStructContent(*writer);
+    writer->Database = db;
+    writer->StorageMode = storageMode;
+    writer->LastCommitTime = time(NULL);
+    if (storageMode == MMCFE_LOGMODE_DELTA)
+    {
+        var error = ExecuteSqlStatement(db, createQuery);
+        return_if(error, error);
+    }
+    return ExecuteSqlStatement(db, "BEGIN");
+}
+
+// Collects the lattice changes to the reference lattice of the writer. Returns false if the change list is full and a key entry is cheaper
+static bool_t TryCollectLatticeChanges(MmcfeLogWriter_t*restrict writer, const LatticeState_t*restrict lattice)
+{
+    list_Clear(writer->Changes);
+    for (int32_t i = 0; i < span_Length(*lattice); i++)
+    {
+        continue_if(span_Get(*lattice, i) == span_Get(writer->ReferenceLattice, i));
+        return_if(list_IsFull(writer->Changes), false);
+        list_PushBack(writer->Changes, ((MmcfeLatticeChange_t) {.EnvironmentId = i, .ParticleId = span_Get(*lattice, i)}));
+    }
+    return true;
+}
+
+// Inserts the lattice changes of the last inserted log entry relative to the previous entry into the delta table
+static error_t InsertLatticeChangesOfLastEntry(MmcfeLogWriter_t*restrict writer)
+{
+    let sqlQuery = "INSERT INTO " MMCFE_DELTATABLE_NAME " (LogEntryId, PreviousEntryId, Changes) VALUES (?1, ?2, ?3)";
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(writer->Database, sqlQuery, -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    let changesByteCount = span_ByteCount(writer->Changes);
+    sqlite3_bind_int64(sqlStmt, 1, sqlite3_last_insert_rowid(writer->Database));
+    sqlite3_bind_int64(sqlStmt, 2, writer->LastEntryId);
+    error = (changesByteCount > 0) ? sqlite3_bind_blob(sqlStmt, 3, writer->Changes.Begin, changesByteCount, NULL) : sqlite3_bind_zeroblob(sqlStmt, 3, 0);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_step(sqlStmt);
+    sqlite3_finalize(sqlStmt);
+    return (error == SQLITE_DONE) ? ERR_OK : ERR_DATABASE;
+}
+
+// Writes a log entry in the delta storage mode. Key entries with the full state are written initially, periodically and if the change list exceeds its capacity
+static error_t WriteMmcfeDeltaEntry(MmcfeLogWriter_t*restrict writer, const MmcfeLog_t*restrict logEntry)
+{
+    error_t error;
+    let lattice = &logEntry->Lattice;
+    if (writer->ReferenceLattice.Begin == NULL)
+    {
+        // Note: A delta that changes more than an eighth of the lattice is larger than the full lattice and is thus replaced by a key entry
+        writer->ReferenceLattice = span_New(writer->ReferenceLattice, span_Length(*lattice));
+        writer->Changes = list_New(writer->Changes, span_Length(*lattice) / sizeof(MmcfeLatticeChange_t) + 1);
+        writer->DeltaEntryCount = MMCFE_KEYENTRY_INTERVAL;
+    }
+
+    let isKeyEntry = (writer->DeltaEntryCount >= MMCFE_KEYENTRY_INTERVAL) || !TryCollectLatticeChanges(writer, lattice);
+    if (isKeyEntry)
+    {
+        error = InsertMmcfeLogEntry(writer->Database, logEntry, &logEntry->StateBuffer);
+        writer->DeltaEntryCount = 0;
+    }
+    else
+    {
+        let emptyState = (Buffer_t) {NULL, NULL};
+        error = InsertMmcfeLogEntry(writer->Database, logEntry, &emptyState);
+        if (error == ERR_OK) error = InsertLatticeChangesOfLastEntry(writer);
+        ++writer->DeltaEntryCount;
+    }
+    return_if(error, error);
+
+    memcpy(writer->ReferenceLattice.Begin, lattice->Begin, span_ByteCount(*lattice));
+    return ERR_OK;
+}
+
+error_t WriteMmcfeEntryToLogWriter(MmcfeLogWriter_t*restrict writer, const MmcfeLog_t*restrict logEntry)
+{
+    error_t error;
+    let emptyState = (Buffer_t) {NULL, NULL};
+    switch (writer->StorageMode)
+    {
+        case MMCFE_LOGMODE_DELTA:
+            error = WriteMmcfeDeltaEntry(writer, logEntry);
+            break;
+        case MMCFE_LOGMODE_HISTOGRAM:
+            // Note: The particle counts of the evaluation are read from a state, thus the first entry of each writer keeps its state
+            error = InsertMmcfeLogEntry(writer->Database, logEntry, (writer->LastEntryId == 0) ? &logEntry->StateBuffer : &emptyState);
+            break;
+        default:
+            error = InsertMmcfeLogEntry(writer->Database, logEntry, &logEntry->StateBuffer);
+            break;
+    }
+    return_if(error, error);
+    writer->LastEntryId = sqlite3_last_insert_rowid(writer->Database);
+
+    // Note: Entries of an open transaction are lost on a crash, the resume then repeats the affected alpha values
+    let now = time(NULL);
+    return_if(++writer->PendingEntryCount < MMCFE_COMMIT_INTERVAL && difftime(now, writer->LastCommitTime) < MMCFE_COMMIT_SECONDS, ERR_OK);
+    writer->PendingEntryCount = 0;
+    writer->LastCommitTime = now;
+    error = ExecuteSqlStatement(writer->Database, "COMMIT");
+    return_if(error, error);
+    return ExecuteSqlStatement(writer->Database, "BEGIN");
+}
+
+error_t CloseMmcfeLogWriter(MmcfeLogWriter_t*restrict writer)
+{
+    let error = ExecuteSqlStatement(writer->Database, "COMMIT");
+    span_Delete(writer->ReferenceLattice);
+    list_Delete(writer->Changes);
+    writer->ReferenceLattice = (LatticeState_t) {NULL, NULL};
+    writer->Changes = (MmcfeLatticeChanges_t) {NULL, NULL, NULL};
+    return error;
+}
+
 // Checks if the routine parameters are valid
 static inline bool_t RoutineParametersAreValid(MmcfeParams_t* restrict params)
 {
@@ -181,7 +341,7 @@ static error_t TryLoadRoutineParameters(SCONTEXT_PARAMETER, MmcfeParams_t*restri
     return_if(CompareMocuuid(routineData->Guid, testGuid) != 0, ERR_DATACONSISTENCY);
 
     let length = span_Length(routineData->ParamData);
-    return_if(length != sizeof(MmcfeParams_t), ERR_DATACONSISTENCY);
+    return_if(length != sizeof(MmcfeParams_t) && length != sizeof(MmcfeParams_t) + sizeof(MmcfeScheduleParams_t), ERR_DATACONSISTENCY);
 
     return_if(!RoutineParametersAreValid((MmcfeParams_t*) routineData->ParamData.Begin), ERR_DATACONSISTENCY);
 
@@ -189,12 +349,30 @@ static error_t TryLoadRoutineParameters(SCONTEXT_PARAMETER, MmcfeParams_t*restri
     return ERR_OK;
 }
 
+// Loads the optional scheduling parameters that follow the MMCFE parameters in the routine data or sets the defaults that disable the alpha insertion
+static void LoadRoutineScheduleParameters(SCONTEXT_PARAMETER, MmcfeScheduleParams_t*restrict outParams)
+{
+    let routineData = getCustomRoutineData(simContext);
+    nullStructContent(*outParams);
+    outParams->ReweightingTolerance = MMCFE_REWEIGHTING_TOLERANCE;
+
+    return_if(CompareMocuuid(routineData->Guid, MOCASSIN_EXTENSION_GET_ENTRY_FUNC()) != 0);
+    return_if(span_Length(routineData->ParamData) != sizeof(MmcfeParams_t) + sizeof(MmcfeScheduleParams_t));
+
+    let params = (MmcfeScheduleParams_t*) (routineData->ParamData.Begin + sizeof(MmcfeParams_t));
+    outParams->MinOverlap = getMaxOfTwo(0.0, params->MinOverlap);
+    outParams->MaxRefineDepth = getMaxOfTwo(0, params->MaxRefineDepth);
+    outParams->LogStorageMode = params->LogStorageMode;
+    if (params->ReweightingTolerance > 0.0) outParams->ReweightingTolerance = params->ReweightingTolerance;
+}
+
 // Initializes the routine log after the parameter state was loaded from either log-db or simulation database
 static error_t InitializeRoutineLog(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log)
 {
     debug_assert(log != NULL);
 
     log->StateBuffer = getSimulationState(simContext)->Buffer;
+    log->Lattice = *getMainStateLattice(simContext);
     log->Histogram = ctor_DynamicJumpHistogram(log->ParamsState.HistogramSize);
     return ERR_OK;
 }
@@ -233,9 +411,11 @@ static int64_t CalculateEtaAtCurrentRateInSeconds(SCONTEXT_PARAMETER, const Mmcf
 {
     let cycleCountPerBlock = log->ParamsState.RelaxPhaseCycleCount + log->ParamsState.LogPhaseCycleCount;
     let alphaStep = (log->ParamsState.AlphaMax - log->ParamsState.AlphaMin) / log->ParamsState.AlphaCount;
-    let remainingAlphaCount = (int32_t) round((log->ParamsState.AlphaMax - log->ParamsState.AlphaCurrent) / alphaStep);
+    let batchSize = getMaxOfTwo(1LL, log->RunInfo.AlphaBatchSize);
+    let remainingAlphaCount = (int32_t) ceil(round((log->ParamsState.AlphaMax - log->ParamsState.AlphaCurrent) / alphaStep) / (double) batchSize);
 
-    let runSeconds = (log->RunInfo.PhaseEndClock - log->RunInfo.PhaseStartClock) / (double) CLOCKS_PER_SEC;
+    // Note: The clock measures the processor time of all concurrent workers
+    let runSeconds = (log->RunInfo.PhaseEndClock - log->RunInfo.PhaseStartClock) / (double) CLOCKS_PER_SEC / (double) batchSize;
     if (!isfinite(runSeconds)) return 0;
     let avgCycleRate = cycleCountPerBlock / runSeconds;
     return (int64_t) ((double)(cycleCountPerBlock * remainingAlphaCount) / avgCycleRate);
@@ -262,11 +442,11 @@ static inline void PrintRoutineProgress(SCONTEXT_PARAMETER, const MmcfeLog_t*res
 }
 
 // Finishes one logging phase of the MMCFE routine
-static inline void FinishLoggingPhase(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, sqlite3*restrict db)
+static inline void FinishLoggingPhase(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, MmcfeLogWriter_t*restrict writer)
 {
     UpdateAndEvaluateMmcAbortConditions(simContext);
     ExecuteSharedMcBlockFinisher(simContext);
-    WriteMmcfeEntryToLogDb(db, log);
+    WriteMmcfeEntryToLogWriter(writer, log);
     PrintRoutineProgress(simContext, log);
 }
 
@@ -310,25 +490,167 @@ static inline void EnterLoggingPhase(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log
     }
 }
 
+// Executes and logs the relaxation and logging phase of the current alpha value
+static void EnterAlphaPhase(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, MmcfeLogWriter_t*restrict writer)
+{
+    log->RunInfo.PhaseStartClock = clock();
+    EnterRelaxationPhase(simContext, log);
+    EnterLoggingPhase(simContext, log);
+    log->RunInfo.PhaseEndClock = clock();
+    FinishLoggingPhase(simContext, log, writer);
+}
+
+// Bisects the alpha interval between two logged neighbors until their histograms overlap sufficiently or the depth limit is reached
+// (The inserted alpha values are logged as normal entries, the log database thus is ordered by alpha only through the alpha column)
+static void RefineAlphaInterval(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, MmcfeLogWriter_t*restrict writer, const DynamicJumpHistogram_t*restrict lower,
+                                const double lowerAlpha, const DynamicJumpHistogram_t*restrict upper, const double upperAlpha, const int32_t depth)
+{
+    return_if(log->ScheduleParams.MinOverlap <= 0.0 || depth >= log->ScheduleParams.MaxRefineDepth);
+    return_if(CalculateDynamicJumpHistogramOverlap(lower, upper) >= log->ScheduleParams.MinOverlap);
+
+    log->ParamsState.AlphaCurrent = 0.5 * (lowerAlpha + upperAlpha);
+    EnterAlphaPhase(simContext, log, writer);
+
+    let middleAlpha = log->ParamsState.AlphaCurrent;
+    var middle = ctor_DynamicJumpHistogram_FromBuffer(log->Histogram.Header);
+    RefineAlphaInterval(simContext, log, writer, lower, lowerAlpha, &middle, middleAlpha, depth + 1);
+    RefineAlphaInterval(simContext, log, writer, &middle, middleAlpha, upper, upperAlpha, depth + 1);
+    free(middle.Header);
+}
+
 // Enters the actual outer MMCFE routine execution phase that performs the simulation with the provided routine log and database
-static error_t EnterExecutionLoop(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, sqlite3*restrict db, const bool_t logLoaded)
+static error_t EnterExecutionLoop(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, MmcfeLogWriter_t*restrict writer, const bool_t logLoaded)
 {
     let alphaStep = (log->ParamsState.AlphaMax - log->ParamsState.AlphaMin) / log->ParamsState.AlphaCount;
     if (logLoaded) log->ParamsState.AlphaCurrent += alphaStep;
 
     UpdateAndEvaluateMmcAbortConditions(simContext);
 
+    DynamicJumpHistogram_t lastHistogram = {NULL, {NULL, NULL}};
+    var lastAlpha = 0.0;
     for (;log->ParamsState.AlphaCurrent <= log->ParamsState.AlphaMax + 1.0e-6;)
     {
-        log->RunInfo.PhaseStartClock = clock();
-        EnterRelaxationPhase(simContext, log);
-        EnterLoggingPhase(simContext, log);
-        log->RunInfo.PhaseEndClock = clock();
+        EnterAlphaPhase(simContext, log, writer);
+
+        let alpha = log->ParamsState.AlphaCurrent;
+        var histogram = ctor_DynamicJumpHistogram_FromBuffer(log->Histogram.Header);
+        if (lastHistogram.Header != NULL) RefineAlphaInterval(simContext, log, writer, &lastHistogram, lastAlpha, &histogram, alpha, 0);
+        free(lastHistogram.Header);
+        lastHistogram = histogram;
+        lastAlpha = alpha;
 
-        FinishLoggingPhase(simContext, log, db);
-        log->ParamsState.AlphaCurrent += alphaStep;
+        log->ParamsState.AlphaCurrent = alpha + alphaStep;
     }
 
+    free(lastHistogram.Header);
+    return ERR_OK;
+}
+
+// Executes the relaxation and logging phase of the alpha that is assigned to the passed worker
+static void RunMmcfeWorkerPhase(MmcfeWorker_t*restrict worker)
+{
+    worker->Log.RunInfo.PhaseStartClock = clock();
+    EnterRelaxationPhase(worker->Context, &worker->Log);
+    EnterLoggingPhase(worker->Context, &worker->Log);
+    worker->Log.RunInfo.PhaseEndClock = clock();
+}
+
+// Entry point of the worker threads of the concurrent MMCFE execution
+static void* MmcfeWorkerThreadMain(void* argument)
+{
+    RunMmcfeWorkerPhase(argument);
+    return NULL;
+}
+
+// Finishes the logging phase of a worker. Only the main context writes the state file, the worker states are synchronized for the log entry
+static void FinishWorkerLoggingPhase(SCONTEXT_PARAMETER, MmcfeWorker_t*restrict worker, MmcfeLogWriter_t*restrict writer)
+{
+    if (worker->Context == simContext)
+    {
+        FinishLoggingPhase(simContext, &worker->Log, writer);
+        return;
+    }
+
+    UpdateAndEvaluateMmcAbortConditions(worker->Context);
+    if (writer->StorageMode != MMCFE_LOGMODE_HISTOGRAM)
+    {
+        SIMERROR = SyncSimulationStateToRunStatus(worker->Context);
+        assert_success(SIMERROR, "Simulation aborted due to failed synchronization between dynamic model and state object.");
+    }
+    WriteMmcfeEntryToLogWriter(writer, &worker->Log);
+    PrintRoutineProgress(worker->Context, &worker->Log);
+}
+
+// Creates the workers of the concurrent MMCFE execution. All workers start from the configuration that is loaded by the main context
+static MmcfeWorkers_t ConstructMmcfeWorkers(SCONTEXT_PARAMETER, const MmcfeLog_t*restrict log, const int32_t workerCount)
+{
+    MmcfeWorkers_t workers = span_New(workers, workerCount);
+    cpp_foreach(worker, workers)
+    {
+        let workerId = (int32_t) (worker - workers.Begin);
+        worker->Context = (workerId == 0) ? simContext : ConstructSharedModelWorkerContext(simContext, workerId);
+        worker->Log = *log;
+        worker->Log.StateBuffer = getSimulationState(worker->Context)->Buffer;
+        worker->Log.Lattice = *getMainStateLattice(worker->Context);
+        worker->Log.RunInfo.AlphaBatchSize = workerCount;
+        if (workerId != 0) worker->Log.Histogram = ctor_DynamicJumpHistogram(log->ParamsState.HistogramSize);
+    }
+    return workers;
+}
+
+// Deletes the workers of the concurrent MMCFE execution except for the main context and its log
+static void DeleteMmcfeWorkers(SCONTEXT_PARAMETER, MmcfeWorkers_t*restrict workers)
+{
+    cpp_foreach(worker, *workers)
+    {
+        continue_if(worker->Context == simContext);
+        free(worker->Log.Histogram.Header);
+        DeleteSimulationContextDynamicBuffers(worker->Context);
+        free(worker->Context);
+    }
+    span_Delete(*workers);
+}
+
+// Enters the concurrent MMCFE execution phase that runs batches of consecutive alpha values on independent context copies
+// (Each worker continues its own chain from batch to batch, the log entries are written in the order of ascending alpha)
+static error_t EnterConcurrentExecutionLoop(SCONTEXT_PARAMETER, MmcfeLog_t*restrict log, MmcfeLogWriter_t*restrict writer, const bool_t logLoaded, const int32_t workerCount)
+{
+    let alphaStep = (log->ParamsState.AlphaMax - log->ParamsState.AlphaMin) / log->ParamsState.AlphaCount;
+    if (logLoaded) log->ParamsState.AlphaCurrent += alphaStep;
+
+    // Note: The alpha insertion depends on the result of the previous alpha and is not used by the concurrent execution
+    if (log->ScheduleParams.MinOverlap > 0.0) fprintf(stdout, "MMCFE  => Adaptive alpha insertion is not supported by the concurrent execution and is skipped\n\n");
+
+    UpdateAndEvaluateMmcAbortConditions(simContext);
+    var workers = ConstructMmcfeWorkers(simContext, log, workerCount);
+
+    for (;log->ParamsState.AlphaCurrent <= log->ParamsState.AlphaMax + 1.0e-6;)
+    {
+        cpp_foreach(worker, workers)
+        {
+            worker->Log.ParamsState.AlphaCurrent = log->ParamsState.AlphaCurrent + (double) (worker - workers.Begin) * alphaStep;
+            worker->IsActive = worker->Log.ParamsState.AlphaCurrent <= log->ParamsState.AlphaMax + 1.0e-6;
+        }
+
+        cpp_offset_foreach(worker, workers, 1)
+        {
+            continue_if(!worker->IsActive);
+            return_if(pthread_create(&worker->Thread, NULL, MmcfeWorkerThreadMain, worker) != 0, ERR_UNKNOWN);
+        }
+        RunMmcfeWorkerPhase(&span_Get(workers, 0));
+        cpp_offset_foreach(worker, workers, 1)
+            if (worker->IsActive) pthread_join(worker->Thread, NULL);
+
+        cpp_foreach(worker, workers)
+        {
+            break_if(!worker->IsActive);
+            FinishWorkerLoggingPhase(simContext, worker, writer);
+            log->ParamsState.AlphaCurrent += alphaStep;
+        }
+    }
+
+    log->Histogram = span_Get(workers, 0).Log.Histogram;
+    DeleteMmcfeWorkers(simContext, &workers);
     return ERR_OK;
 }
 
@@ -352,8 +674,23 @@ static error_t StartRoutineInternal(SCONTEXT_PARAMETER)
 
     error = InitializeRoutineLog(simContext, &routineLog);
     return_if(error, error);
+    LoadRoutineScheduleParameters(simContext, &routineLog.ScheduleParams);
+
+    MmcfeLogWriter_t writer;
+    error = OpenMmcfeLogWriter(&writer, db, routineLog.ScheduleParams.LogStorageMode);
+    return_if(error, error);
+
+    let workerCount = getExtensionThreadCount(simContext);
+    error = (workerCount > 1)
+        ? EnterConcurrentExecutionLoop(simContext, &routineLog, &writer, logLoaded, workerCount)
+        : EnterExecutionLoop(simContext, &routineLog, &writer, logLoaded);
+    return_if(error, error);
+
+    error = CloseMmcfeLogWriter(&writer);
+    return_if(error, error);
 
-    error = EnterExecutionLoop(simContext, &routineLog, db, logLoaded);
+    let betaAtAlphaOne = getPhysicalFactors(simContext)->EnergyFactorEvToKt;
+    error = WriteMmcfeReweightingResultsToLogDb(db, betaAtAlphaOne, getDbModelJobInfo(simContext)->Temperature, routineLog.ScheduleParams.ReweightingTolerance);
     return_if(error, error);
 
     return sqlite3_close(db) != SQLITE_OK ? ERR_DATABASE : ERR_OK;
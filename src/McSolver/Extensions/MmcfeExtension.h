@@ -17,6 +17,15 @@
 
 /* Routine type definitions */
 
+// Defines the log storage mode that writes the full simulation state with each entry
+#define MMCFE_LOGMODE_FULL      0
+
+// Defines the log storage mode that writes the full state for key entries and otherwise only the lattice changes to the previous entry
+#define MMCFE_LOGMODE_DELTA     1
+
+// Defines the log storage mode that writes the simulation state only for the first entry of a run and otherwise only the histogram data
+#define MMCFE_LOGMODE_HISTOGRAM 2
+
 // Type for storage of MMCFE routine parameters
 // Layout@ggc_x86_64 => 56@[4,4,8,8,8,8,8,8]
 typedef struct MmcfeParams
@@ -47,8 +56,26 @@ typedef struct MmcfeParams
 
 } MmcfeParams_t;
 
+// Type for the optional scheduling, storage and reweighting parameters that can follow the MMCFE parameters in the routine data
+// Layout@ggc_x86_64 => 24@[8,4,4,8]
+typedef struct MmcfeScheduleParams
+{
+    // The minimal histogram overlap of neighboring alpha values. A midpoint alpha is inserted if the overlap is below (Zero disables the insertion)
+    double  MinOverlap;
+
+    // The maximal number of bisections of one alpha step
+    int32_t MaxRefineDepth;
+
+    // The log storage mode of the log database
+    int32_t LogStorageMode;
+
+    // The convergence tolerance of the reduced free energies of the multi histogram reweighting
+    double  ReweightingTolerance;
+
+} MmcfeScheduleParams_t;
+
 // Type for holding MMCFE runtime information
-// Layout@ggc_x86_64 => 16@[8,8]
+// Layout@ggc_x86_64 => 24@[8,8,8]
 typedef struct MmcfeRunInfo
 {
     // The clock when the alpha phase was started
@@ -57,10 +84,13 @@ typedef struct MmcfeRunInfo
     // The clock when the alpha phase was finished
     clock_t     PhaseEndClock;
 
+    // The number of alpha phases that are executed concurrently
+    int64_t     AlphaBatchSize;
+
 } MmcfeRunInfo_t;
 
 // Type for holding MMCFE log entry information
-// Layout@ggc_x86_64 => 120@[24,24,16,56]
+// Layout@ggc_x86_64 => 168@[24,24,24,56,24,16]
 typedef struct MmcfeLog
 {
     // The simulation state buffer
@@ -75,8 +105,63 @@ typedef struct MmcfeLog
     // The state of the parameter struct as checkpoint data
     MmcfeParams_t           ParamsState;
 
+    // The scheduling, storage and reweighting parameters
+    MmcfeScheduleParams_t   ScheduleParams;
+
+    // The lattice of the simulation state buffer
+    LatticeState_t          Lattice;
+
 } MmcfeLog_t;
 
+// Type for the change of one lattice site between two log entries
+// Layout@ggc_x86_64 => 8@[4,1,{3}]
+typedef struct MmcfeLatticeChange
+{
+    // The environment id of the changed site
+    int32_t EnvironmentId;
+
+    // The new particle id of the changed site
+    byte_t  ParticleId;
+
+    // Padding bytes
+    byte_t  Padding[3];
+
+} MmcfeLatticeChange_t;
+
+// Type for the lattice change list of a delta log entry
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef List_t(MmcfeLatticeChange_t, MmcfeLatticeChanges) MmcfeLatticeChanges_t;
+
+// Type for the buffered MMCFE log writer that groups the inserts into transactions and applies the log storage mode
+// Layout@ggc_x86_64 => 80@[8,16,24,8,8,4,4,4,{4}]
+typedef struct MmcfeLogWriter
+{
+    // The log database connection
+    sqlite3*                Database;
+
+    // The copy of the lattice of the last written entry
+    LatticeState_t          ReferenceLattice;
+
+    // The change buffer of the delta log mode
+    MmcfeLatticeChanges_t   Changes;
+
+    // The row id of the last written entry
+    int64_t                 LastEntryId;
+
+    // The time of the last transaction commit
+    time_t                  LastCommitTime;
+
+    // The log storage mode
+    int32_t                 StorageMode;
+
+    // The number of entries in the open transaction
+    int32_t                 PendingEntryCount;
+
+    // The number of delta entries since the last key entry
+    int32_t                 DeltaEntryCount;
+
+} MmcfeLogWriter_t;
+
 
 // Public routine start for MMCFE that accepts a simulation context as a void pointer
 void StartMmcfeRoutine(void* context);
@@ -85,4 +170,13 @@ void StartMmcfeRoutine(void* context);
 sqlite3* OpenMmcfeLogDatabase(const char* dbPath, MmcfeLog_t*restrict outLog);
 
 // Adds an MMCFE log entry to the passed sqlite3 database connection
-error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry);
\ No newline at end of file
+error_t WriteMmcfeEntryToLogDb(sqlite3* db, const MmcfeLog_t*restrict logEntry);
+
+// Prepares a log writer with the passed storage mode on an opened log database and starts the first transaction
+error_t OpenMmcfeLogWriter(MmcfeLogWriter_t*restrict writer, sqlite3* db, int32_t storageMode);
+
+// Adds an MMCFE log entry to the passed log writer using its storage mode. The open transaction is committed periodically
+error_t WriteMmcfeEntryToLogWriter(MmcfeLogWriter_t*restrict writer, const MmcfeLog_t*restrict logEntry);
+
+// Commits the open transaction of the log writer and frees its buffers (The database connection stays open)
+error_t CloseMmcfeLogWriter(MmcfeLogWriter_t*restrict writer);
\ No newline at end of file
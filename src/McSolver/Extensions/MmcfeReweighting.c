@@ -0,0 +1,210 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	MmcfeReweighting.c     		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   MMCFE histogram reweighting //
+//////////////////////////////////////////
+
+#include "MmcfeReweighting.h"
+#include <math.h>
+
+#define MMCFE_RESULTTABLE_NAME  "ReweightingResults"
+
+// Type for the histogram span that is loaded from the log database
+typedef Span_t(DynamicJumpHistogram_t, MmcfeHistograms) MmcfeHistograms_t;
+
+// Executes the passed sql statement without result rows on the passed database
+static error_t ExecuteSqlStatement(sqlite3* db, const char* sqlQuery)
+{
+    return sqlite3_exec(db, sqlQuery, NULL, NULL, NULL) == SQLITE_OK ? ERR_OK : ERR_DATABASE;
+}
+
+// Loads the alpha values and histograms of all log entries in the order of ascending alpha
+static error_t LoadLoggedHistograms(sqlite3* db, MmcfeReweightingWindows_t*restrict outWindows, MmcfeHistograms_t*restrict outHistograms)
+{
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM LogEntries", -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+    return_if(sqlite3_step(sqlStmt) != SQLITE_ROW, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+    let entryCount = sqlite3_column_int(sqlStmt, 0);
+    sqlite3_finalize(sqlStmt);
+    return_if(entryCount == 0, ERR_USEDEFAULT);
+
+    error = sqlite3_prepare_v2(db, "SELECT Alpha, Histogram FROM LogEntries ORDER BY Alpha, Id", -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    *outWindows = span_New(*outWindows, entryCount);
+    *outHistograms = span_New(*outHistograms, entryCount);
+    for (int32_t i = 0; i < entryCount; i++)
+    {
+        return_if(sqlite3_step(sqlStmt) != SQLITE_ROW, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+        span_Get(*outWindows, i).Alpha = sqlite3_column_double(sqlStmt, 0);
+        span_Get(*outHistograms, i) = ctor_DynamicJumpHistogram_FromBuffer(sqlite3_column_blob(sqlStmt, 1));
+    }
+
+    sqlite3_finalize(sqlStmt);
+    return ERR_OK;
+}
+
+// Builds the reweighting samples from the non-empty bins of the passed histograms and sets the window sample counts. Returns the reference energy in [eV]
+static double BuildReweightingSamples(const MmcfeHistograms_t*restrict histograms, MmcfeReweightingWindows_t*restrict windows, MmcfeReweightingSamples_t*restrict outSamples)
+{
+    int64_t sampleCount = 0;
+    double energySum = 0.0;
+    cpp_foreach(histogram, *histograms)
+    {
+        for (int64_t i = 0; i < histogram->Header->EntryCount; i++)
+        {
+            continue_if(span_Get(histogram->Counters, i) == 0);
+            energySum += histogram->Header->MinValue + (double) i * histogram->Header->Stepping;
+            ++sampleCount;
+        }
+    }
+
+    // Note: The energies are shifted by their mean to keep the exponents of lattice energies in the order of the fluctuations
+    let referenceEnergy = (sampleCount > 0) ? energySum / (double) sampleCount : 0.0;
+    *outSamples = span_New(*outSamples, sampleCount);
+    var sample = outSamples->Begin;
+    for (int32_t k = 0; k < span_Length(*histograms); k++)
+    {
+        let histogram = &span_Get(*histograms, k);
+        int64_t windowCount = 0;
+        for (int64_t i = 0; i < histogram->Header->EntryCount; i++)
+        {
+            let count = span_Get(histogram->Counters, i);
+            continue_if(count == 0);
+            sample->Energy = histogram->Header->MinValue + (double) i * histogram->Header->Stepping - referenceEnergy;
+            sample->LogCount = log((double) count);
+            sample->LogDos = 0.0;
+            windowCount += count;
+            ++sample;
+        }
+        span_Get(*windows, k).LogSampleCount = (windowCount > 0) ? log((double) windowCount) : -INFINITY;
+        span_Get(*windows, k).FreeEnergy = 0.0;
+    }
+    return referenceEnergy;
+}
+
+// Adds a term to a streaming log-sum-exp accumulation that is stored as maximum and scaled sum
+static inline void AddLogSumExpTerm(double*restrict max, double*restrict sum, const double term)
+{
+    if (term <= *max)
+    {
+        *sum += exp(term - *max);
+        return;
+    }
+    *sum = *sum * exp(*max - term) + 1.0;
+    *max = term;
+}
+
+// Calculates the logarithm of the partition function of a window from the current density of states estimate
+static double CalculateWindowLogPartitionFunction(const MmcfeReweightingSamples_t*restrict samples, const MmcfeReweightingWindow_t*restrict window)
+{
+    double max = -INFINITY, sum = 0.0;
+    cpp_foreach(sample, *samples) AddLogSumExpTerm(&max, &sum, sample->LogDos - window->Beta * sample->Energy);
+    return max + log(sum);
+}
+
+// Updates the density of states estimate of all samples from the current window free energies
+static void UpdateSampleLogDos(MmcfeReweightingSamples_t*restrict samples, const MmcfeReweightingWindows_t*restrict windows)
+{
+    cpp_foreach(sample, *samples)
+    {
+        double max = -INFINITY, sum = 0.0;
+        cpp_foreach(window, *windows) AddLogSumExpTerm(&max, &sum, window->LogSampleCount + window->FreeEnergy - window->Beta * sample->Energy);
+        sample->LogDos = sample->LogCount - (max + log(sum));
+    }
+}
+
+// Solves the self-consistent WHAM equations. The free energies are relative to the first window. Returns the number of required iterations
+static int32_t SolveReweightingEquations(MmcfeReweightingSamples_t*restrict samples, MmcfeReweightingWindows_t*restrict windows, const double tolerance)
+{
+    int32_t iteration = 0;
+    for (; iteration < MMCFE_REWEIGHTING_MAXITERATIONS; iteration++)
+    {
+        UpdateSampleLogDos(samples, windows);
+        let referenceValue = -CalculateWindowLogPartitionFunction(samples, windows->Begin);
+        double maxChange = 0.0;
+        cpp_foreach(window, *windows)
+        {
+            let freeEnergy = -CalculateWindowLogPartitionFunction(samples, window) - referenceValue;
+            maxChange = getMaxOfTwo(maxChange, fabs(freeEnergy - window->FreeEnergy));
+            window->FreeEnergy = freeEnergy;
+        }
+        break_if(maxChange < tolerance);
+    }
+
+    cpp_foreach(window, *windows)
+    {
+        let logPartitionFunction = CalculateWindowLogPartitionFunction(samples, window);
+        window->MeanEnergy = 0.0;
+        cpp_foreach(sample, *samples)
+            window->MeanEnergy += sample->Energy * exp(sample->LogDos - window->Beta * sample->Energy - logPartitionFunction);
+    }
+    return iteration;
+}
+
+// Replaces the content of the result table with the passed reweighting windows
+static error_t WriteReweightingWindowsToLogDb(sqlite3* db, const MmcfeReweightingWindows_t*restrict windows, const double referenceEnergy, const double temperature)
+{
+    let createQuery = "CREATE TABLE IF NOT EXISTS " MMCFE_RESULTTABLE_NAME " ("
+                      "Id INTEGER PRIMARY KEY, Alpha REAL NOT NULL, Temperature REAL NOT NULL, "
+                      "ReducedFreeEnergy REAL NOT NULL, MeanEnergy REAL NOT NULL)";
+    let insertQuery = "INSERT INTO " MMCFE_RESULTTABLE_NAME " (Alpha, Temperature, ReducedFreeEnergy, MeanEnergy) VALUES (?1, ?2, ?3, ?4)";
+
+    var error = ExecuteSqlStatement(db, "BEGIN");
+    return_if(error, error);
+    error = ExecuteSqlStatement(db, createQuery);
+    return_if(error, (ExecuteSqlStatement(db, "ROLLBACK"), error));
+    error = ExecuteSqlStatement(db, "DELETE FROM " MMCFE_RESULTTABLE_NAME);
+    return_if(error, (ExecuteSqlStatement(db, "ROLLBACK"), error));
+
+    sqlite3_stmt* sqlStmt = NULL;
+    error = sqlite3_prepare_v2(db, insertQuery, -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ExecuteSqlStatement(db, "ROLLBACK"), ERR_DATABASE));
+
+    // Note: The free energies are solved for shifted energies, the shift adds (beta_k - beta_0) * E_ref to the reduced free energy difference
+    let firstBeta = windows->Begin->Beta;
+    cpp_foreach(window, *windows)
+    {
+        sqlite3_bind_double(sqlStmt, 1, window->Alpha);
+        sqlite3_bind_double(sqlStmt, 2, temperature / window->Alpha);
+        sqlite3_bind_double(sqlStmt, 3, window->FreeEnergy + (window->Beta - firstBeta) * referenceEnergy);
+        sqlite3_bind_double(sqlStmt, 4, window->MeanEnergy + referenceEnergy);
+        error = sqlite3_step(sqlStmt);
+        return_if(error != SQLITE_DONE, (sqlite3_finalize(sqlStmt), ExecuteSqlStatement(db, "ROLLBACK"), ERR_DATABASE));
+        sqlite3_reset(sqlStmt);
+    }
+
+    sqlite3_finalize(sqlStmt);
+    return ExecuteSqlStatement(db, "COMMIT");
+}
+
+error_t WriteMmcfeReweightingResultsToLogDb(sqlite3* db, const double betaAtAlphaOne, const double temperature, const double tolerance)
+{
+    MmcfeReweightingWindows_t windows;
+    MmcfeReweightingSamples_t samples;
+    MmcfeHistograms_t histograms;
+
+    var error = LoadLoggedHistograms(db, &windows, &histograms);
+    return_if(error == ERR_USEDEFAULT, ERR_OK);
+    return_if(error, error);
+
+    cpp_foreach(window, windows) window->Beta = window->Alpha * betaAtAlphaOne;
+    let referenceEnergy = BuildReweightingSamples(&histograms, &windows, &samples);
+    let iterationCount = SolveReweightingEquations(&samples, &windows, tolerance);
+    error = WriteReweightingWindowsToLogDb(db, &windows, referenceEnergy, temperature);
+
+    fprintf(stdout, "MMCFE  => Reweighting: %i histograms, %i samples, %i iterations%s\n\n", (int32_t) span_Length(windows), (int32_t) span_Length(samples),
+            iterationCount, (iterationCount < MMCFE_REWEIGHTING_MAXITERATIONS) ? "" : " (not converged)");
+    fflush(stdout);
+
+    cpp_foreach(histogram, histograms) free(histogram->Header);
+    span_Delete(histograms);
+    span_Delete(samples);
+    span_Delete(windows);
+    return error;
+}
@@ -0,0 +1,66 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	MmcfeReweighting.h     		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   MMCFE histogram reweighting //
+//////////////////////////////////////////
+
+#pragma once
+
+#include "Libraries/Sqlite/sqlite3.h"
+#include "Libraries/Simulator/Logic/Routines/TransitionTrackingRoutines.h"
+
+// Defines the maximum number of self-consistent iterations of the multi histogram reweighting
+#define MMCFE_REWEIGHTING_MAXITERATIONS 100000
+
+// Defines the default convergence tolerance of the reduced free energies of the multi histogram reweighting
+#define MMCFE_REWEIGHTING_TOLERANCE     1.0e-7
+
+// Type for one energy sample of the multi histogram reweighting. Each sample is a non-empty bin of a logged histogram
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef struct MmcfeReweightingSample
+{
+    // The energy of the sample bin in [eV] relative to the reference energy
+    double  Energy;
+
+    // The logarithm of the sample bin count
+    double  LogCount;
+
+    // The logarithm of the estimated density of states at the sample energy
+    double  LogDos;
+
+} MmcfeReweightingSample_t;
+
+// Type for the sample span of the multi histogram reweighting
+typedef Span_t(MmcfeReweightingSample_t, MmcfeReweightingSamples) MmcfeReweightingSamples_t;
+
+// Type for one alpha window of the multi histogram reweighting. Each window is a logged histogram
+// Layout@ggc_x86_64 => 40@[8,8,8,8,8]
+typedef struct MmcfeReweightingWindow
+{
+    // The alpha value of the window
+    double  Alpha;
+
+    // The inverse thermal energy of the window in [1/eV]
+    double  Beta;
+
+    // The logarithm of the total sample count of the window
+    double  LogSampleCount;
+
+    // The reduced free energy of the window relative to the reference energy
+    double  FreeEnergy;
+
+    // The reweighted mean energy of the window in [eV] relative to the reference energy
+    double  MeanEnergy;
+
+} MmcfeReweightingWindow_t;
+
+// Type for the window span of the multi histogram reweighting
+typedef Span_t(MmcfeReweightingWindow_t, MmcfeReweightingWindows) MmcfeReweightingWindows_t;
+
+// Performs the multi histogram reweighting (WHAM) of all histograms in the passed MMCFE log database and replaces the content of the result table
+// (The reduced free energies are relative to the lowest alpha, the inverse thermal energy of alpha one is passed in [1/eV])
+error_t WriteMmcfeReweightingResultsToLogDb(sqlite3* db, double betaAtAlphaOne, double temperature, double tolerance);
@@ -0,0 +1,435 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	WangLandauExtension.c  		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Wang-Landau DOS routine     //
+//////////////////////////////////////////
+
+#include "WangLandauExtension.h"
+#include <math.h>
+#include <Libraries/ProgressPrint/ProgressPrint.h>
+#include <Libraries/Simulator/Data/SimContext/SimulationContextAccess.h>
+#include <Libraries/Simulator/Logic/Routines/EnvironmentRoutines.h>
+#include <Libraries/Simulator/Logic/Routines/HelperRoutines.h>
+#include <Libraries/Simulator/Logic/Routines/JumpSelectionRoutines.h>
+
+#define WLDOS_LOGTABLE_NAME     "LogEntries"
+#define WLDOS_STATECOL_NAME     "State"
+#define WLDOS_PARAMSCOL_NAME    "ParamState"
+#define WLDOS_HISTOCOL_NAME     "Histogram"
+#define WLDOS_LOGDOSCOL_NAME    "LogDos"
+#define WLDOS_TIMECOL_NAME      "TimeStamp"
+#define WLDOS_FACTORCOL_NAME    "LogFactor"
+#define WLDOS_INCOMPLETECOL_NAME "IsIncomplete"
+
+/* Extension interface implementation */
+
+const MocsimUuid_t* MOCASSIN_EXTENSION_GET_ENTRY_FUNC()
+{
+    const static MocsimUuid_t routineGuid = {.A = 0xb7f2dded, .B =0xdaf1, .C =0x40c0, .D = {0x57, 0x4c, 0x44, 0x4f, 0x53, 0x00, 0x00, 0x00}};
+    return &routineGuid;
+}
+
+FMocassinRoutine_t MOCASSIN_EXTENSION_GET_UUID_FUNC()
+{
+    return StartWangLandauRoutine;
+}
+
+/* Internal routine implementation */
+
+// Builds the default log database file path using the provided simulation context (Has to be freed manually)
+static const char* BuildDefaultLogDbFilePath(SCONTEXT_PARAMETER)
+{
+    let ioPath = getFileInformation(simContext)->IODirectoryPath;
+    let fileName = "/wldoslog.db";
+    char* result;
+    var error = ConcatStrings(ioPath, fileName, &result);
+    assert_success(error, "Fatal error on building the log database file path.");
+    return result;
+}
+
+// Tries to get the parameter state, the density of states and the stage completion of the last routine log entry from the database
+static error_t TryGetLastDbLogEntry(sqlite3* db, WangLandauLog_t*restrict outLog)
+{
+    debug_assert(outLog != NULL);
+    let sqlQuery = "SELECT Id, " WLDOS_PARAMSCOL_NAME ", " WLDOS_LOGDOSCOL_NAME ", " WLDOS_INCOMPLETECOL_NAME " FROM " WLDOS_LOGTABLE_NAME " ORDER BY Id DESC";
+    sqlite3_stmt* sqlStmt;
+
+    var error = sqlite3_prepare_v2(db, sqlQuery, -1,&sqlStmt,NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_USEDEFAULT));
+
+    error = sqlite3_step(sqlStmt);
+    return_if(error != SQLITE_ROW, (sqlite3_finalize(sqlStmt), ERR_USEDEFAULT));
+
+    outLog->ParamsState = *(WangLandauParams_t*) sqlite3_column_blob(sqlStmt, 1);
+    let dosByteCount = (size_t) sqlite3_column_bytes(sqlStmt, 2);
+    outLog->LogDos = span_New(outLog->LogDos, dosByteCount / sizeof(double));
+    memcpy(outLog->LogDos.Begin, sqlite3_column_blob(sqlStmt, 2), dosByteCount);
+    outLog->StageIsIncomplete = (bool_t) (sqlite3_column_int(sqlStmt, 3) != 0);
+
+    error= sqlite3_finalize(sqlStmt);
+    return error == SQLITE_OK ? ERR_OK : ERR_DATABASE;
+}
+
+// Ensures that the log database is actually created an usable, if the database already existed it returns the last log entry
+static error_t EnsureLogDbCreated(sqlite3* db, WangLandauLog_t*restrict outLog)
+{
+    let createQuery = "CREATE TABLE IF NOT EXISTS "WLDOS_LOGTABLE_NAME" ("
+                      "Id INTEGER PRIMARY KEY, "
+                      WLDOS_TIMECOL_NAME    " TEXT NOT NULL, "
+                      WLDOS_STATECOL_NAME   " BLOB NOT NULL, "
+                      WLDOS_HISTOCOL_NAME   " BLOB NOT NULL, "
+                      WLDOS_LOGDOSCOL_NAME  " BLOB NOT NULL, "
+                      WLDOS_PARAMSCOL_NAME  " BLOB NOT NULL, "
+                      WLDOS_FACTORCOL_NAME  " REAL NOT NULL, "
+                      WLDOS_INCOMPLETECOL_NAME " INTEGER NOT NULL);";
+
+    var error = TryGetLastDbLogEntry(db, outLog);
+    return_if(error != ERR_USEDEFAULT, error);
+
+    sqlite3_stmt* sqlStmt;
+
+    error = sqlite3_prepare_v2(db, createQuery, -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_step(sqlStmt);
+    return_if(error != SQLITE_DONE, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_finalize(sqlStmt);
+
+    return error == SQLITE_OK ? ERR_OK : ERR_DATABASE;
+}
+
+sqlite3* OpenWangLandauLogDatabase(const char* dbPath, WangLandauLog_t*restrict outLog)
+{
+    debug_assert(outLog != NULL);
+
+    sqlite3* db;
+    if (sqlite3_open(dbPath, &db) != SQLITE_OK)
+    {
+        sqlite3_close(db);
+        assert_success(ERR_DATABASE, "Fatal error while trying to create the Wang-Landau log database connection.");
+    }
+
+    var error = EnsureLogDbCreated(db, outLog);
+    assert_success(error, "Fatal error while creating or loading the log database.");
+    return db;
+}
+
+error_t WriteWangLandauEntryToLogDb(sqlite3* db, const WangLandauLog_t*restrict logEntry)
+{
+    let sqlQuery = "INSERT INTO " WLDOS_LOGTABLE_NAME " ("
+                   WLDOS_TIMECOL_NAME       ", "
+                   WLDOS_STATECOL_NAME      ", "
+                   WLDOS_HISTOCOL_NAME      ", "
+                   WLDOS_LOGDOSCOL_NAME     ", "
+                   WLDOS_PARAMSCOL_NAME     ", "
+                   WLDOS_FACTORCOL_NAME     ", "
+                   WLDOS_INCOMPLETECOL_NAME ") "
+                   "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(db, sqlQuery, -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    char timeStamp[TIME_ISO8601_BYTECOUNT];
+    GetCurrentIso8601UtcTimeStamp(timeStamp);
+    error = sqlite3_bind_text(sqlStmt, 1, timeStamp, -1, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    let stateByteCount = span_ByteCount(logEntry->StateBuffer);
+    return_if(stateByteCount > INT32_MAX, ERR_DATABASE);
+
+    error = sqlite3_bind_blob(sqlStmt, 2, logEntry->StateBuffer.Begin, stateByteCount, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    let histogramByteCount = (void*) logEntry->Histogram.Counters.End - (void*) logEntry->Histogram.Header;
+    return_if(histogramByteCount > INT32_MAX, ERR_DATABASE);
+
+    error = sqlite3_bind_blob(sqlStmt, 3, logEntry->Histogram.Header, histogramByteCount, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_bind_blob(sqlStmt, 4, logEntry->LogDos.Begin, span_ByteCount(logEntry->LogDos), NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_bind_blob(sqlStmt, 5, &logEntry->ParamsState, sizeof(WangLandauParams_t), NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_bind_double(sqlStmt, 6, logEntry->ParamsState.LogFactorCurrent);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_bind_int(sqlStmt, 7, logEntry->StageIsIncomplete ? 1 : 0);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    error = sqlite3_step(sqlStmt);
+    return_if(error != SQLITE_DONE, (sqlite3_finalize(sqlStmt), ERR_DATABASE));
+
+    sqlite3_finalize(sqlStmt);
+    return ERR_OK;
+}
+
+// Checks if the routine parameters are valid
+static inline bool_t RoutineParametersAreValid(WangLandauParams_t* restrict params)
+{
+    return_if(params->HistogramSize <= 0 || params->EnergyMax <= params->EnergyMin, false);
+    return_if(params->LogFactorStart <= 0.0 || params->LogFactorEnd <= 0.0 || params->LogFactorEnd > params->LogFactorStart, false);
+    return_if(params->Flatness <= 0.0 || params->Flatness >= 1.0, false);
+    return_if(params->CheckCycleCount <= 0, false);
+    return true;
+}
+
+// Checks if the routine has already completed
+static inline bool_t RoutineIsAlreadyCompleted(const WangLandauLog_t* restrict log)
+{
+    let params = &log->ParamsState;
+    return (params->StageCount > 0 && !log->StageIsIncomplete && 0.5 * params->LogFactorCurrent < params->LogFactorEnd) ? true : false;
+}
+
+// Verifies that the Wang-Landau routine parameter data exists in the context and the right UUID is set
+static error_t TryLoadRoutineParameters(SCONTEXT_PARAMETER, WangLandauParams_t*restrict outParams)
+{
+    let routineData = getCustomRoutineData(simContext);
+
+    let testGuid = MOCASSIN_EXTENSION_GET_ENTRY_FUNC();
+    return_if(CompareMocuuid(routineData->Guid, testGuid) != 0, ERR_DATACONSISTENCY);
+
+    let length = span_Length(routineData->ParamData);
+    return_if(length != sizeof(WangLandauParams_t), ERR_DATACONSISTENCY);
+
+    return_if(!RoutineParametersAreValid((WangLandauParams_t*) routineData->ParamData.Begin), ERR_DATACONSISTENCY);
+
+    *outParams = *(WangLandauParams_t*) routineData->ParamData.Begin;
+    outParams->LogFactorCurrent = outParams->LogFactorStart;
+    outParams->StageCount = 0;
+    return ERR_OK;
+}
+
+// Initializes the routine log after the parameter state was loaded from either log-db or simulation database
+static error_t InitializeRoutineLog(SCONTEXT_PARAMETER, WangLandauLog_t*restrict log)
+{
+    debug_assert(log != NULL);
+
+    log->StateBuffer = getSimulationState(simContext)->Buffer;
+    log->Histogram = ctor_DynamicJumpHistogram(log->ParamsState.HistogramSize);
+    log->StageCycleCount = 0;
+
+    if (log->LogDos.Begin == NULL)
+    {
+        log->LogDos = span_New(log->LogDos, log->ParamsState.HistogramSize);
+        cpp_foreach(item, log->LogDos) *item = 0.0;
+    }
+    return_if(span_Length(log->LogDos) != log->ParamsState.HistogramSize, ERR_DATACONSISTENCY);
+
+    return ChangeDynamicJumpHistogramSamplingAreaByMinMax(&log->Histogram, log->ParamsState.EnergyMin, log->ParamsState.EnergyMax);
+}
+
+// Get the histogram bin index of the passed lattice energy in [eV] or INVALID_INDEX if the energy is outside of the sampling window
+static inline int32_t GetEnergyBinId(const WangLandauLog_t*restrict log, const double energy)
+{
+    let header = log->Histogram.Header;
+    return_if(energy < header->MinValue, INVALID_INDEX);
+    let binId = (int64_t) ((energy - header->MinValue) * header->SteppingInverse);
+    return (binId < header->EntryCount) ? (int32_t) binId : INVALID_INDEX;
+}
+
+// Adds the visit of the passed lattice energy to the visit histogram and the density of states of the current stage
+static inline void LogEnergyVisit(WangLandauLog_t*restrict log, const double energy)
+{
+    let binId = GetEnergyBinId(log, energy);
+    return_if(binId == INVALID_INDEX);
+    span_Get(log->LogDos, binId) += log->ParamsState.LogFactorCurrent;
+    AddEnergyValueToDynamicJumpHistogram(&log->Histogram, energy);
+}
+
+// Decides if a transition between the passed energies is accepted with min(1, g(E_old) / g(E_new))
+// (Outside of the sampling window all transitions that approach the window center are accepted and the visits are not logged)
+static inline bool_t WangLandauTransitionIsAccepted(SCONTEXT_PARAMETER, const WangLandauLog_t*restrict log, const double oldEnergy, const double newEnergy)
+{
+    let oldBinId = GetEnergyBinId(log, oldEnergy);
+    let newBinId = GetEnergyBinId(log, newEnergy);
+    if (oldBinId == INVALID_INDEX)
+    {
+        let windowCenter = 0.5 * (log->ParamsState.EnergyMin + log->ParamsState.EnergyMax);
+        return fabs(newEnergy - windowCenter) < fabs(oldEnergy - windowCenter);
+    }
+    return_if(newBinId == INVALID_INDEX, false);
+
+    let logRatio = span_Get(log->LogDos, oldBinId) - span_Get(log->LogDos, newBinId);
+    let proposalRatio = GetMmcSelectionProposalRatio(simContext);
+    return_if(logRatio >= 0.0 && proposalRatio >= 1.0, true);
+    return exp(logRatio) * proposalRatio >= GetNextRandomDoubleFromContextRng(simContext);
+}
+
+// Executes one simulation cycle with the Wang-Landau acceptance and logs the visited energy (Site blocks count as rejected transitions)
+static inline void CycleSimulationWithWangLandauLog(SCONTEXT_PARAMETER, WangLandauLog_t*restrict log, double*restrict latticeEnergy)
+{
+    var counters = getMainCycleCounters(simContext);
+    let factors = getPhysicalFactors(simContext);
+    let jumpInfo = getJumpEnergyInfo(simContext);
+
+    if (TrySetNextMmcJumpEnergiesOnContext(simContext))
+    {
+        let newEnergy = *latticeEnergy + factors->EnergyFactorKtToEv * jumpInfo->S0toS2EnergyBarrier;
+        let isAccepted = WangLandauTransitionIsAccepted(simContext, log, *latticeEnergy, newEnergy);
+        SetExternalMmcEventEvaluationOnContext(simContext, isAccepted);
+        if (isAccepted) *latticeEnergy = newEnergy;
+    }
+
+    LogEnergyVisit(log, *latticeEnergy);
+    ++log->StageCycleCount;
+    ++counters->CycleCount;
+}
+
+// Checks if the visit histogram of the current stage is flat. Only bins with a non-zero density of states are considered as energies can be unreachable
+static bool_t VisitHistogramIsFlat(const WangLandauLog_t*restrict log)
+{
+    int64_t minCount = INT64_MAX, countSum = 0, binCount = 0;
+    for (int32_t i = 0; i < log->ParamsState.HistogramSize; i++)
+    {
+        continue_if(span_Get(log->LogDos, i) <= 0.0);
+        let count = span_Get(log->Histogram.Counters, i);
+        minCount = getMinOfTwo(minCount, count);
+        countSum += count;
+        ++binCount;
+    }
+
+    return_if(binCount == 0, false);
+    return (double) minCount >= log->ParamsState.Flatness * (double) countSum / (double) binCount;
+}
+
+// Counts the number of bins of the density of states that have been visited at least once
+static int32_t CountVisitedDosBins(const WangLandauLog_t*restrict log)
+{
+    int32_t result = 0;
+    cpp_foreach(item, log->LogDos) result += (*item > 0.0);
+    return result;
+}
+
+// Prints the progress of the Wang-Landau routine
+static inline void PrintRoutineProgress(SCONTEXT_PARAMETER, const WangLandauLog_t*restrict log, const clock_t stageEndClock)
+{
+    let meta = getMainStateMetaData(simContext);
+    let stageSeconds = (int64_t) ((stageEndClock - log->StageStartClock) / (double) CLOCKS_PER_SEC);
+
+    char stampBuffer[TIME_ISO8601_BYTECOUNT], runBuffer[TIME_ISO8601_BYTECOUNT], stageBuffer[TIME_ISO8601_BYTECOUNT];
+    GetCurrentIso8601UtcTimeStamp(stampBuffer);
+    SecondsToIso8601FormattedTimePeriod(runBuffer, meta->ProgramRunTime);
+    SecondsToIso8601FormattedTimePeriod(stageBuffer, stageSeconds);
+
+    fprintf(stdout, "WLDOS  => LogTime: %s [  ] (RunTime=%s, StageTime=%s)\n", stampBuffer, runBuffer, stageBuffer);
+    fprintf(stdout, "WLDOS  => AvgRate: %+.6e [Hz] (McsRate=%+.6e [Hz])\n", meta->CycleRate, meta->SuccessRate);
+    fprintf(stdout, "WLDOS  => Stage %i %s: ln(f)=%.6e, Cycles=" FORMAT_I64() ", Bins(visited)=%i/%i, E(Lattice)=%+.6e [eV]\n\n",
+            log->ParamsState.StageCount + (log->StageIsIncomplete ? 1 : 0), log->StageIsIncomplete ? "aborted" : "done",
+            log->ParamsState.LogFactorCurrent, log->StageCycleCount,
+            CountVisitedDosBins(log), log->ParamsState.HistogramSize, meta->LatticeEnergy);
+    fflush(stdout);
+}
+
+// Finishes one modification factor stage of the Wang-Landau routine and writes the stage result to the log database
+// (An incomplete stage is logged with its current factor and does not count as a completed stage)
+static inline error_t FinishStage(SCONTEXT_PARAMETER, WangLandauLog_t*restrict log, sqlite3*restrict db)
+{
+    let stageEndClock = clock();
+    if (!log->StageIsIncomplete)
+    {
+        ++log->ParamsState.StageCount;
+        UpdateAndEvaluateRuntimeAbortConditions(simContext);
+    }
+
+    // Note: The lattice energy is tracked incrementally over many cycles, the resynchronization prevents the drift into wrong bins
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    ExecuteSharedMcBlockFinisher(simContext);
+    let error = WriteWangLandauEntryToLogDb(db, log);
+    PrintRoutineProgress(simContext, log, stageEndClock);
+    return error;
+}
+
+// Runs one modification factor stage until the visit histogram is flat or a timeout or rate abort condition is reached
+// (Note: The energy relaxation, precision and mcs conditions of the MMC routine do not apply to the flat histogram sampling)
+static inline void EnterStage(SCONTEXT_PARAMETER, WangLandauLog_t*restrict log)
+{
+    let latticeEnergy = &getMainStateMetaData(simContext)->LatticeEnergy;
+    log->StageStartClock = clock();
+    log->StageCycleCount = 0;
+    log->StageIsIncomplete = false;
+    ChangeDynamicJumpHistogramSamplingAreaByMinMax(&log->Histogram, log->ParamsState.EnergyMin, log->ParamsState.EnergyMax);
+
+    for (;;)
+    {
+        for (int64_t i = 0; i < log->ParamsState.CheckCycleCount; i++)
+            CycleSimulationWithWangLandauLog(simContext, log, latticeEnergy);
+
+        break_if(VisitHistogramIsFlat(log));
+        log->StageIsIncomplete = UpdateAndEvaluateRuntimeAbortConditions(simContext) != STATE_FLG_CONTINUE;
+        break_if(log->StageIsIncomplete);
+    }
+}
+
+// Enters the actual outer Wang-Landau execution phase that reduces the modification factor by the square root after each flat stage
+// (Returns with the condition abort flag set if the run was stopped, the incomplete stage is then continued on the next start)
+static error_t EnterExecutionLoop(SCONTEXT_PARAMETER, WangLandauLog_t*restrict log, sqlite3*restrict db, const bool_t logLoaded)
+{
+    // Note: The factor of an incomplete stage was not used up, only the factor of a completed stage is reduced on resume
+    if (logLoaded && !log->StageIsIncomplete) log->ParamsState.LogFactorCurrent *= 0.5;
+
+    UpdateAndEvaluateRuntimeAbortConditions(simContext);
+
+    for (;log->ParamsState.LogFactorCurrent >= log->ParamsState.LogFactorEnd;)
+    {
+        EnterStage(simContext, log);
+        var error = FinishStage(simContext, log, db);
+        return_if(error, error);
+        return_if(log->StageIsIncomplete, ERR_OK);
+        log->ParamsState.LogFactorCurrent *= 0.5;
+        break_if(log->ParamsState.LogFactorCurrent < log->ParamsState.LogFactorEnd);
+        return_if(StateFlagsAreSet(simContext, STATE_FLG_CONDABORT), ERR_OK);
+    }
+
+    return ERR_OK;
+}
+
+// The internal Wang-Landau routine entry point
+static error_t StartRoutineInternal(SCONTEXT_PARAMETER)
+{
+    var error = ERR_OK;
+    WangLandauLog_t routineLog;
+    nullStructContent(routineLog);
+
+    let logPath = BuildDefaultLogDbFilePath(simContext);
+    var db = OpenWangLandauLogDatabase(logPath, &routineLog);
+    return_if(RoutineIsAlreadyCompleted(&routineLog), (sqlite3_close(db), ERR_ALREADYCOMPLETED));
+
+    // Note: Abort flags in the loaded state belong to the previous run, the routine decides on completion by its own conditions
+    unSetMainStateFlags(simContext, STATE_FLG_CONDABORT | STATE_FLG_TIMEOUT | STATE_FLG_RATEABORT);
+
+    let logLoaded = RoutineParametersAreValid(&routineLog.ParamsState);
+    if (!logLoaded)
+    {
+        span_Delete(routineLog.LogDos);
+        routineLog.LogDos = (WangLandauLogDos_t) {NULL, NULL};
+        error = TryLoadRoutineParameters(simContext, &routineLog.ParamsState);
+        return_if(error, error);
+    }
+
+    error = InitializeRoutineLog(simContext, &routineLog);
+    return_if(error, error);
+
+    error = EnterExecutionLoop(simContext, &routineLog, db, logLoaded);
+    return_if(error, error);
+
+    span_Delete(routineLog.LogDos);
+    free(routineLog.Histogram.Header);
+    return sqlite3_close(db) != SQLITE_OK ? ERR_DATABASE : ERR_OK;
+}
+
+void StartWangLandauRoutine(void* context)
+{
+    var simContext = (SimulationContext_t *) context;
+    let error = StartRoutineInternal(simContext);
+    assert_success(error, "Unhandled internal error in Wang-Landau execution routine.");
+    if (!StateFlagsAreSet(simContext, STATE_FLG_CONDABORT)) setMainStateFlags(simContext, STATE_FLG_COMPLETED);
+    PrintMocassinSimulationFinishInfo(simContext, stdout);
+}
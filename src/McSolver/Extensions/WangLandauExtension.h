@@ -0,0 +1,92 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	WangLandauExtension.h  		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Wang-Landau DOS routine     //
+//////////////////////////////////////////
+
+#pragma once
+
+#include "Libraries/Sqlite/sqlite3.h"
+#include "Extensions/MocassinSolverExtension.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/TransitionTrackingRoutines.h"
+
+/* Routine type definitions */
+
+// Type for storage of Wang-Landau routine parameters
+// Layout@ggc_x86_64 => 64@[4,4,8,8,8,8,8,8,8]
+typedef struct WangLandauParams
+{
+    // The number of energy bins of the density of states
+    int32_t HistogramSize;
+
+    // The number of completed modification factor stages
+    int32_t StageCount;
+
+    // The lower lattice energy limit of the sampling window in [eV]
+    double  EnergyMin;
+
+    // The upper lattice energy limit of the sampling window in [eV]
+    double  EnergyMax;
+
+    // The logarithmic modification factor ln(f) of the first stage
+    double  LogFactorStart;
+
+    // The logarithmic modification factor ln(f) that completes the routine if the current factor drops below it
+    double  LogFactorEnd;
+
+    // The logarithmic modification factor ln(f) of the current stage
+    double  LogFactorCurrent;
+
+    // The flatness criterion as the required ratio of the minimal to the mean visit count
+    double  Flatness;
+
+    // The number of cycles between two flatness checks
+    int64_t CheckCycleCount;
+
+} WangLandauParams_t;
+
+// Type for the logarithmic density of states ln[g(E)] on the bins of the visit histogram
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(double, WangLandauLogDos) WangLandauLogDos_t;
+
+// Type for holding Wang-Landau log entry information
+// Layout@ggc_x86_64 => 144@[16,24,16,64,8,8,1,{7}]
+typedef struct WangLandauLog
+{
+    // The simulation state buffer
+    Buffer_t                StateBuffer;
+
+    // The visit histogram of the current stage
+    DynamicJumpHistogram_t  Histogram;
+
+    // The logarithmic density of states
+    WangLandauLogDos_t      LogDos;
+
+    // The state of the parameter struct as checkpoint data
+    WangLandauParams_t      ParamsState;
+
+    // The clock when the current stage was started
+    clock_t                 StageStartClock;
+
+    // The number of cycles of the current stage
+    int64_t                 StageCycleCount;
+
+    // Flag that marks the logged stage as aborted before its histogram was flat
+    bool_t                  StageIsIncomplete;
+
+} WangLandauLog_t;
+
+
+// Public routine start for the Wang-Landau density of states sampling that accepts a simulation context as a void pointer
+void StartWangLandauRoutine(void* context);
+
+// Opens an sqlite3 Wang-Landau log database and ensures its existence. If the database existed, the parameters and the density of states of the last entry are provided as out parameters
+sqlite3* OpenWangLandauLogDatabase(const char* dbPath, WangLandauLog_t*restrict outLog);
+
+// Adds a Wang-Landau log entry to the passed sqlite3 database connection
+error_t WriteWangLandauEntryToLogDb(sqlite3* db, const WangLandauLog_t*restrict logEntry);
@@ -12,16 +12,11 @@
 #include <stdlib.h>
 #include "Buffers.h"
 
-// Get the empty span that ensures that no additional memory is allocated
+// Get the empty span that ensures that no additional memory is allocated (Static sentinel, safe for concurrent first calls)
 static VoidSpan_t GetEmptySpan()
 {
-    static VoidSpan_t EmptySpan = {.Begin = NULL, .End = NULL};
-    if (EmptySpan.Begin == NULL)
-    {
-        let ptr = malloc(0);
-        EmptySpan = (VoidSpan_t) { .Begin = ptr, .End = ptr };
-    }
-    return EmptySpan;
+    static byte_t EmptyBuffer[1];
+    return (VoidSpan_t) { .Begin = EmptyBuffer, .End = EmptyBuffer };
 }
 
 int32_t CompareMocuuid(const void* lhs, const void* rhs)
@@ -74,6 +69,22 @@ void* ConstructSpanFromBlob(const void *restrict buffer, size_t numOfBytes, Void
     return outSpan;
 }
 
+void* ConstructSpanFromSpan(const VoidSpan_t *restrict span, VoidSpan_t *restrict outSpan)
+{
+    if (span->Begin == NULL)
+    {
+        *outSpan = (VoidSpan_t) {.Begin = NULL, .End = NULL};
+        return outSpan;
+    }
+
+    let numOfBytes = (size_t) span_ByteCount(*span);
+    var error = TryAllocateSpan(numOfBytes, 1, outSpan);
+    assert_success(error, "Out of memory on span copy construction.");
+    if (numOfBytes != 0) memcpy(outSpan->Begin, span->Begin, numOfBytes);
+
+    return outSpan;
+}
+
 VoidList_t AllocateList(const size_t capacity, const size_t sizeOfElement)
 {
     let span = AllocateSpan(capacity, sizeOfElement);
@@ -86,6 +97,23 @@ error_t TryAllocateList(const size_t capacity, const size_t sizeOfElement, VoidL
     return (outList->Begin == NULL) ? ERR_MEMALLOCATION : ERR_OK;
 }
 
+void* ConstructListFromList(const VoidList_t *restrict list, VoidList_t *restrict outList)
+{
+    if (list->Begin == NULL)
+    {
+        *outList = (VoidList_t) {.Begin = NULL, .End = NULL, .CapacityEnd = NULL};
+        return outList;
+    }
+
+    let numOfBytes = (size_t) (list->End - list->Begin);
+    error_t error = TryAllocateList((size_t) (list->CapacityEnd - list->Begin), 1, outList);
+    assert_success(error, "Out of memory on list copy construction.");
+    if (numOfBytes != 0) memcpy(outList->Begin, list->Begin, numOfBytes);
+    outList->End = outList->Begin + numOfBytes;
+
+    return outList;
+}
+
 void* ConstructVoidList(const size_t capacity, const size_t sizeOfElement, VoidList_t *restrict outList)
 {
     error_t error = TryAllocateList(capacity, sizeOfElement, outList);
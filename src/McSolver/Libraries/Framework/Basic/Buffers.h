@@ -44,9 +44,15 @@ void* ConstructVoidSpan(size_t numOfElements, size_t sizeOfElement, VoidSpan_t *
 // Copies a specific number of bytes from the passed buffer into a newly constructed span. Does not free the original buffer!
 void* ConstructSpanFromBlob(const void *restrict buffer, size_t numOfBytes, VoidSpan_t *restrict outSpan);
 
+// Copies the content of the passed span into a newly constructed span of identical size. Does not free the original span!
+void* ConstructSpanFromSpan(const VoidSpan_t *restrict span, VoidSpan_t *restrict outSpan);
+
 // Allocates a new span by constructing and casting a nw void type span
 #define span_New(SPAN, SIZE) *(typeof(SPAN)*) ConstructVoidSpan((size_t)(SIZE), sizeof(typeof(*(SPAN).Begin)), (VoidSpan_t*) &(SPAN))
 
+// Allocates a new span as a deep copy of the passed source span
+#define span_Clone(SPAN, SOURCE) *(typeof(SPAN)*) ConstructSpanFromSpan((const VoidSpan_t*) &(SOURCE), (VoidSpan_t*) &(SPAN))
+
 // Deletes a span by freeing the dynamic memory the span is addressing (Do not call on a subspan)
 #define span_Delete(SPAN) _FreeSpanMemory((SPAN).Begin)
 
@@ -142,9 +148,15 @@ error_t TryAllocateList(size_t capacity, size_t sizeOfElement, VoidList_t*restri
 // Construct a new list with the given capacity and size of elements and returns the list pointer (Handles allocation errors)
 void* ConstructVoidList(size_t capacity, size_t sizeOfElement, VoidList_t *restrict outList);
 
+// Copies the content and the capacity of the passed list into a newly constructed list. Does not free the original list!
+void* ConstructListFromList(const VoidList_t *restrict list, VoidList_t *restrict outList);
+
 // Macro to allocate a new list with the specified capacity and type
 #define list_New(LIST, CAPACITY) *(typeof(LIST)*) ConstructVoidList((size_t)(CAPACITY), sizeof(typeof(*(LIST).Begin)), (VoidList_t*) &(LIST))
 
+// Allocates a new list with identical capacity as a deep copy of the passed source list
+#define list_Clone(LIST, SOURCE) *(typeof(LIST)*) ConstructListFromList((const VoidList_t*) &(SOURCE), (VoidList_t*) &(LIST))
+
 // Macro to free the dynamic memory the list access refers to
 #define list_Delete(LIST) _FreeSpanMemory((LIST).Begin)
 
@@ -226,6 +238,9 @@ static inline int32_t CalculateArrayHeaderSize(int32_t rank)
 // Allocates a new array by interpreting the passed buffer pointer as a formatted array and copies the data. Does not free original buffer!
 #define array_ConstructFromBlob(ARRAY, BUFFER) *(typeof(ARRAY)*) ConstructArrayFromBlob((BUFFER), sizeof(typeof(*(ARRAY).Begin)), (VoidArray_t*) &(ARRAY))
 
+// Allocates a new array as a deep copy of the passed source array
+#define array_Clone(ARRAY, SOURCE) array_ConstructFromBlob((ARRAY), (SOURCE).Header)
+
 // Get the number of elements that need to be skipped to advance the passed number of steps in the 1. dimension of an array
 #define array_SkipBlock_1(ARRAY, VAL) (VAL)
 
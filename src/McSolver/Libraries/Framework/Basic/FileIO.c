@@ -10,6 +10,7 @@
 
 #include "FileIO.h"
 #include <dirent.h>
+#include <sys/stat.h>
 
 file_t* utf8fopen(const char* restrict fileName, const char* restrict fileMode)
 {
@@ -55,6 +56,21 @@ error_t utf8rename(const char* restrict fileName, const char* restrict newFileNa
 #endif
 }
 
+// Creates a directory by an utf8 encoded directory name if it does not already exist
+error_t utf8mkdir(const char* restrict dirName)
+{
+    return_if(IsAccessibleDirectory(dirName), ERR_OK);
+#if defined(WIN32)
+    wchar_t * dir16 = NULL;
+    var error = Win32ConvertUtf8ToUtf16(dirName, &dir16);
+    return_if(error <= 0, ERR_FILE);
+    error = _wmkdir(dir16);
+    return free(dir16), (error == 0) ? ERR_OK : ERR_FILE;
+#else
+    return (mkdir(dirName, 0755) == 0) ? ERR_OK : ERR_FILE;
+#endif
+}
+
 cerror_t CalculateFileSize(file_t *restrict fileStream)
 {
     int64_t fileSize;
@@ -47,6 +47,9 @@ error_t utf8remove(const char* restrict fileName);
 // Wrapper around rename() that handles the input arguments as utf8 encoded strings
 error_t utf8rename(const char* restrict fileName, const char* restrict newfileName);
 
+// Creates a directory by an utf8 encoded directory name if it does not already exist
+error_t utf8mkdir(const char* restrict dirName);
+
 // Check if a file name points to an existing file that can be accessed
 bool_t IsAccessibleFile(const char* restrict fileName);
 
@@ -34,6 +34,18 @@
 // Defines the number of byte/char required to print the ISO8601 UTC time string
 #define TIME_ISO8601_BYTECOUNT sizeof("YYYY-MM-DDTHH:MM:SS+HH:MM")
 
+// Get the processor time used by the calling thread in units of CLOCKS_PER_SEC (Falls back to the process time of clock() if thread clocks are not supported)
+static inline int64_t GetCallingThreadClock()
+{
+    #if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec timeSpec;
+    return_if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &timeSpec) != 0, (int64_t) clock());
+    return (int64_t) timeSpec.tv_sec * CLOCKS_PER_SEC + (int64_t) timeSpec.tv_nsec / (1000000000LL / CLOCKS_PER_SEC);
+    #else
+    return (int64_t) clock();
+    #endif
+}
+
 // Get the current time info as local time or GMT if specified
 static inline error_t GetCurrentTimeInfo(struct tm *restrict timeInfo, bool_t asGMT)
 {
@@ -43,6 +43,23 @@ static inline uint32_t Pcg32NextCeiledRandom(Pcg32_t* restrict rng, uint32_t cei
     }
 }
 
+//  Get the next bounded random number from [0...bound) by multiply-shift where the bias correction requires a division only in rare cases (Lemire's method)
+static inline uint32_t Pcg32NextBoundedRandom(Pcg32_t* restrict rng, uint32_t bound)
+{
+    var product = (uint64_t) Pcg32NextRandom(rng) * (uint64_t) bound;
+    var lowBits = (uint32_t) product;
+    if (lowBits < bound)
+    {
+        let threshold = -bound % bound;
+        while (lowBits < threshold)
+        {
+            product = (uint64_t) Pcg32NextRandom(rng) * (uint64_t) bound;
+            lowBits = (uint32_t) product;
+        }
+    }
+    return (uint32_t) (product >> 32u);
+}
+
 // Get next random double from range [0.0,1.0) using the passed pcg32 rng
 static inline double Pcg32NextRandomDoubleQuick(Pcg32_t* restrict rng)
 {
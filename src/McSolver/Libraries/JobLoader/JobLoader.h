@@ -9,8 +9,78 @@
 //////////////////////////////////////////
 
 #pragma once
+#include <pthread.h>
 #include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
 
+// Type for lists of database models that store the shared sub-models of the job batch mode
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef List_t(JobDbModel_t, JobDbModels) JobDbModels_t;
+
+// Type for the shared sub-model cache of the job batch mode. Sub-models are keyed by the model ids of the job model of their entry
+// Layout@ggc_x86_64 => 120@[8,40,24,24,24]
+typedef struct JobDbModelCache
+{
+    // The database connection that is used by all loading operations
+    void*               Database;
+
+    // The mutex that serializes the database access and the cache updates
+    pthread_mutex_t     Mutex;
+
+    // The cached structure models keyed by their structure model id
+    JobDbModels_t       StructureModels;
+
+    // The cached energy models keyed by their energy model id
+    JobDbModels_t       EnergyModels;
+
+    // The cached transition models keyed by their transition model id
+    JobDbModels_t       TransitionModels;
+
+} JobDbModelCache_t;
+
+// Type for the job queue of the worker mode that is stored in an sqlite database file and shared by all worker processes
+// Layout@ggc_x86_64 => 112@[8,40,48,8,1,{7}]
+typedef struct JobQueue
+{
+    // The database connection to the job queue file
+    void*               Database;
+
+    // The mutex that serializes the queue access of the threads of the worker process
+    pthread_mutex_t     Mutex;
+
+    // The condition that wakes the heartbeat thread for the next heartbeat or on close
+    pthread_cond_t      HeartbeatCondition;
+
+    // The thread that periodically refreshes the heartbeat of the running jobs of the worker process
+    pthread_t           HeartbeatThread;
+
+    // The flag that marks the heartbeat thread as active
+    bool_t              IsHeartbeatActive;
+
+} JobQueue_t;
+
 // Loads the database model of the job to the passed simulation context
 void LoadMocassinSimulationDatabaseModelToContext(SCONTEXT_PARAMETER);
 
+// Opens the passed database file and prepares a model cache that can store the passed number of sub-models per model type
+error_t OpenJobDbModelCache(JobDbModelCache_t*restrict cache, const char* dbFile, int32_t capacity);
+
+// Closes the database connection of the passed model cache (The cached sub-models stay valid)
+void CloseJobDbModelCache(JobDbModelCache_t*restrict cache);
+
+// Loads the database model of the job to the passed simulation context using the shared sub-models of the passed cache (Thread safe)
+void LoadMocassinSimulationDatabaseModelToContextFromCache(SCONTEXT_PARAMETER, JobDbModelCache_t*restrict cache);
+
+// Frees the job specific buffers of a database model that has been loaded from a model cache (The shared sub-models are not affected)
+void DeleteMocassinCachedDatabaseModelOfContext(SCONTEXT_PARAMETER);
+
+// Opens or creates the job queue in the passed database file, enqueues the passed job ids that are not yet queued and provides the total number of queued jobs
+error_t OpenJobQueue(JobQueue_t*restrict queue, const char* queueFile, const int32_t* jobIds, int32_t jobCount, int32_t*restrict outQueueSize);
+
+// Stops the heartbeat thread and closes the database connection of the passed job queue
+void CloseJobQueue(JobQueue_t*restrict queue);
+
+// Claims the next pending or stale running job of the queue within a write transaction and marks it as running. Provides a negative job id if no job is left
+error_t ClaimNextJobOfQueue(JobQueue_t*restrict queue, int32_t*restrict outJobId);
+
+// Marks the passed job of the queue as done and stores the finish time and the passed run time in [s]
+error_t FinishJobOfQueue(JobQueue_t*restrict queue, int32_t jobId, double runTime);
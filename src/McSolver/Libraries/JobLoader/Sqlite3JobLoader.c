@@ -23,6 +23,16 @@ void LoadMocassinSimulationDatabaseModelToContext(SCONTEXT_PARAMETER)
     assert_success(error != ERR_OK, "Failed to load the job from the database.");
 }
 
+void LoadMocassinSimulationDatabaseModelToContextFromCache(SCONTEXT_PARAMETER, JobDbModelCache_t*restrict cache)
+{
+    int32_t jobContextId = -1;
+    if (sscanf(getFileInformation(simContext)->JobDbQuery, "%i", &jobContextId) != 1)
+        error_exit(ERR_VALIDATION, "Job context id is invalid");
+
+    error_t error = PopulateDbModelFromModelCache(cache, &simContext->DbModel, jobContextId);
+    assert_success(error != ERR_OK, "Failed to load the job from the database model cache.");
+}
+
 static error_t PrepareSqlStatement(char *sqlQuery, sqlite3 *db, sqlite3_stmt **sqlStatement, int32_t id)
 {
     const int variableIndexInStmt = 1;
@@ -467,6 +477,7 @@ error_t PopulateDbModelFromDatabaseFilePath(JobDbModel_t *dbModel, const char *d
 
     error = sqlite3_open_v2(dbFile, &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, NULL);
     SQLCloseAndReturnIf(error != SQLITE_OK, db);
+    sqlite3_busy_timeout(db, SQL_BUSY_TIMEOUT_MS);
 
     error = InvokeLoadOperations(db, dbModel, GetParentObjectLoadOperations());
     SQLCloseAndReturnIf(error != SQLITE_OK, db);
@@ -515,3 +526,207 @@ DbModelOnLoadedOperations_t GetDataLoadedPostOperations()
     return (DbModelOnLoadedOperations_t) span_CArrayToSpan(operations);
 }
 
+/* Shared sub-model cache of the batch mode */
+
+// Type for functions that get the cache key of a database model
+typedef int32_t (*FDbModelCacheKey_t)(const JobDbModel_t* dbModel);
+
+// Get the structure model cache key of the passed database model
+static int32_t GetStructureModelCacheKey(const JobDbModel_t* dbModel)
+{
+    return dbModel->JobModel.StructureModelId;
+}
+
+// Get the energy model cache key of the passed database model
+static int32_t GetEnergyModelCacheKey(const JobDbModel_t* dbModel)
+{
+    return dbModel->JobModel.EnergyModelId;
+}
+
+// Get the transition model cache key of the passed database model
+static int32_t GetTransitionModelCacheKey(const JobDbModel_t* dbModel)
+{
+    return dbModel->JobModel.TransitionModelId;
+}
+
+// Get an access struct for the set of load operations that are specific to a single job
+static DbModelLoadOperations_t GetJobObjectLoadOperations()
+{
+    static FDbModelLoad_t operations[] =
+    {
+            (FDbModelLoad_t) GetJobModelFromDb,
+            (FDbModelLoad_t) GetLatticeModelFromDb
+    };
+    return (DbModelLoadOperations_t) span_CArrayToSpan(operations);
+}
+
+// Get an access struct for the set of structure model load operations
+static DbModelLoadOperations_t GetStructureModelLoadOperations()
+{
+    static FDbModelLoad_t operations[] =
+    {
+            (FDbModelLoad_t) GetStructureModelFromDb,
+            (FDbModelLoad_t) GetEnvironmentDefinitionsFromDb
+    };
+    return (DbModelLoadOperations_t) span_CArrayToSpan(operations);
+}
+
+// Get an access struct for the set of energy model load operations
+static DbModelLoadOperations_t GetEnergyModelLoadOperations()
+{
+    static FDbModelLoad_t operations[] =
+    {
+            (FDbModelLoad_t) GetEnergyModelFromDb,
+            (FDbModelLoad_t) GetPairEnergyTablesFromDb,
+            (FDbModelLoad_t) GetClusterEnergyTablesFromDb
+    };
+    return (DbModelLoadOperations_t) span_CArrayToSpan(operations);
+}
+
+// Get an access struct for the set of transition model load operations
+static DbModelLoadOperations_t GetTransitionModelLoadOperations()
+{
+    static FDbModelLoad_t operations[] =
+    {
+            (FDbModelLoad_t) GetTransitionModelFromDb,
+            (FDbModelLoad_t) GetJumpCollectionsFromDb,
+            (FDbModelLoad_t) GetJumpDirectionsFromDb
+    };
+    return (DbModelLoadOperations_t) span_CArrayToSpan(operations);
+}
+
+// Searches the passed cache list for the model with the cache key of the passed database model and loads it from the database if it does not exist yet
+static error_t FindOrLoadCachedDbModel(sqlite3 *db, JobDbModels_t *models, const JobDbModel_t *dbModel, FDbModelCacheKey_t getKey,
+                                       const DbModelLoadOperations_t operations, const DbModelOnLoadedOperations_t postOperations, JobDbModel_t **outModel)
+{
+    error_t error;
+    cpp_foreach(model, *models)
+    {
+        continue_if(getKey(model) != getKey(dbModel));
+        *outModel = model;
+        return SQLITE_OK;
+    }
+    return_if(list_IsFull(*models), ERR_BUFFEROVERFLOW);
+
+    JobDbModel_t newModel;
+    memset(&newModel, 0, sizeof(JobDbModel_t));
+    newModel.JobModel.StructureModelId = dbModel->JobModel.StructureModelId;
+    newModel.JobModel.EnergyModelId = dbModel->JobModel.EnergyModelId;
+    newModel.JobModel.TransitionModelId = dbModel->JobModel.TransitionModelId;
+
+    error = InvokeLoadOperations(db, &newModel, operations);
+    return_if(error != SQLITE_OK, error);
+
+    error = InvokeOnLoadedOperations(&newModel, postOperations);
+    return_if(error != ERR_OK, error);
+
+    list_PushBack(*models, newModel);
+    *outModel = models->End - 1;
+    return SQLITE_OK;
+}
+
+// Copies the passed shared energy model to a job specific one that owns the energy tables and the defect background (Converted to [kT] during initialization)
+static void CopySharedEnergyModelToJob(const EnergyModel_t *source, EnergyModel_t *target)
+{
+    *target = *source;
+    target->PairTables = span_ConstructFromBlob(target->PairTables, source->PairTables.Begin, span_Length(source->PairTables));
+    target->ClusterTables = span_ConstructFromBlob(target->ClusterTables, source->ClusterTables.Begin, span_Length(source->ClusterTables));
+    target->DefectBackground = array_ConstructFromBlob(target->DefectBackground, source->DefectBackground.Header);
+
+    cpp_foreach(table, target->PairTables)
+        table->EnergyTable = array_ConstructFromBlob(table->EnergyTable, table->EnergyTable.Header);
+
+    cpp_foreach(table, target->ClusterTables)
+        table->EnergyTable = array_ConstructFromBlob(table->EnergyTable, table->EnergyTable.Header);
+}
+
+// Copies the passed shared transition model to a job specific one that owns the jump directions and jump rules (Field factors and energy corrections are set during initialization)
+static void CopySharedTransitionModelToJob(const TransitionModel_t *source, TransitionModel_t *target)
+{
+    *target = *source;
+    target->JumpDirections = span_ConstructFromBlob(target->JumpDirections, source->JumpDirections.Begin, span_Length(source->JumpDirections));
+    target->JumpCollections = span_ConstructFromBlob(target->JumpCollections, source->JumpCollections.Begin, span_Length(source->JumpCollections));
+
+    cpp_foreach(collection, target->JumpCollections)
+        collection->JumpRules = span_ConstructFromBlob(collection->JumpRules, collection->JumpRules.Begin, span_Length(collection->JumpRules));
+}
+
+error_t OpenJobDbModelCache(JobDbModelCache_t*restrict cache, const char* dbFile, const int32_t capacity)
+{
+    error_t error;
+    sqlite3 *db;
+    memset(cache, 0, sizeof(JobDbModelCache_t));
+
+    error = sqlite3_open_v2(dbFile, &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, NULL);
+    SQLCloseAndReturnIf(error != SQLITE_OK, db);
+    sqlite3_busy_timeout(db, SQL_BUSY_TIMEOUT_MS);
+
+    error = pthread_mutex_init(&cache->Mutex, NULL) == 0 ? ERR_OK : ERR_UNKNOWN;
+    return_if(error, (sqlite3_close(db), error));
+
+    cache->Database = db;
+    cache->StructureModels = list_New(cache->StructureModels, capacity);
+    cache->EnergyModels = list_New(cache->EnergyModels, capacity);
+    cache->TransitionModels = list_New(cache->TransitionModels, capacity);
+    return ERR_OK;
+}
+
+void CloseJobDbModelCache(JobDbModelCache_t*restrict cache)
+{
+    assert_success(sqlite3_close(cache->Database), "Failed to close the database file.");
+    pthread_mutex_destroy(&cache->Mutex);
+    cache->Database = NULL;
+}
+
+error_t PopulateDbModelFromModelCache(JobDbModelCache_t*restrict cache, JobDbModel_t*restrict dbModel, int32_t jobContextId)
+{
+    error_t error;
+    let noOperations = (DbModelOnLoadedOperations_t) {.Begin = NULL, .End = NULL};
+    JobDbModel_t *structureModel = NULL, *energyModel = NULL, *transitionModel = NULL;
+    dbModel->JobModel.ContextId = jobContextId;
+
+    // Note: The connection is opened without sqlite mutexes, thus all database access is serialized by the cache mutex
+    pthread_mutex_lock(&cache->Mutex);
+    error = InvokeLoadOperations(cache->Database, dbModel, GetJobObjectLoadOperations());
+    if (error == SQLITE_OK)
+        error = FindOrLoadCachedDbModel(cache->Database, &cache->StructureModels, dbModel, GetStructureModelCacheKey,
+                                        GetStructureModelLoadOperations(), noOperations, &structureModel);
+    if (error == SQLITE_OK)
+        error = FindOrLoadCachedDbModel(cache->Database, &cache->EnergyModels, dbModel, GetEnergyModelCacheKey,
+                                        GetEnergyModelLoadOperations(), noOperations, &energyModel);
+    if (error == SQLITE_OK)
+        error = FindOrLoadCachedDbModel(cache->Database, &cache->TransitionModels, dbModel, GetTransitionModelCacheKey,
+                                        GetTransitionModelLoadOperations(), GetDataLoadedPostOperations(), &transitionModel);
+    pthread_mutex_unlock(&cache->Mutex);
+    return_if(error != SQLITE_OK, error);
+
+    // Note: The structure model is never changed during initialization and can be shared by all jobs
+    dbModel->StructureModel = structureModel->StructureModel;
+    CopySharedEnergyModelToJob(&energyModel->EnergyModel, &dbModel->EnergyModel);
+    CopySharedTransitionModelToJob(&transitionModel->TransitionModel, &dbModel->TransitionModel);
+
+    return InvokeOnLoadedOperations(dbModel, GetDataLoadedPostOperations());
+}
+
+void DeleteMocassinCachedDatabaseModelOfContext(SCONTEXT_PARAMETER)
+{
+    var dbModel = &simContext->DbModel;
+
+    cpp_foreach(table, dbModel->EnergyModel.PairTables)
+        array_Delete(table->EnergyTable);
+    cpp_foreach(table, dbModel->EnergyModel.ClusterTables)
+        array_Delete(table->EnergyTable);
+    cpp_foreach(collection, dbModel->TransitionModel.JumpCollections)
+        span_Delete(collection->JumpRules);
+
+    span_Delete(dbModel->EnergyModel.PairTables);
+    span_Delete(dbModel->EnergyModel.ClusterTables);
+    array_Delete(dbModel->EnergyModel.DefectBackground);
+    span_Delete(dbModel->TransitionModel.JumpCollections);
+    span_Delete(dbModel->TransitionModel.JumpDirections);
+    span_Delete(dbModel->JobModel.RoutineData.ParamData);
+    array_Delete(dbModel->LatticeModel.Lattice);
+    array_Delete(dbModel->LatticeModel.EnergyBackground);
+    free(dbModel->JobModel.JobHeader);
+    memset(dbModel, 0, sizeof(JobDbModel_t));
+}
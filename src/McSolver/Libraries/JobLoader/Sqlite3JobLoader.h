@@ -20,6 +20,9 @@
 // Macro that call finalize on a sql statement and returns an error code if the condition is true
 #define SQLFinalizeAndReturnIf(COND, STMT, ERR) if (COND) return (sqlite3_finalize(STMT), ERR)
 
+// Defines the time in milliseconds a database access waits for a lock held by another process (e.g. a job queue worker)
+#define SQL_BUSY_TIMEOUT_MS 600000
+
 // Macro that closes the database file and returns the close error code
 #define SQLCloseAndReturnIf(COND, DB) if (COND) return sqlite3_close(DB)
 
@@ -47,4 +50,7 @@ DbModelLoadOperations_t GetChildObjectLoadOperations();
 DbModelOnLoadedOperations_t GetDataLoadedPostOperations();
 
 // Main function - assign the provided JobDbModel object with the provided database and job context id
-error_t PopulateDbModelFromDatabaseFilePath(JobDbModel_t *dbModel, const char *dbFile, int32_t jobContextId);
\ No newline at end of file
+error_t PopulateDbModelFromDatabaseFilePath(JobDbModel_t *dbModel, const char *dbFile, int32_t jobContextId);
+
+// Batch function - assign the provided JobDbModel object with the provided job context id using the shared sub-models of the passed cache
+error_t PopulateDbModelFromModelCache(JobDbModelCache_t*restrict cache, JobDbModel_t*restrict dbModel, int32_t jobContextId);
\ No newline at end of file
@@ -0,0 +1,317 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	Sqlite3JobQueue.c           //
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Db sqlite worker job queue  //
+//////////////////////////////////////////
+
+#if defined(WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include "Libraries/Framework/Basic/TimeHelper.h"
+#include "Sqlite3JobLoader.h"
+
+// Defines the name of the job queue table
+#define JOBQUEUE_TABLE_NAME "JobQueue"
+
+// Defines the number of bytes reserved for the worker identification string
+#define JOBQUEUE_WORKERINFO_BYTECOUNT 128
+
+// Defines the status value of jobs that are not yet claimed by a worker
+#define JOBQUEUE_STATUS_PENDING 0
+
+// Defines the status value of jobs that are claimed by a worker
+#define JOBQUEUE_STATUS_RUNNING 1
+
+// Defines the status value of jobs that have been finished by a worker
+#define JOBQUEUE_STATUS_DONE 2
+
+// Defines the status value of jobs that have been abandoned by their worker too many times and are not claimed again
+#define JOBQUEUE_STATUS_FAILED 3
+
+// Defines the number of claims of a job after which an abandoned running job is marked as failed instead of being reclaimed
+#define JOBQUEUE_CLAIM_LIMIT 3
+
+// Defines the time in seconds between two heartbeats of the running jobs of a worker
+#define JOBQUEUE_HEARTBEAT_INTERVAL 60
+
+// Defines the time in seconds without heartbeat after which a running job is considered abandoned and can be reclaimed
+#define JOBQUEUE_HEARTBEAT_TIMEOUT (10 * JOBQUEUE_HEARTBEAT_INTERVAL)
+
+// Executes the passed sql statement without result rows on the passed database
+static error_t ExecuteSqlStatement(sqlite3* db, const char* sqlQuery)
+{
+    return sqlite3_exec(db, sqlQuery, NULL, NULL, NULL) == SQLITE_OK ? ERR_OK : ERR_DATABASE;
+}
+
+// Writes the identification of the calling worker process (host and process id) to the passed buffer
+static void GetWorkerInfoString(char* restrict buffer)
+{
+    char hostName[JOBQUEUE_WORKERINFO_BYTECOUNT / 2] = "localhost";
+    #if defined(WIN32)
+    let envName = getenv("COMPUTERNAME");
+    if (envName != NULL) strncpy(hostName, envName, sizeof(hostName) - 1);
+    #else
+    gethostname(hostName, sizeof(hostName) - 1);
+    #endif
+    snprintf(buffer, JOBQUEUE_WORKERINFO_BYTECOUNT, "%s:%i", hostName, (int32_t) getpid());
+}
+
+// Creates the job queue table if it does not exist and inserts the passed job ids that are not yet part of the queue
+static error_t EnsureJobQueueCreated(sqlite3* db, const int32_t* jobIds, const int32_t jobCount)
+{
+    let createQuery = "CREATE TABLE IF NOT EXISTS " JOBQUEUE_TABLE_NAME " ("
+                      "JobId INTEGER PRIMARY KEY, Status INTEGER NOT NULL DEFAULT 0, Worker TEXT, "
+                      "ClaimTime TEXT, FinishTime TEXT, RunTime REAL, Heartbeat INTEGER, ClaimCount INTEGER NOT NULL DEFAULT 0)";
+    let insertQuery = "INSERT OR IGNORE INTO " JOBQUEUE_TABLE_NAME " (JobId, Status) VALUES (?1, ?2)";
+
+    var error = ExecuteSqlStatement(db, "BEGIN IMMEDIATE");
+    return_if(error, error);
+
+    error = ExecuteSqlStatement(db, createQuery);
+    return_if(error, (ExecuteSqlStatement(db, "ROLLBACK"), error));
+
+    sqlite3_stmt* sqlStmt = NULL;
+    error = sqlite3_prepare_v2(db, insertQuery, -1, &sqlStmt, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_finalize(sqlStmt), ExecuteSqlStatement(db, "ROLLBACK"), ERR_DATABASE));
+
+    for (int32_t i = 0; i < jobCount; i++)
+    {
+        sqlite3_bind_int(sqlStmt, 1, jobIds[i]);
+        sqlite3_bind_int(sqlStmt, 2, JOBQUEUE_STATUS_PENDING);
+        error = sqlite3_step(sqlStmt);
+        return_if(error != SQLITE_DONE, (sqlite3_finalize(sqlStmt), ExecuteSqlStatement(db, "ROLLBACK"), ERR_DATABASE));
+        sqlite3_reset(sqlStmt);
+    }
+
+    sqlite3_finalize(sqlStmt);
+    return ExecuteSqlStatement(db, "COMMIT");
+}
+
+// Counts the total number of jobs in the job queue
+static error_t CountJobsOfQueue(sqlite3* db, int32_t* restrict outCount)
+{
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM " JOBQUEUE_TABLE_NAME, -1, &sqlStmt, NULL);
+    SQLFinalizeAndReturnIf(error != SQLITE_OK, sqlStmt, ERR_DATABASE);
+
+    error = sqlite3_step(sqlStmt);
+    SQLFinalizeAndReturnIf(error != SQLITE_ROW, sqlStmt, ERR_DATABASE);
+
+    *outCount = sqlite3_column_int(sqlStmt, 0);
+    sqlite3_finalize(sqlStmt);
+    return ERR_OK;
+}
+
+// Refreshes the heartbeat of all running jobs that are claimed by the calling worker process. Must be called with the queue mutex locked
+static error_t UpdateHeartbeatOfWorkerJobs(sqlite3* db)
+{
+    let updateQuery = "UPDATE " JOBQUEUE_TABLE_NAME " SET Heartbeat = ?1 WHERE Status = ?2 AND Worker = ?3";
+
+    char workerInfo[JOBQUEUE_WORKERINFO_BYTECOUNT];
+    GetWorkerInfoString(workerInfo);
+
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(db, updateQuery, -1, &sqlStmt, NULL);
+    SQLFinalizeAndReturnIf(error != SQLITE_OK, sqlStmt, ERR_DATABASE);
+    sqlite3_bind_int64(sqlStmt, 1, (int64_t) time(NULL));
+    sqlite3_bind_int(sqlStmt, 2, JOBQUEUE_STATUS_RUNNING);
+    sqlite3_bind_text(sqlStmt, 3, workerInfo, -1, SQLITE_TRANSIENT);
+
+    error = sqlite3_step(sqlStmt);
+    sqlite3_finalize(sqlStmt);
+    return (error == SQLITE_DONE) ? ERR_OK : ERR_DATABASE;
+}
+
+// Heartbeat thread entry that refreshes the heartbeat of the running jobs of the worker until the queue is closed
+static void* JobQueueHeartbeatThreadMain(void* args)
+{
+    JobQueue_t* queue = args;
+    pthread_mutex_lock(&queue->Mutex);
+    while (queue->IsHeartbeatActive)
+    {
+        struct timespec wakeTime;
+        timespec_get(&wakeTime, TIME_UTC);
+        wakeTime.tv_sec += JOBQUEUE_HEARTBEAT_INTERVAL;
+        pthread_cond_timedwait(&queue->HeartbeatCondition, &queue->Mutex, &wakeTime);
+        break_if(!queue->IsHeartbeatActive);
+
+        // Note: A missed heartbeat is not fatal, only a worker that misses heartbeats for the full timeout loses its jobs
+        if (UpdateHeartbeatOfWorkerJobs(queue->Database) != ERR_OK)
+            fprintf(stderr, "[Batch-Warning]: Failed to update the job queue heartbeat.\n");
+    }
+    pthread_mutex_unlock(&queue->Mutex);
+    return NULL;
+}
+
+error_t OpenJobQueue(JobQueue_t*restrict queue, const char* queueFile, const int32_t* jobIds, const int32_t jobCount, int32_t*restrict outQueueSize)
+{
+    error_t error;
+    sqlite3* db;
+    memset(queue, 0, sizeof(JobQueue_t));
+
+    error = sqlite3_open_v2(queueFile, &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL);
+    return_if(error != SQLITE_OK, (sqlite3_close(db), ERR_DATABASE));
+    sqlite3_busy_timeout(db, SQL_BUSY_TIMEOUT_MS);
+
+    error = EnsureJobQueueCreated(db, jobIds, jobCount);
+    return_if(error, (sqlite3_close(db), error));
+
+    error = CountJobsOfQueue(db, outQueueSize);
+    return_if(error, (sqlite3_close(db), error));
+
+    error = pthread_mutex_init(&queue->Mutex, NULL) == 0 ? ERR_OK : ERR_UNKNOWN;
+    return_if(error, (sqlite3_close(db), error));
+    error = pthread_cond_init(&queue->HeartbeatCondition, NULL) == 0 ? ERR_OK : ERR_UNKNOWN;
+    return_if(error, (pthread_mutex_destroy(&queue->Mutex), sqlite3_close(db), error));
+
+    queue->Database = db;
+    queue->IsHeartbeatActive = true;
+    error = pthread_create(&queue->HeartbeatThread, NULL, JobQueueHeartbeatThreadMain, queue) == 0 ? ERR_OK : ERR_UNKNOWN;
+    return_if(error, (queue->IsHeartbeatActive = false, pthread_cond_destroy(&queue->HeartbeatCondition), pthread_mutex_destroy(&queue->Mutex), sqlite3_close(db), error));
+    return ERR_OK;
+}
+
+void CloseJobQueue(JobQueue_t*restrict queue)
+{
+    pthread_mutex_lock(&queue->Mutex);
+    queue->IsHeartbeatActive = false;
+    pthread_cond_signal(&queue->HeartbeatCondition);
+    pthread_mutex_unlock(&queue->Mutex);
+    pthread_join(queue->HeartbeatThread, NULL);
+
+    assert_success(sqlite3_close(queue->Database), "Failed to close the job queue database file.");
+    pthread_cond_destroy(&queue->HeartbeatCondition);
+    pthread_mutex_destroy(&queue->Mutex);
+    queue->Database = NULL;
+}
+
+// Marks the passed job as failed after it was claimed the maximal number of times without finishing. Must be called inside a write transaction
+static error_t MarkJobOfQueueAsFailed(sqlite3* db, const int32_t jobId)
+{
+    let updateQuery = "UPDATE " JOBQUEUE_TABLE_NAME " SET Status = ?1 WHERE JobId = ?2";
+
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(db, updateQuery, -1, &sqlStmt, NULL);
+    SQLFinalizeAndReturnIf(error != SQLITE_OK, sqlStmt, ERR_DATABASE);
+    sqlite3_bind_int(sqlStmt, 1, JOBQUEUE_STATUS_FAILED);
+    sqlite3_bind_int(sqlStmt, 2, jobId);
+
+    error = sqlite3_step(sqlStmt);
+    SQLFinalizeAndReturnIf(error != SQLITE_DONE, sqlStmt, ERR_DATABASE);
+    sqlite3_finalize(sqlStmt);
+    return ERR_OK;
+}
+
+// Selects the next pending or abandoned running job of the queue and marks it as claimed by the calling worker. Must be called inside a write transaction
+static error_t ClaimNextPendingJob(sqlite3* db, int32_t* restrict outJobId)
+{
+    // Note: Pending jobs are preferred, running jobs are only reclaimed if their worker stopped the heartbeat (e.g. crash or fatal error exit)
+    let selectQuery = "SELECT JobId, Status, Worker, ClaimCount FROM " JOBQUEUE_TABLE_NAME " WHERE Status = ?1 OR (Status = ?2 AND IFNULL(Heartbeat, 0) < ?3) "
+                      "ORDER BY Status, JobId LIMIT 1";
+    let updateQuery = "UPDATE " JOBQUEUE_TABLE_NAME " SET Status = ?1, Worker = ?2, ClaimTime = ?3, Heartbeat = ?4, ClaimCount = ClaimCount + 1 WHERE JobId = ?5";
+    let claimTime = time(NULL);
+
+    sqlite3_stmt* sqlStmt = NULL;
+    error_t error;
+    int32_t jobId;
+    for (;;)
+    {
+        error = sqlite3_prepare_v2(db, selectQuery, -1, &sqlStmt, NULL);
+        SQLFinalizeAndReturnIf(error != SQLITE_OK, sqlStmt, ERR_DATABASE);
+        sqlite3_bind_int(sqlStmt, 1, JOBQUEUE_STATUS_PENDING);
+        sqlite3_bind_int(sqlStmt, 2, JOBQUEUE_STATUS_RUNNING);
+        sqlite3_bind_int64(sqlStmt, 3, (int64_t) claimTime - JOBQUEUE_HEARTBEAT_TIMEOUT);
+
+        error = sqlite3_step(sqlStmt);
+        SQLFinalizeAndReturnIf(error == SQLITE_DONE, sqlStmt, ERR_OK);
+        SQLFinalizeAndReturnIf(error != SQLITE_ROW, sqlStmt, ERR_DATABASE);
+        jobId = sqlite3_column_int(sqlStmt, 0);
+        if (sqlite3_column_int(sqlStmt, 1) != JOBQUEUE_STATUS_RUNNING)
+        {
+            sqlite3_finalize(sqlStmt);
+            break;
+        }
+
+        // Note: A job that repeatedly kills its worker (e.g. memory exhaustion) would otherwise be reclaimed forever
+        let lastWorker = (const char*) sqlite3_column_text(sqlStmt, 2);
+        let claimCount = sqlite3_column_int(sqlStmt, 3);
+        let isClaimable = claimCount < JOBQUEUE_CLAIM_LIMIT;
+        if (isClaimable)
+            fprintf(stdout, "[Batch-Info]: Reclaiming job %i of the unresponsive worker %s.\n", jobId, (lastWorker != NULL) ? lastWorker : "unknown");
+        else
+            fprintf(stdout, "[Batch-Info]: Job %i of the unresponsive worker %s failed after %i claims and is not reclaimed.\n",
+                    jobId, (lastWorker != NULL) ? lastWorker : "unknown", claimCount);
+        sqlite3_finalize(sqlStmt);
+        break_if(isClaimable);
+
+        error = MarkJobOfQueueAsFailed(db, jobId);
+        return_if(error, error);
+    }
+
+    char workerInfo[JOBQUEUE_WORKERINFO_BYTECOUNT];
+    char timeStamp[TIME_ISO8601_BYTECOUNT];
+    GetWorkerInfoString(workerInfo);
+    GetCurrentIso8601UtcTimeStamp(timeStamp);
+
+    error = sqlite3_prepare_v2(db, updateQuery, -1, &sqlStmt, NULL);
+    SQLFinalizeAndReturnIf(error != SQLITE_OK, sqlStmt, ERR_DATABASE);
+    sqlite3_bind_int(sqlStmt, 1, JOBQUEUE_STATUS_RUNNING);
+    sqlite3_bind_text(sqlStmt, 2, workerInfo, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(sqlStmt, 3, timeStamp, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(sqlStmt, 4, (int64_t) claimTime);
+    sqlite3_bind_int(sqlStmt, 5, jobId);
+
+    error = sqlite3_step(sqlStmt);
+    SQLFinalizeAndReturnIf(error != SQLITE_DONE, sqlStmt, ERR_DATABASE);
+    sqlite3_finalize(sqlStmt);
+
+    *outJobId = jobId;
+    return ERR_OK;
+}
+
+error_t ClaimNextJobOfQueue(JobQueue_t*restrict queue, int32_t*restrict outJobId)
+{
+    error_t error;
+    *outJobId = -1;
+
+    // Note: The immediate transaction takes the write lock before the select, thus concurrent workers can never claim the same job
+    pthread_mutex_lock(&queue->Mutex);
+    error = ExecuteSqlStatement(queue->Database, "BEGIN IMMEDIATE");
+    if (error == ERR_OK)
+    {
+        error = ClaimNextPendingJob(queue->Database, outJobId);
+        let endError = ExecuteSqlStatement(queue->Database, (error == ERR_OK) ? "COMMIT" : "ROLLBACK");
+        if (error == ERR_OK) error = endError;
+    }
+    pthread_mutex_unlock(&queue->Mutex);
+    return error;
+}
+
+error_t FinishJobOfQueue(JobQueue_t*restrict queue, const int32_t jobId, const double runTime)
+{
+    let updateQuery = "UPDATE " JOBQUEUE_TABLE_NAME " SET Status = ?1, FinishTime = ?2, RunTime = ?3 WHERE JobId = ?4";
+
+    char timeStamp[TIME_ISO8601_BYTECOUNT];
+    GetCurrentIso8601UtcTimeStamp(timeStamp);
+
+    pthread_mutex_lock(&queue->Mutex);
+    sqlite3_stmt* sqlStmt = NULL;
+    var error = sqlite3_prepare_v2(queue->Database, updateQuery, -1, &sqlStmt, NULL);
+    if (error == SQLITE_OK)
+    {
+        sqlite3_bind_int(sqlStmt, 1, JOBQUEUE_STATUS_DONE);
+        sqlite3_bind_text(sqlStmt, 2, timeStamp, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_double(sqlStmt, 3, runTime);
+        sqlite3_bind_int(sqlStmt, 4, jobId);
+        error = sqlite3_step(sqlStmt);
+    }
+    sqlite3_finalize(sqlStmt);
+    pthread_mutex_unlock(&queue->Mutex);
+    return (error == SQLITE_DONE) ? ERR_OK : ERR_DATABASE;
+}
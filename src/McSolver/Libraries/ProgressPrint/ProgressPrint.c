@@ -47,33 +47,6 @@ static inline int64_t  GetCounterCollectionCycleCount(const StateCounterCollecti
            + counters->SiteBlockingCount;
 }
 
-// Checks if a particle id is potentially marked as mobile in any stable environment definition
-static inline bool_t ParticleIsMarkedAsMobile(SCONTEXT_PARAMETER, const byte_t particleId)
-{
-    let jumpCountTable = getJumpCountMapping(simContext);
-    int32_t dimensions[] = {0, 0};
-    GetArrayDimensions((VoidArray_t*) jumpCountTable, dimensions);
-    for (int32_t posId = 0; posId < dimensions[0]; ++posId)
-    {
-        let envState = getEnvironmentStateAt(simContext, posId);
-        if (!envState->IsStable) continue;
-
-        var canExistOnPosition = false;
-        c_foreach(id, envState->EnvironmentDefinition->PositionParticleIds)
-        {
-            if (*id != particleId) continue;
-            canExistOnPosition = true;
-        }
-        if (canExistOnPosition)
-        {
-            let jumpCount = array_Get(*jumpCountTable, posId, particleId);
-            if (jumpCount != JPOOL_DIRCOUNT_STATIC) return true;
-        }
-    }
-
-    return false;
-}
-
 // Prints the passed particle statistics data to the stream
 static void PrintParticleStatistics(const ParticleStatistics_t* restrict statistics, file_t*restrict fstream)
 {
@@ -245,6 +218,15 @@ static void PrintRunStatisticsMetaInfo(SCONTEXT_PARAMETER, FILE* fstream)
     fprintf(fstream, MC_DEFAULT_FORMAT(MC_OUTF64_FORMAT), "Probability => Norm. Factor", "",
             metaData->JumpNormalization);
 
+    if (IsPrecisionAbortActive(simContext))
+    {
+        let precisionSystem = getPrecisionAbortSystem(simContext);
+        fprintf(fstream, MC_DEFAULT_FORMAT(MC_OUTF64_FORMAT), "Precision => Relative error", "",
+                precisionSystem->RelativeError);
+        fprintf(fstream, MC_DEFAULT_FORMAT(MC_OUTF64_FORMAT), "Precision => Absolute error", "",
+                precisionSystem->AbsoluteError);
+    }
+
     fprintf(fstream, "\n");
     fflush(fstream);
 
@@ -353,6 +335,7 @@ static void PrintStatusFlagCollection(SCONTEXT_PARAMETER, file_t* fstream)
     if (flagsAreTrue(flags, STATE_FLG_CONDABORT)) fprintf(fstream, "ABORT_REASON_CONDITION ");
     if (flagsAreTrue(flags, STATE_FLG_RATEABORT)) fprintf(fstream, "ABORT_REASON_SUCCESSRATE ");
     if (flagsAreTrue(flags, STATE_FLG_ENERGYABORT)) fprintf(fstream, "ABORT_REASON_LATTICEENERGY ");
+    if (flagsAreTrue(flags, STATE_FLG_PRECISIONABORT)) fprintf(fstream, "ABORT_REASON_PRECISION ");
     fprintf(fstream, "\n");
     fflush(fstream);
 }
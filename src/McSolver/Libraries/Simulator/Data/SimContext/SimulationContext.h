@@ -37,6 +37,9 @@
 // Marks the "skipped due to jump frequency" cycle outcome case
 #define MC_SKIPPED_CYCLE        6
 
+// Marks the "selected slot does not contain a jump" cycle outcome case
+#define MC_NULLSLOT_CYCLE       7
+
 // Array type for 3D pair energy delta tables [Original][New][Partner]
 // Layout@ggc_x86_64 => 24@[8,8,8]
 typedef Array_t(double, 3, PairDeltaTable) PairDeltaTable_t;
@@ -344,7 +347,7 @@ typedef struct CycleState
 typedef List_t(int32_t, EnvironmentPool) EnvironmentPool_t;
 
 // Type for the direction pools
-// Layout@ggc_x86_64 => 40@[24,4,4,4,{4}]
+// Layout@ggc_x86_64 => 56@[24,4,4,4,4,8,8]
 typedef struct DirectionPool
 {
     // The environment pool of the direction pool. Contains affiliated [environmentId]
@@ -359,8 +362,14 @@ typedef struct DirectionPool
     // The current selectable jump count of the pool
     int32_t             JumpCount;
 
-    // Padding integer
-    int32_t             Padding:32;
+    // The particle id of the pool (Zero if the pools are not grouped by particle)
+    int32_t             ParticleId;
+
+    // The relative selection weight of the pool jumps. Accepted jump probabilities are divided by the weight
+    double              SelectionWeight;
+
+    // The maximum raw jump probability of the pool jumps that was found during the KMC normalization
+    double              RawMaxJumpProbability;
     
 } DirectionPool_t;
 
@@ -368,8 +377,88 @@ typedef struct DirectionPool
 // Layout@ggc_x86_64 => 16@[8,8]
 typedef Span_t(DirectionPool_t, DirectionPools) DirectionPools_t;
 
+// Type for the jump path origin offsets of the rejection-free KMC rate catalog and the KMC selection masks
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(Vector4_t, PathOriginOffsets) PathOriginOffsets_t;
+
+// Type for the jump slot masks of all environments. Bit [RelativeJumpId] is set if the current path occupation has a matching jump rule
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(uint64_t, JumpSlotMasks) JumpSlotMasks_t;
+
+// Type for a particle pool of the MMC partner selection. Contains all stable environments of one [PositionId][ParticleId] combination
+// Layout@ggc_x86_64 => 48@[24,8,8,4,{4}]
+typedef struct MmcPartnerPool
+{
+    // The environment pool of the particle pool. Contains affiliated [environmentId]
+    EnvironmentPool_t   EnvironmentPool;
+
+    // The number of valid exchange partners summed over all jump directions of one pool environment (Only maintained for start pools)
+    int64_t             PartnerCount;
+
+    // The number of (start environment, jump direction) combinations of the lattice that accept a pool environment as exchange partner
+    int64_t             TargetCount;
+
+    // The number of jump directions of the pool particle if the pool provides start environments (Zero otherwise)
+    int32_t             JumpCount;
+
+    // Padding integer
+    int32_t             Padding:32;
+
+} MmcPartnerPool_t;
+
+// Type for lists of MMC particle pools
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(MmcPartnerPool_t, MmcPartnerPools) MmcPartnerPools_t;
+
+// Type for particle id bitmasks. Bit [ParticleId] is set if the particle is contained
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(Bitmask_t, ParticleMasks) ParticleMasks_t;
+
+// Type for the MMC partner selection system. Selects each valid (start, direction, partner) exchange of the lattice with equal probability
+// Layout@ggc_x86_64 => 88@[16,16,16,16,8,8,8]
+typedef struct MmcPartnerSystem
+{
+    // The particle pools by [PositionId * PARTICLE_IDLIMIT + ParticleId]
+    MmcPartnerPools_t   ParticlePools;
+
+    // The ids of all particle pools that provide start environments
+    IdMappingSpan_t     StartPoolIds;
+
+    // The relative position id of each environment in its particle pool by [EnvironmentId]
+    IdMappingSpan_t     PoolPositionIds;
+
+    // The particles that are valid exchange partners by [JumpDirectionId * PARTICLE_IDLIMIT + StartParticleId]
+    ParticleMasks_t     PartnerParticleMasks;
+
+    // The number of valid (start, direction, partner) exchanges of the current lattice
+    int64_t             ExchangeCount;
+
+    // The number of selectable (start, direction) combinations of the current lattice
+    int64_t             StartJumpCount;
+
+    // The ratio of the reverse and forward proposal probabilities of the last selected exchange
+    double              ProposalRatio;
+
+} MmcPartnerSystem_t;
+
+// Type for a slot of the flat jump slot table that references one selectable jump
+// Layout@ggc_x86_64 => 8@[4,4]
+typedef struct JumpSlot
+{
+    // The environment id of the jump start
+    int32_t EnvironmentId;
+
+    // The relative jump id of the jump (The rank of the set mask bit if the KMC selection masks are active)
+    int32_t RelativeJumpId;
+
+} JumpSlot_t;
+
+// Type for the flat jump slot table that stores all selectable jumps in one dense list
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef List_t(JumpSlot_t, JumpSlotTable) JumpSlotTable_t;
+
 // Type for the jump selection pool
-// Layout@ggc_x86_64 => 64@[4,4,16,40]
+// Layout@ggc_x86_64 => 256@[4,4,16,40,8,4,4,16,16,16,88,24,16]
 typedef struct JumpSelectionPool
 {
     // The number of selectable jumps in the pool
@@ -383,9 +472,217 @@ typedef struct JumpSelectionPool
 
     // The span of direction pools
     DirectionPools_t    DirectionPools;
-    
+
+    // The sum of the selectable jumps of all pools multiplied by the pool selection weights (Only maintained if the pools are grouped by particle)
+    double              WeightedJumpCount;
+
+    // The direction pool mapping index offset per particle id (Zero if the pools are not grouped by particle)
+    int32_t             ParticlePoolStride;
+
+    // The slot id mapping offset per environment id (Zero if the flat jump slot table is not active)
+    int32_t             JumpSlotStride;
+
+    // The jump slot masks by [EnvironmentId] (Only maintained if the KMC selection masks are active, the pools then group by the number of set bits)
+    JumpSlotMasks_t     JumpSlotMasks;
+
+    // The jump path origin offsets of all positions. Subtracting an offset from a path member vector yields the path start vector
+    PathOriginOffsets_t PathOriginOffsets;
+
+    // The begin index of the path origin offsets for each position id with an additional end entry
+    IdMappingSpan_t     PathOriginOffsetBegins;
+
+    // The partner selection system of the MMC selection masks (Only maintained if the MMC partner selection is active)
+    MmcPartnerSystem_t  PartnerSystem;
+
+    // The flat jump slot table that contains one entry for each selectable jump (Only maintained if the flat jump slot table is active)
+    JumpSlotTable_t     JumpSlotTable;
+
+    // The slot table index of each selectable jump by [EnvironmentId * JumpSlotStride + RelativeJumpId]
+    IdMappingSpan_t     JumpSlotIds;
+
 } JumpSelectionPool_t;
 
+// Type for the rate sum tree of the rejection-free KMC rate catalog
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(double, RateSumTree) RateSumTree_t;
+
+// Type for the rejection-free KMC rate catalog. Stores the rate of each [EnvironmentId][RelativeJumpId] slot in a flat binary sum tree
+// Layout@ggc_x86_64 => 104@[16,16,16,24,16,4,4,8]
+typedef struct KmcRateCatalog
+{
+    // The flat binary sum tree. Node i is the sum of nodes 2i and 2i+1, the rate of slot j is the leaf [LeafCount + j]
+    RateSumTree_t       RateSumTree;
+
+    // The jump path origin offsets of all positions. Subtracting an offset from a path member vector yields the path start vector
+    PathOriginOffsets_t PathOriginOffsets;
+
+    // The begin index of the path origin offsets for each position id with an additional end entry
+    IdMappingSpan_t     PathOriginOffsetBegins;
+
+    // The list of environment ids that require a rate refresh after a system advance
+    EnvironmentPool_t   RefreshPool;
+
+    // The marker buffer that flags environments that are already contained in the refresh pool
+    Buffer_t            RefreshMarkers;
+
+    // The number of leaf nodes of the sum tree (Equals the number of slots)
+    int32_t             LeafCount;
+
+    // The number of slots per environment (Equals the max jump direction count)
+    int32_t             SlotsPerEnvironment;
+
+    // The rate value factor that converts the catalog rates into units of [Hz]
+    double              RateToHzFactor;
+
+} KmcRateCatalog_t;
+
+// Type for an occupation change of an environment that is exchanged between the ranks of the distributed KMC mode
+// Layout@ggc_x86_64 => 12@[4,4,1,{3}]
+typedef struct EnvironmentChange
+{
+    // The id of the changed environment
+    int32_t     EnvironmentId;
+
+    // The new mobile tracker id of the environment
+    int32_t     MobileTrackerId;
+
+    // The new particle id of the environment
+    byte_t      ParticleId;
+
+} EnvironmentChange_t;
+
+// Type for the list of environment changes of a sector
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef List_t(EnvironmentChange_t, EnvironmentChanges) EnvironmentChanges_t;
+
+// Type for a sector of the sublattice parallel KMC/MMC system. Stores the sector environments and the sector local accumulators
+// Layout@ggc_x86_64 => 128@[16,16,16,16,24,16,8,8,8]
+typedef struct KmcSector
+{
+    // The ids of all sector environments that provide jump slots
+    IdMappingSpan_t         EnvironmentIds;
+
+    // The sector local particle counters. Merged into the main state counters
+    CountersState_t         Counters;
+
+    // The sector local global movement trackers. Merged into the main state global trackers
+    TrackersState_t         GlobalTrackers;
+
+    // The sector local jump statistics. Merged into the main state jump statistics
+    JumpStatisticsState_t   JumpStatistics;
+
+    // The environment changes of the sector since the last exchange (Logged on the boundary sectors of a rank in the distributed mode only)
+    EnvironmentChanges_t    EnvironmentChanges;
+
+    // The random number generator stream of the sector
+    Pcg32_t                 Rng;
+
+    // The number of executed jumps of the sector since the last merge
+    int64_t                 McsCount;
+
+    // The number of non-null cycles of the sector since the last merge
+    int64_t                 CycleCount;
+
+    // The lattice energy change of the sector since the last merge in units of [kT] (Sublattice parallel MMC only)
+    double                  EnergyChange;
+
+} KmcSector_t;
+
+// Type for the sector span of the sublattice parallel KMC/MMC system
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(KmcSector_t, KmcSectors) KmcSectors_t;
+
+// Type for the sublattice parallel KMC/MMC system. Sectors are slabs along one lattice axis that alternate between two active colors
+// Layout@ggc_x86_64 => 88@[16,4,4,4,4,8,8,16,4,4,4,4,4,{4}]
+typedef struct KmcSublatticeSystem
+{
+    // The sector span. Even and odd sector ids form the two sublattices that are executed in alternating phases
+    KmcSectors_t    Sectors;
+
+    // The lattice axis index (0 = A, 1 = B, 2 = C) along which the sectors are cut
+    int32_t         SectorAxis;
+
+    // The width of each sector in unit cells along the sector axis
+    int32_t         SectorWidth;
+
+    // The number of jump slots per sector environment (Equals the max jump direction count)
+    int32_t         SlotsPerEnvironment;
+
+    // The number of worker threads that execute the sectors of a phase
+    int32_t         ThreadCount;
+
+    // The number of cycles each sector executes during one phase
+    int64_t         CyclesPerPhase;
+
+    // The simulated time span of a full sweep over both sublattices [s]
+    double          TimePerSweep;
+
+    // The copy of the main state buffer at the last merge of the distributed mode. Reference for the rank local changes
+    Buffer_t        ReferenceState;
+
+    // The id of the rank in the distributed mode (Zero for single process execution)
+    int32_t         RankId;
+
+    // The number of ranks in the distributed mode (One for single process execution)
+    int32_t         RankCount;
+
+    // The first sector id that is owned by the rank
+    int32_t         SectorBegin;
+
+    // The end sector id of the sectors that are owned by the rank
+    int32_t         SectorEnd;
+
+    // The cyclic shift of the sector borders along the sector axis in unit cells (Randomized each sweep in the MMC mode, always zero for KMC)
+    int32_t         SectorShift;
+
+    // Padding integer
+    int32_t         Padding:32;
+
+} KmcSublatticeSystem_t;
+
+// Type for one temperature replica of the replica exchange MMC mode
+// Layout@ggc_x86_64 => 40@[8,8,8,8,8]
+typedef struct MmcReplica
+{
+    // The replica context. Owns lattice, selection pool, state and rng and shares the database model with the main context (The main context for replica zero)
+    struct SimulationContext*   Context;
+
+    // The simulation temperature of the replica in [K]
+    double                      Temperature;
+
+    // The factor the MMC exponent of the replica is multiplied with (Target temperature divided by the replica temperature)
+    double                      Alpha;
+
+    // The number of configuration swaps that were attempted with the next hotter replica
+    int64_t                     SwapAttemptCount;
+
+    // The number of configuration swaps that were accepted with the next hotter replica
+    int64_t                     SwapAcceptCount;
+
+} MmcReplica_t;
+
+// Type for the replica span of the replica exchange MMC mode
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(MmcReplica_t, MmcReplicas) MmcReplicas_t;
+
+// Type for the replica exchange MMC system. Replicas are ordered by ascending temperature, replica zero runs at the target temperature
+// Layout@ggc_x86_64 => 32@[16,8,4,{4}]
+typedef struct MmcReplicaSystem
+{
+    // The replica span. Each replica is executed on its own thread
+    MmcReplicas_t   Replicas;
+
+    // The number of cycles each replica executes between two swap attempts
+    int64_t         CyclesPerExchange;
+
+    // The number of executed swap rounds (Even rounds try the pairs [0,1],[2,3],..., odd rounds the pairs [1,2],[3,4],...)
+    int32_t         ExchangeRoundCount;
+
+    // Padding integer
+    int32_t         Padding:32;
+
+} MmcReplicaSystem_t;
+
 // Type for the program run information
 // Layout@ggc_x86_64 => 16@[8,8]
 typedef struct SimulationRunInfo
@@ -417,12 +714,18 @@ typedef struct PhysicalInfo
 } PhysicalInfo_t;
 
 // Type for the file string information
-// Layout@ggc_x86_64 => 88@[8,8,8,8,8,8,8,8,8,8,8]
+// Layout@ggc_x86_64 => 112@[8,8,8,8,8,8,8,8,8,8,8,8,8,8]
 typedef struct FileInfo
 {
     // The database query string for data loading
     char const* JobDbQuery;
 
+    // The job id range string of the batch mode (NULL if the batch mode is not active)
+    char const* JobBatchQuery;
+
+    // The path to the job queue database file of the worker mode (NULL if the worker mode is not active)
+    char const* JobQueuePath;
+
     // The executable path
     char const* ExecutablePath;
 
@@ -452,7 +755,10 @@ typedef struct FileInfo
 
     // The path where the system should look for extension routines
     char const* ExtensionLookupPath;
-    
+
+    // The path to a state file of a compatible job that provides the start lattice of a new simulation (NULL if no warm start is requested)
+    char const* WarmStartStateFile;
+
 } FileInfo_t;
 
 // Type for floating point buffers with storage for last average
@@ -476,8 +782,89 @@ typedef struct Flp64Buffer
     
 } Flp64Buffer_t;
 
+// Type for the list of block values of the statistical precision abort condition
+// Layout@ggc_x86_64 => 24@[8,8,8]
+typedef List_t(double, PrecisionBlockValues) PrecisionBlockValues_t;
+
+// Type for the block averaging system of the statistical precision abort condition
+// Layout@ggc_x86_64 => 72@[24,8,8,8,8,8,8]
+typedef struct PrecisionAbortSystem
+{
+    // The observable values of the finished main run blocks
+    PrecisionBlockValues_t  BlockValues;
+
+    // The observable sum at the end of the last block (NaN if no block was finished yet)
+    double                  LastObservableSum;
+
+    // The simulated time at the end of the last block in [s]
+    double                  LastSimulatedTime;
+
+    // The estimated relative standard error of the block average (Infinite if not enough blocks exist)
+    double                  RelativeError;
+
+    // The estimated absolute standard error of the block average (Infinite if not enough blocks exist)
+    double                  AbsoluteError;
+
+    // The sum of the lattice energy samples of the running MMC block in [eV]
+    double                  BlockSampleSum;
+
+    // The number of lattice energy samples of the running MMC block
+    int64_t                 BlockSampleCount;
+
+} PrecisionAbortSystem_t;
+
+// Type for the binned raw jump probability counters of the quantile KMC normalization
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(int64_t, KmcProbabilityCounters) KmcProbabilityCounters_t;
+
+// Type for the quantile based and block adaptive KMC normalization system
+// Layout@ggc_x86_64 => 40@[16,8,8,8]
+typedef struct KmcNormalizationSystem
+{
+    // The occurrence counters of the raw jump probabilities. The bins are equidistant sub-divisions of the binary exponent of the probability
+    KmcProbabilityCounters_t    ProbabilityCounters;
+
+    // The total number of recorded raw jump probabilities
+    int64_t                     SampleCount;
+
+    // The number of jump attempts with a normalized probability above one since the last adaption
+    int64_t                     OverflowCount;
+
+    // The accepted jump count of the main cycle counters at the last adaption
+    int64_t                     LastAdaptionMcsCount;
+
+} KmcNormalizationSystem_t;
+
+// Type for the energy envelope of a jump rule that bounds the S2 energy correction of the final state calculation
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef struct JumpEnergyEnvelope
+{
+    // The lower bound of the S2 energy correction in units of [kT]
+    double  MinS2Correction;
+
+    // The upper bound of the S2 energy correction in units of [kT]
+    double  MaxS2Correction;
+
+} JumpEnergyEnvelope_t;
+
+// Type for the energy envelope span of all jump rules
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(JumpEnergyEnvelope_t, JumpEnergyEnvelopes) JumpEnergyEnvelopes_t;
+
+// Type for the energy envelope system of the KMC early rejection
+// Layout@ggc_x86_64 => 32@[16,16]
+typedef struct KmcEnvelopeSystem
+{
+    // The energy envelopes of all jump rules by [RuleOffsets[JumpCollectionId] + JumpRuleId]
+    JumpEnergyEnvelopes_t   Envelopes;
+
+    // The envelope index offset of the first rule of each jump collection
+    IdMappingSpan_t         RuleOffsets;
+
+} KmcEnvelopeSystem_t;
+
 // Type for the simulation dynamic model
-// Layout@ggc_x86_64 => 208@[80,24,32,16,24,16,16]
+// Layout@ggc_x86_64 => 616@[112,24,32,72,16,24,16,16,104,88,32,48,32]
 typedef struct DynamicModel
 {
     // The simulation file information
@@ -489,6 +876,9 @@ typedef struct DynamicModel
     // The lattice energy buffer
     Flp64Buffer_t           LatticeEnergyBuffer;
 
+    // The block averaging system of the statistical precision abort
+    PrecisionAbortSystem_t  PrecisionAbortSystem;
+
     // The simulation runtime information
     SimulationRunInfo_t     RuntimeInfo;
 
@@ -501,6 +891,21 @@ typedef struct DynamicModel
     // The pair delta 3D table span. Access by [TableId][OriginalParticleId][NewParticleId][CenterParticleId]
     PairDeltaTables_t       PairDeltaTables;
 
+    // The rate catalog of the rejection-free KMC mode
+    KmcRateCatalog_t        RateCatalog;
+
+    // The sector system of the sublattice parallel KMC/MMC mode
+    KmcSublatticeSystem_t   SublatticeSystem;
+
+    // The replica system of the replica exchange MMC mode
+    MmcReplicaSystem_t      ReplicaSystem;
+
+    // The quantile normalization system of the KMC mode
+    KmcNormalizationSystem_t NormalizationSystem;
+
+    // The energy envelope system of the KMC early rejection
+    KmcEnvelopeSystem_t     EnvelopeSystem;
+
 } DynamicModel_t;
 
 // Type for plugin function pointers
@@ -534,12 +939,60 @@ typedef struct CmdArguments
 } CmdArguments_t;
 
 // Type for storing the program overwrites defined by CMD arguments
-// Layout@ggc_x86_64 => 16@[8,4,{4}]
+// Layout@ggc_x86_64 => 104@[8,4,4,4,4,8,4,4,8,8,8,8,8,4,4,8,8]
 typedef struct CmdOverwrites
 {
     //  An overwrite energy value in [eV] for the new upper limit of jump histograms
     double  JumpHistogramMaxValue;
 
+    // The number of worker threads for the sublattice parallel KMC mode (Values below two use the serial routine)
+    int32_t KmcThreadCount;
+
+    // The number of concurrently simulated jobs of the batch mode
+    int32_t BatchThreadCount;
+
+    // The number of temperature replicas of the replica exchange MMC mode (Values below two use the single chain routine)
+    int32_t MmcReplicaCount;
+
+    // The number of worker threads for the sublattice parallel MMC mode (Values below two use the serial routine)
+    int32_t MmcThreadCount;
+
+    // The temperature of the hottest replica of the replica exchange MMC mode in [K] (Zero uses the default ladder)
+    double  MmcReplicaMaxTemperature;
+
+    // The number of annealing pre-run steps per mobile particle of the MMC mode (Zero disables the pre-run unless the job requests it)
+    int32_t MmcPreRunMcsp;
+
+    // The number of worker threads an extension routine may use (Values below two request serial execution)
+    int32_t ExtensionThreadCount;
+
+    // The relative energy fluctuation tolerance of the exchange equilibration before the KMC routine (Zero disables the equilibration)
+    double  KmcEquilibrationTolerance;
+
+    // The target relative standard error of the block averaged conductivity/diffusion (KMC) or lattice energy (MMC) (Zero disables the precision abort)
+    double  PrecisionAbortTarget;
+
+    // The target absolute standard error of the block averaged observable in the units of the block values (Zero disables the absolute criterion)
+    double  PrecisionAbortAbsolute;
+
+    // The comma separated temperature list in [K] of the parameter sweep mode (NULL uses the job temperature for all sweep points)
+    char const* SweepTemperatures;
+
+    // The comma separated electric field modulus list in [V/m] of the parameter sweep mode (NULL uses the job field for all sweep points)
+    char const* SweepFieldModuli;
+
+    // The number of independent walkers of the KMC ensemble mode (Values below two use the single walker routine)
+    int32_t EnsembleCount;
+
+    // The number of worker threads of the direct enumeration KMC normalization (Zero uses the simulated auto optimization pre-run)
+    int32_t KmcDirectNormThreadCount;
+
+    // The lower limit of the relative selection weight of a particle group of the grouped KMC normalization (Zero uses the global normalization)
+    double  KmcGroupNormWeightLimit;
+
+    // The probability quantile of the jump attempts that defines the KMC normalization (Zero normalizes to the largest probability)
+    double  KmcNormalizationQuantile;
+
 } CmdOverwrites_t;
 
 // Type for the full simulation context that provides access to all simulation data structures
@@ -585,6 +1038,45 @@ typedef struct SimulationContext
     //  Marks if the simulation does not log jump events into histograms
     bool_t              IsJumpLoggingDisabled;
 
+    // Marks if the KMC simulation uses the rejection-free event selection
+    bool_t              IsRejectionFreeKmcActive;
+
+    // Marks if the KMC simulation uses the sublattice parallel execution
+    bool_t              IsSublatticeParallelKmcActive;
+
+    // Marks if the MMC simulation uses the replica exchange execution
+    bool_t              IsReplicaExchangeMmcActive;
+
+    // Marks if the MMC simulation uses the sublattice parallel execution
+    bool_t              IsSublatticeParallelMmcActive;
+
+    // Marks if a KMC warm start also imports the pre-run jump normalization and skips the pre-run
+    bool_t              IsWarmStartNormalizationActive;
+
+    // Marks if the KMC jump normalization is determined by direct enumeration of the initial jumps instead of the auto optimization pre-run
+    bool_t              IsDirectKmcNormalizationActive;
+
+    // Marks if the KMC jump normalization and jump selection are weighted independently for each selectable particle
+    bool_t              IsGroupKmcNormalizationActive;
+
+    // Marks if the KMC jump normalization is defined by a probability quantile and adapted at the block boundaries of the main run
+    bool_t              IsQuantileKmcNormalizationActive;
+
+    // Marks if the KMC jump selection draws only from jump slots with a jump rule for the current path occupation
+    bool_t              IsKmcSelectionMaskActive;
+
+    // Marks if the MMC jump selection draws the exchange partner only from environments with a valid exchange rule
+    bool_t              IsMmcPartnerSelectionActive;
+
+    // Marks if the jump selection draws from the flat jump slot table instead of the direction pools
+    bool_t              IsFlatJumpSlotTableActive;
+
+    // Marks if KMC events are rejected before the final state calculation if the energy envelope of the rule allows it
+    bool_t              IsKmcEarlyRejectionActive;
+
+    // Marks if the environment links, jump status array and pair delta tables are borrowed from another context and are not owned by this context
+    bool_t              IsLinkingSystemShared;
+
 } SimulationContext_t;
 
 // Construct a new raw simulation context struct with relative path as IO and math.h exp as exp function
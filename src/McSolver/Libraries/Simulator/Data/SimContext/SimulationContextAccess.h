@@ -89,6 +89,24 @@ static inline JumpStatus_t* getJumpStatusByVector4(SCONTEXT_PARAMETER, const Vec
     return &array_Get(*getJumpStatusArray(simContext), vecCoorSet4(*vector));
 }
 
+// Get the rejection-free KMC rate catalog of the dynamic model
+static inline KmcRateCatalog_t* getKmcRateCatalog(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->RateCatalog;
+}
+
+// Get the sector system of the sublattice parallel KMC/MMC mode of the dynamic model
+static inline KmcSublatticeSystem_t* getKmcSublatticeSystem(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->SublatticeSystem;
+}
+
+// Get the replica system of the replica exchange MMC mode
+static inline MmcReplicaSystem_t* getMmcReplicaSystem(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->ReplicaSystem;
+}
+
 
 /* Simulation model getter/setter */
 
@@ -110,6 +128,33 @@ static inline Flp64Buffer_t* getLatticeEnergyBuffer(SCONTEXT_PARAMETER)
     return &getDynamicModel(simContext)->LatticeEnergyBuffer;
 }
 
+// Get the block averaging system of the statistical precision abort from the context
+static inline PrecisionAbortSystem_t* getPrecisionAbortSystem(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->PrecisionAbortSystem;
+}
+
+// Get the quantile normalization system of the KMC mode from the context
+static inline KmcNormalizationSystem_t* getKmcNormalizationSystem(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->NormalizationSystem;
+}
+
+// Get the energy envelope system of the KMC early rejection from the context
+static inline KmcEnvelopeSystem_t* getKmcEnvelopeSystem(SCONTEXT_PARAMETER)
+{
+    return &getDynamicModel(simContext)->EnvelopeSystem;
+}
+
+// Get the energy envelope of the jump rule at the specified [jumpCollectionId, jumpRuleId]
+static inline JumpEnergyEnvelope_t* getJumpEnergyEnvelopeAt(SCONTEXT_PARAMETER, const int32_t jumpCollectionId, const int32_t jumpRuleId)
+{
+    let envelopeSystem = getKmcEnvelopeSystem(simContext);
+    let envelopeId = span_Get(envelopeSystem->RuleOffsets, jumpCollectionId) + jumpRuleId;
+    debug_assert(!span_IsIndexOutOfRange(envelopeSystem->Envelopes, envelopeId));
+    return &span_Get(envelopeSystem->Envelopes, envelopeId);
+}
+
 // Get the simulation runtime information from the context
 static inline SimulationRunInfo_t* getRuntimeInformation(SCONTEXT_PARAMETER)
 {
@@ -727,6 +772,45 @@ static inline DirectionPool_t* getDirectionPoolByJumpCount(SCONTEXT_PARAMETER, c
     return getDirectionPoolAt(simContext, getDirectionPoolIdByJumpCount(simContext, jumpCount));
 }
 
+// Get the jump slot masks of the selection pool
+static inline JumpSlotMasks_t* getJumpSlotMasks(SCONTEXT_PARAMETER)
+{
+    return &getJumpSelectionPool(simContext)->JumpSlotMasks;
+}
+
+// Get the jump slot mask of the environment at the specified [environmentId]
+static inline uint64_t* getJumpSlotMaskAt(SCONTEXT_PARAMETER, const int32_t environmentId)
+{
+    debug_assert(!span_IsIndexOutOfRange(*getJumpSlotMasks(simContext), environmentId));
+    return &span_Get(*getJumpSlotMasks(simContext), environmentId);
+}
+
+// Get the flat jump slot table of the selection pool
+static inline JumpSlotTable_t* getJumpSlotTable(SCONTEXT_PARAMETER)
+{
+    return &getJumpSelectionPool(simContext)->JumpSlotTable;
+}
+
+// Get the jump slot at the specified [slotId] of the flat jump slot table
+static inline JumpSlot_t* getJumpSlotAt(SCONTEXT_PARAMETER, const int32_t slotId)
+{
+    debug_assert(!span_IsIndexOutOfRange(*getJumpSlotTable(simContext), slotId));
+    return &span_Get(*getJumpSlotTable(simContext), slotId);
+}
+
+// Get the partner selection system of the MMC selection masks
+static inline MmcPartnerSystem_t* getMmcPartnerSystem(SCONTEXT_PARAMETER)
+{
+    return &getJumpSelectionPool(simContext)->PartnerSystem;
+}
+
+// Get the MMC particle pool at the specified [particlePoolId]
+static inline MmcPartnerPool_t* getMmcParticlePoolAt(SCONTEXT_PARAMETER, const int32_t particlePoolId)
+{
+    debug_assert(!span_IsIndexOutOfRange(getMmcPartnerSystem(simContext)->ParticlePools, particlePoolId));
+    return &span_Get(getMmcPartnerSystem(simContext)->ParticlePools, particlePoolId);
+}
+
 /* Command arguments getter/setter */
 
 // Get the command arguments passed to the simulation context
@@ -759,12 +843,55 @@ static inline void setExtensionLookupPath(SCONTEXT_PARAMETER, char const * value
     getFileInformation(simContext)->ExtensionLookupPath = value;
 }
 
+// Get the path to the warm start state file from the simulation context (NULL if no warm start is requested)
+static inline const char* getWarmStartStateFile(SCONTEXT_PARAMETER)
+{
+    return getFileInformation(simContext)->WarmStartStateFile;
+}
+
+// Set the path to the warm start state file that provides the start lattice on the simulation context
+static inline void setWarmStartStateFile(SCONTEXT_PARAMETER, char const * value)
+{
+    getFileInformation(simContext)->WarmStartStateFile = value;
+}
+
+// Set the path to the warm start state file that provides the start lattice and the KMC pre-run normalization on the simulation context
+static inline void setWarmStartNormalizationStateFile(SCONTEXT_PARAMETER, char const * value)
+{
+    setWarmStartStateFile(simContext, value);
+    simContext->IsWarmStartNormalizationActive = true;
+}
+
 // Set the database load string in the simulation context
 static inline void setDatabaseLoadString(SCONTEXT_PARAMETER, char const * value)
 {
     getFileInformation(simContext)->JobDbQuery = value;
 }
 
+// Set the job id range string of the batch mode in the simulation context
+static inline void setDatabaseBatchLoadString(SCONTEXT_PARAMETER, char const * value)
+{
+    getFileInformation(simContext)->JobBatchQuery = value;
+}
+
+// Checks if the batch mode that simulates multiple jobs in one process is requested on the simulation context
+static inline bool_t isJobBatchModeRequested(SCONTEXT_PARAMETER)
+{
+    return getFileInformation(simContext)->JobBatchQuery != NULL;
+}
+
+// Set the job queue database path of the worker mode in the simulation context
+static inline void setJobQueuePath(SCONTEXT_PARAMETER, char const * value)
+{
+    getFileInformation(simContext)->JobQueuePath = value;
+}
+
+// Checks if the worker mode that claims jobs from a shared job queue database is requested on the simulation context
+static inline bool_t isJobQueueModeRequested(SCONTEXT_PARAMETER)
+{
+    return getFileInformation(simContext)->JobQueuePath != NULL;
+}
+
 // Set the database path on the simulation context
 static inline void setDatabasePath(SCONTEXT_PARAMETER, char const * value)
 {
@@ -842,6 +969,247 @@ static inline void setUpperJumpHistogramLimitByString(SCONTEXT_PARAMETER, const
     setUpperJumpHistogramLimit(simContext, flpValue);
 }
 
+// Get the number of worker threads for the sublattice parallel KMC mode (Values below two use the serial routine)
+static inline int32_t getKmcThreadCount(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->KmcThreadCount;
+}
+
+// Set the number of worker threads for the sublattice parallel KMC mode using a string representation
+static inline void setKmcThreadCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t threadCount;
+    assert_true(sscanf(value, "%i", &threadCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the KMC thread count string.");
+    assert_true(threadCount > 0, ERR_DATACONSISTENCY, "The KMC thread count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->KmcThreadCount = threadCount;
+}
+
+// Get the number of worker threads for the sublattice parallel MMC mode (Values below two use the serial routine)
+static inline int32_t getMmcThreadCount(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->MmcThreadCount;
+}
+
+// Set the number of worker threads for the sublattice parallel MMC mode using a string representation
+static inline void setMmcThreadCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t threadCount;
+    assert_true(sscanf(value, "%i", &threadCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the MMC thread count string.");
+    assert_true(threadCount > 0, ERR_DATACONSISTENCY, "The MMC thread count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->MmcThreadCount = threadCount;
+}
+
+// Get the number of temperature replicas of the replica exchange MMC mode (Values below two use the single chain routine)
+static inline int32_t getMmcReplicaCount(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->MmcReplicaCount;
+}
+
+// Set the number of temperature replicas of the replica exchange MMC mode using a string representation
+static inline void setMmcReplicaCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t replicaCount;
+    assert_true(sscanf(value, "%i", &replicaCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the MMC replica count string.");
+    assert_true(replicaCount > 0, ERR_DATACONSISTENCY, "The MMC replica count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->MmcReplicaCount = replicaCount;
+}
+
+// Get the temperature of the hottest replica of the replica exchange MMC mode in [K] (Zero if the default ladder is used)
+static inline double getMmcReplicaMaxTemperature(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->MmcReplicaMaxTemperature;
+}
+
+// Set the temperature of the hottest replica of the replica exchange MMC mode using a string representation
+static inline void setMmcReplicaMaxTemperatureByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the MMC replica temperature string.");
+    assert_true(flpValue > 0.0, ERR_DATACONSISTENCY, "The MMC replica temperature cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->MmcReplicaMaxTemperature = flpValue;
+}
+
+// Get the number of annealing pre-run steps per mobile particle of the MMC mode (Zero disables the pre-run unless the job requests it)
+static inline int32_t getMmcPreRunMcsp(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->MmcPreRunMcsp;
+}
+
+// Set the number of annealing pre-run steps per mobile particle of the MMC mode using a string representation
+static inline void setMmcPreRunMcspByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t mcsp;
+    assert_true(sscanf(value, "%i", &mcsp) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the MMC pre-run mcsp string.");
+    assert_true(mcsp > 0, ERR_DATACONSISTENCY, "The MMC pre-run mcsp cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->MmcPreRunMcsp = mcsp;
+}
+
+// Get the number of worker threads an extension routine may use (Values below two request serial execution)
+static inline int32_t getExtensionThreadCount(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->ExtensionThreadCount;
+}
+
+// Set the number of worker threads an extension routine may use using a string representation
+static inline void setExtensionThreadCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t threadCount;
+    assert_true(sscanf(value, "%i", &threadCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the extension thread count string.");
+    assert_true(threadCount > 0, ERR_DATACONSISTENCY, "The extension thread count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->ExtensionThreadCount = threadCount;
+}
+
+// Get the relative energy fluctuation tolerance of the exchange equilibration before the KMC routine (Zero disables the equilibration)
+static inline double getKmcEquilibrationTolerance(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->KmcEquilibrationTolerance;
+}
+
+// Set the relative energy fluctuation tolerance of the exchange equilibration before the KMC routine using a string representation
+static inline void setKmcEquilibrationToleranceByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the KMC equilibration tolerance string.");
+    assert_true(flpValue > 0.0, ERR_DATACONSISTENCY, "The KMC equilibration tolerance cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->KmcEquilibrationTolerance = flpValue;
+}
+
+// Get the target relative standard error of the statistical precision abort (Zero disables the precision abort)
+static inline double getPrecisionAbortTarget(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->PrecisionAbortTarget;
+}
+
+// Set the target relative standard error of the statistical precision abort using a string representation
+static inline void setPrecisionAbortTargetByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the precision abort target string.");
+    assert_true(flpValue > 0.0, ERR_DATACONSISTENCY, "The precision abort target cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->PrecisionAbortTarget = flpValue;
+}
+
+// Get the target absolute standard error of the statistical precision abort (Zero disables the absolute criterion)
+static inline double getPrecisionAbortAbsolute(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->PrecisionAbortAbsolute;
+}
+
+// Set the target absolute standard error of the statistical precision abort using a string representation
+static inline void setPrecisionAbortAbsoluteByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the absolute precision abort target string.");
+    assert_true(flpValue > 0.0, ERR_DATACONSISTENCY, "The absolute precision abort target cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->PrecisionAbortAbsolute = flpValue;
+}
+
+// Checks if any target of the statistical precision abort is defined
+static inline bool_t IsPrecisionAbortActive(SCONTEXT_PARAMETER)
+{
+    return getPrecisionAbortTarget(simContext) > 0.0 || getPrecisionAbortAbsolute(simContext) > 0.0;
+}
+
+// Set the comma separated temperature list of the parameter sweep mode on the simulation context
+static inline void setSweepTemperatures(SCONTEXT_PARAMETER, char const * value)
+{
+    getCommandArgumentOverwrites(simContext)->SweepTemperatures = value;
+}
+
+// Set the comma separated electric field modulus list of the parameter sweep mode on the simulation context
+static inline void setSweepFieldModuli(SCONTEXT_PARAMETER, char const * value)
+{
+    getCommandArgumentOverwrites(simContext)->SweepFieldModuli = value;
+}
+
+// Check if the parameter sweep mode is requested on the simulation context
+static inline bool_t isParameterSweepModeRequested(SCONTEXT_PARAMETER)
+{
+    let overwrites = getCommandArgumentOverwrites(simContext);
+    return (overwrites->SweepTemperatures != NULL) || (overwrites->SweepFieldModuli != NULL);
+}
+
+// Get the number of worker threads of the direct enumeration KMC normalization
+static inline int32_t getKmcDirectNormThreadCount(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->KmcDirectNormThreadCount;
+}
+
+// Set the number of worker threads of the direct enumeration KMC normalization using a string representation
+static inline void setKmcDirectNormThreadCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t threadCount;
+    assert_true(sscanf(value, "%i", &threadCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the direct normalization thread count string.");
+    assert_true(threadCount > 0, ERR_DATACONSISTENCY, "The direct normalization thread count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->KmcDirectNormThreadCount = threadCount;
+}
+
+// Get the lower limit of the relative selection weight of the grouped KMC normalization (Zero uses the global normalization)
+static inline double getKmcGroupNormWeightLimit(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->KmcGroupNormWeightLimit;
+}
+
+// Set the lower limit of the relative selection weight of the grouped KMC normalization using a string representation
+static inline void setKmcGroupNormWeightLimitByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the KMC group normalization weight limit string.");
+    assert_true(flpValue > 0.0 && flpValue <= 1.0, ERR_DATACONSISTENCY, "The KMC group normalization weight limit has to be in the range (0,1].");
+    getCommandArgumentOverwrites(simContext)->KmcGroupNormWeightLimit = flpValue;
+}
+
+// Get the probability quantile of the jump attempts that defines the KMC normalization (Zero normalizes to the largest probability)
+static inline double getKmcNormalizationQuantile(SCONTEXT_PARAMETER)
+{
+    return getCommandArgumentOverwrites(simContext)->KmcNormalizationQuantile;
+}
+
+// Set the probability quantile of the jump attempts that defines the KMC normalization using a string representation
+static inline void setKmcNormalizationQuantileByString(SCONTEXT_PARAMETER, const char* value)
+{
+    var flpValue = strtod(value, NULL);
+    assert_true(errno != ERANGE, ERR_DATACONSISTENCY, "Conversion error on parsing the KMC normalization quantile string.");
+    assert_true(flpValue > 0.0 && flpValue < 1.0, ERR_DATACONSISTENCY, "The KMC normalization quantile has to be in the range (0,1).");
+    getCommandArgumentOverwrites(simContext)->KmcNormalizationQuantile = flpValue;
+}
+
+// Get the number of independent walkers of the KMC ensemble mode (Values below one are treated as one)
+static inline int32_t getEnsembleCount(SCONTEXT_PARAMETER)
+{
+    return getMaxOfTwo(1, getCommandArgumentOverwrites(simContext)->EnsembleCount);
+}
+
+// Set the number of independent walkers of the KMC ensemble mode using a string representation
+static inline void setEnsembleCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t ensembleCount;
+    assert_true(sscanf(value, "%i", &ensembleCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the ensemble count string.");
+    assert_true(ensembleCount > 0, ERR_DATACONSISTENCY, "The ensemble count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->EnsembleCount = ensembleCount;
+}
+
+// Check if the KMC ensemble mode is requested on the simulation context
+static inline bool_t isEnsembleModeRequested(SCONTEXT_PARAMETER)
+{
+    return getEnsembleCount(simContext) > 1;
+}
+
+// Get the number of concurrently simulated jobs of the batch mode (Values below one are treated as one)
+static inline int32_t getBatchThreadCount(SCONTEXT_PARAMETER)
+{
+    return getMaxOfTwo(1, getCommandArgumentOverwrites(simContext)->BatchThreadCount);
+}
+
+// Set the number of concurrently simulated jobs of the batch mode using a string representation
+static inline void setBatchThreadCountByString(SCONTEXT_PARAMETER, const char* value)
+{
+    int32_t threadCount;
+    assert_true(sscanf(value, "%i", &threadCount) == 1, ERR_DATACONSISTENCY, "Conversion error on parsing the batch thread count string.");
+    assert_true(threadCount > 0, ERR_DATACONSISTENCY, "The batch thread count cannot be set to negative or zero values.");
+    getCommandArgumentOverwrites(simContext)->BatchThreadCount = threadCount;
+}
+
 
 
 /* Selection pool getter/setter */
@@ -40,6 +40,10 @@
 #define INFO_FLG_DUALDOF            (1ULL << 4U)   // Flag that marks a job as non-optimized with twice the actually existing degrees of freedom
 #define INFO_FLG_NOJUMPLOGGING      (1ULL << 5U)   // Flag that marks a job as non histogram creating where the histograms will not be populated during simulation
 #define INFO_FLG_USEFASTEXP         (1ULL << 6U)   // Flag that marks a job for fast exponential approximation usage
+#define INFO_FLG_REJECTIONFREE      (1ULL << 7U)   // Flag that marks a KMC job to use the rejection-free (n-fold way) event selection
+#define INFO_FLG_SELECTIONMASKS     (1ULL << 8U)   // Flag that marks a job to select only jumps with a jump rule for the current path occupation (KMC) or a valid exchange partner (MMC)
+#define INFO_FLG_FLATSLOTTABLE      (1ULL << 9U)   // Flag that marks a job to select jumps from a flat jump slot table with a single bounded random number
+#define INFO_FLG_EARLYREJECTION     (1ULL << 10U)  // Flag that marks a KMC job to reject jumps by the energy envelopes of the rules before the final state calculation
 
 /* Main state flag values */
 
@@ -55,12 +59,14 @@
 #define STATE_FLG_SIMERROR      (1ULL << 9U)
 #define STATE_FLG_PRERUN_RESET  (1ULL << 10U)
 #define STATE_FLG_ENERGYABORT   (1ULL << 11U)
+#define STATE_FLG_PRECISIONABORT (1ULL << 12U)
 
 /* Monte Carlo constants */
 
 #define MC_CONST_FLP_TOLERANCE 1.0e-10
 #define MC_CONST_JUMPLIMIT_MIN 0.0e+00
 #define MC_CONST_JUMPLIMIT_MAX 1.0e+00
+#define MC_CONST_ENVELOPE_TOLERANCE 1.0e-09
 #define MC_CONST_BACKJUMP_NULL 0.0
 #define MC_CONST_BACKJUMP_INF  INFINITY
 
@@ -82,6 +88,42 @@
 #define CYCLE_BLOCKSIZE_MAX 10000000
 #define CYCLE_BLOCKSIZE_MUL 100
 
+/* Sublattice parallel KMC constants */
+
+#define SUBLATTICE_SECTORCOUNT_MIN      4
+#define SUBLATTICE_PHASE_SLOTDIVISOR    10LL
+
+// Sector distance to the owned sectors of a rank up to which the environments are kept current (Halo) or keep their energy buffers as link update targets (Fringe)
+#define SUBLATTICE_RANK_HALODISTANCE    1
+#define SUBLATTICE_RANK_FRINGEDISTANCE  2
+
+/* Replica exchange MMC constants */
+
+#define REPLICA_MAXTEMPERATURE_FACTOR   2.0
+#define REPLICA_EXCHANGE_SWEEPCOUNT     1LL
+
+/* MMC pre-run constants */
+
+#define MMC_PRERUN_TEMPERATURE_FACTOR   4.0
+
+/* KMC exchange equilibration constants */
+
+#define KMC_EQUILIBRATION_SWEEPLIMIT    10000LL
+#define KMC_EQUILIBRATION_SEQUENCELENGTH 10
+
+/* KMC quantile normalization constants */
+
+#define KMC_NORMQUANTILE_SUBBINCOUNT    8
+#define KMC_NORMQUANTILE_EXPONENTMIN    (-1080)
+#define KMC_NORMQUANTILE_BINCOUNT       (KMC_NORMQUANTILE_SUBBINCOUNT * (2 - KMC_NORMQUANTILE_EXPONENTMIN))
+#define KMC_NORMQUANTILE_SAMPLEMIN      10000LL
+#define KMC_NORMQUANTILE_CHANGELIMIT    0.05
+
+/* Statistical precision abort constants */
+
+#define PRECISION_BLOCKCOUNT_MIN        16
+#define PRECISION_BINNINGCOUNT_MIN      8
+
 /* Jump constants */
 
 #define JUMPS_JUMPLENGTH_MIN 2
@@ -94,6 +136,7 @@
 #define JPOOL_DIRCOUNT_STATIC   -1
 #define JPOOL_DIRCOUNT_PASSIVE   0
 #define JPOOL_NOT_SELECTABLE    -1
+#define JPOOL_SLOTMASK_BITCOUNT 64
 
 /* Cluster and energy defines */
 #define CLUSTER_MAXLINK_COUNT           256
@@ -116,6 +159,7 @@
 #define FILE_PRERSTATE   "prerun.mcs"
 #define FILE_STDOUTLOG   "stdout.log"
 #define FILE_STDERRLOG   "stderr.log"
+#define FILE_ENSEMBLELOG "ensemble.log"
 #define FMODE_BINARY_R   "rb"
 #define FMODE_BINARY_W   "wb"
 #define FMODE_NORMAL_R   "r"
@@ -56,3 +56,12 @@ error_t ValidateIsPositiveDoubleString(char const* value)
     if (errno == ERANGE || flpValue <= 0.0) return ERR_VALIDATION;
     return ERR_OK;
 }
+
+error_t ValidateIsPositiveIntegerString(char const* value)
+{
+    return_if (ValidateStringNotNullOrEmpty(value) != ERR_OK, ERR_VALIDATION);
+
+    int32_t intValue;
+    return_if (sscanf(value, "%i", &intValue) != 1, ERR_VALIDATION);
+    return (intValue > 0) ? ERR_OK : ERR_VALIDATION;
+}
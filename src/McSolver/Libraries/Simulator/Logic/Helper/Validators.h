@@ -34,4 +34,7 @@ error_t ValidateIsDiretoryPath(char const * value);
 error_t ValidateDatabaseQueryString(char const* value);
 
 // Validates that the provided string can be parsed to a finite and positive FLP64
-error_t ValidateIsPositiveDoubleString(char const* value);
\ No newline at end of file
+error_t ValidateIsPositiveDoubleString(char const* value);
+
+// Validates that the provided string can be parsed to a positive INT32
+error_t ValidateIsPositiveIntegerString(char const* value);
\ No newline at end of file
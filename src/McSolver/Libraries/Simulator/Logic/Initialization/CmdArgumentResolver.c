@@ -9,8 +9,10 @@
 //////////////////////////////////////////
 
 #include <string.h>
+#include <math.h>
 #include "CmdArgumentResolver.h"
 #include "Libraries/Simulator/Logic/Helper/Validators.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
 
 // Checks if the set of command arguments contains the build call flag and terminates the execution if true
 static void TerminateOnSetBuildCallFlag(SCONTEXT_PARAMETER)
@@ -43,6 +45,9 @@ static struct _iobuf* freopen_utf8(const char* filename, const char* mode, file_
 // Tries to redirect the stdout and stderr stream to file streams (stdout is selectable, stderr defaults to stderr.log)
 static void setStdoutRedirection(SCONTEXT_PARAMETER, const char* stdoutFile)
 {
+    // Note: The stdout of non-root ranks of the distributed mode is silenced and their errors stay on the console
+    return_if(!IsDistributedRootRank());
+
     var fileInfo = getFileInformation(simContext);
     char* tmp = NULL;
     char* tmp1 = NULL;
@@ -65,6 +70,66 @@ static void setStdoutRedirection(SCONTEXT_PARAMETER, const char* stdoutFile)
     free(tmp1);
 }
 
+int32_t ParseJobIdRangeString(char const* value, int32_t*restrict outIds)
+{
+    return_if(value == NULL, 0);
+    int32_t count = 0, firstId, lastId, charCount;
+
+    while (*value != '\0')
+    {
+        return_if(sscanf(value, "%d%n", &firstId, &charCount) != 1, 0);
+        value += charCount;
+        lastId = firstId;
+        if (*value == '-')
+        {
+            return_if(sscanf(++value, "%d%n", &lastId, &charCount) != 1, 0);
+            value += charCount;
+        }
+        return_if((firstId < 0) || (lastId < firstId), 0);
+        return_if((*value != '\0') && (*value++ != ','), 0);
+
+        for (int32_t id = firstId; id <= lastId; id++)
+        {
+            if (outIds != NULL) outIds[count] = id;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// Validates that the passed string is a valid job id range string of the batch mode
+static error_t ValidateJobIdRangeString(char const* value)
+{
+    return (ParseJobIdRangeString(value, NULL) > 0) ? ERR_OK : ERR_VALIDATION;
+}
+
+int32_t ParseSweepValueString(char const* value, double*restrict outValues)
+{
+    return_if(value == NULL, 0);
+    int32_t count = 0, charCount;
+    double parsedValue;
+
+    while (*value != '\0')
+    {
+        return_if(sscanf(value, "%lf%n", &parsedValue, &charCount) != 1, 0);
+        value += charCount;
+        return_if(!isfinite(parsedValue) || (parsedValue < 0.0), 0);
+        return_if((*value != '\0') && (*value++ != ','), 0);
+
+        if (outValues != NULL) outValues[count] = parsedValue;
+        count++;
+    }
+
+    return count;
+}
+
+// Validates that the passed string is a valid value list of the parameter sweep mode
+static error_t ValidateSweepValueString(char const* value)
+{
+    return (ParseSweepValueString(value, NULL) > 0) ? ERR_OK : ERR_VALIDATION;
+}
+
 // Get the collection of resolvers for essential cmd arguments
 static const CmdArgLookup_t* getEssentialCmdArgsResolverTable()
 {
@@ -72,6 +137,7 @@ static const CmdArgLookup_t* getEssentialCmdArgsResolverTable()
     {
         { "-dbPath",  (FValidator_t) ValidateIsValidFilePath,     (FCmdCallback_t) setDatabasePath },
         { "-jobId",   (FValidator_t) ValidateDatabaseQueryString, (FCmdCallback_t) setDatabaseLoadString },
+        { "-jobIds",  (FValidator_t) ValidateJobIdRangeString,    (FCmdCallback_t) setDatabaseBatchLoadString },
         { "-ioPath",  (FValidator_t) ValidateIsDiretoryPath,      (FCmdCallback_t) setIODirectoryPath},
     };
 
@@ -95,7 +161,26 @@ static const CmdArgLookup_t* getOptionalCmdArgsResolverTable()
         { "-engPluginSymbol", (FValidator_t)  ValidateStringNotNullOrEmpty,     (FCmdCallback_t) setEnergyPluginSymbol },
         { "-stdout",          (FValidator_t)  ValidateStringNotNullOrEmpty,     (FCmdCallback_t) setStdoutRedirection},
         { "-extDir",          (FValidator_t)  ValidateIsDiretoryPath,           (FCmdCallback_t) setExtensionLookupPath},
-        { "-jumpLogMaxEv",    (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setUpperJumpHistogramLimitByString}
+        { "-jumpLogMaxEv",    (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setUpperJumpHistogramLimitByString},
+        { "-kmcThreads",      (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setKmcThreadCountByString},
+        { "-threads",         (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setBatchThreadCountByString},
+        { "-worker",          (FValidator_t)  ValidateStringNotNullOrEmpty,     (FCmdCallback_t) setJobQueuePath},
+        { "-mmcReplicas",     (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setMmcReplicaCountByString},
+        { "-mmcReplicaMaxT",  (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setMmcReplicaMaxTemperatureByString},
+        { "-mmcThreads",      (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setMmcThreadCountByString},
+        { "-mmcPreRunMcsp",   (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setMmcPreRunMcspByString},
+        { "-kmcEquilibrate",  (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setKmcEquilibrationToleranceByString},
+        { "-extThreads",      (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setExtensionThreadCountByString},
+        { "-precisionTarget", (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setPrecisionAbortTargetByString},
+        { "-precisionAbs",    (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setPrecisionAbortAbsoluteByString},
+        { "-warmStart",       (FValidator_t)  ValidateIsValidFilePath,          (FCmdCallback_t) setWarmStartStateFile},
+        { "-warmStartNorm",   (FValidator_t)  ValidateIsValidFilePath,          (FCmdCallback_t) setWarmStartNormalizationStateFile},
+        { "-sweepTemps",      (FValidator_t)  ValidateSweepValueString,         (FCmdCallback_t) setSweepTemperatures},
+        { "-sweepFields",     (FValidator_t)  ValidateSweepValueString,         (FCmdCallback_t) setSweepFieldModuli},
+        { "-ensemble",        (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setEnsembleCountByString},
+        { "-kmcDirectNorm",   (FValidator_t)  ValidateIsPositiveIntegerString,  (FCmdCallback_t) setKmcDirectNormThreadCountByString},
+        { "-kmcGroupNorm",    (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setKmcGroupNormWeightLimitByString},
+        { "-kmcNormQuantile", (FValidator_t)  ValidateIsPositiveDoubleString,   (FCmdCallback_t) setKmcNormalizationQuantileByString}
     };
 
     static const CmdArgLookup_t resolverTable =
@@ -144,24 +229,38 @@ static error_t ResolveAndSetEssentialCmdArguments(SCONTEXT_PARAMETER)
 {
     error_t error;
     let resolverTable = getEssentialCmdArgsResolverTable();
-    var unresolved = span_Length(*resolverTable);
     var cmdArguments = getCommandArguments(simContext);
     TerminateOnSetBuildCallFlag(simContext);
 
+    // Note: The -jobId and -jobIds arguments are mutually exclusive alternatives of the required job selection
+    bool_t isDbPathSet = false, isJobIdSet = false, isJobIdsSet = false, isIoPathSet = false;
     for (int32_t i = 1; i < cmdArguments->Count; i++)
     {
         error = LookupAndResolveCmdArgument(simContext, resolverTable, i);
         if (error == ERR_VALIDATION) PrintValidationFailureToStdout(simContext, i);
-        if (error == ERR_OK)
-        {
-            --unresolved;
-        }
+        continue_if(error != ERR_OK);
 
-        return_if(unresolved == 0, ERR_OK);
+        let keyArgument = getCommandArgumentStringAt(simContext, i);
+        isDbPathSet |= strcmp(keyArgument, "-dbPath") == 0;
+        isJobIdSet |= strcmp(keyArgument, "-jobId") == 0;
+        isJobIdsSet |= strcmp(keyArgument, "-jobIds") == 0;
+        isIoPathSet |= strcmp(keyArgument, "-ioPath") == 0;
+    }
+
+    if (isJobIdSet && isJobIdsSet)
+    {
+        printf("[FAILURE]: The command line arguments -jobId and -jobIds cannot be combined.\n");
+        fflush(stdout);
+        return ERR_CMDARGUMENT;
     }
+    return_if(isDbPathSet && (isJobIdSet || isJobIdsSet) && isIoPathSet, ERR_OK);
+
     printf("[FAILURE]: Missing input. Make sure all required command line arguments are defined:\n");
     cpp_foreach(item, *resolverTable)
-        printf("[REQUIRED]: %s\t<value>\n", item->KeyArgument);
+    {
+        continue_if(strcmp(item->KeyArgument, "-jobIds") == 0);
+        printf("[REQUIRED]: %s\t<value>%s\n", item->KeyArgument, (strcmp(item->KeyArgument, "-jobId") == 0) ? "\t(or -jobIds <range>)" : "");
+    }
     fflush(stdout);
     return ERR_CMDARGUMENT;
 }
@@ -217,4 +316,97 @@ void ResolveMocassinCommandLineArguments(SCONTEXT_PARAMETER, int32_t argCount, c
 
     error = BuildAndSetFileTargets(simContext);
     assert_success(error, "Failed to build required file targets.");
+}
+
+error_t ResolveMocassinBatchJobArguments(SCONTEXT_PARAMETER, const SimulationContext_t*restrict batchContext, const int32_t jobId)
+{
+    error_t error;
+    var fileInfo = getFileInformation(simContext);
+    let batchFileInfo = &batchContext->DynamicModel.FileInfo;
+
+    setCommandArguments(simContext, batchContext->CommandArguments.Count, batchContext->CommandArguments.Values);
+    *getCommandArgumentOverwrites(simContext) = batchContext->CmdOverwrites;
+    simContext->IsWarmStartNormalizationActive = batchContext->IsWarmStartNormalizationActive;
+    *fileInfo = *batchFileInfo;
+    fileInfo->JobBatchQuery = NULL;
+    fileInfo->JobQueuePath = NULL;
+
+    char* jobQuery = malloc(CMD_JOBQUERY_BYTECOUNT);
+    char* ioPath = malloc(strlen(batchFileInfo->IODirectoryPath) + CMD_JOBQUERY_BYTECOUNT + sizeof(CMD_BATCH_JOBFOLDER_FORMAT));
+    return_if(jobQuery == NULL || ioPath == NULL, ERR_MEMALLOCATION);
+
+    sprintf(jobQuery, "%i", jobId);
+    sprintf(ioPath, CMD_BATCH_JOBFOLDER_FORMAT, batchFileInfo->IODirectoryPath, jobId);
+    fileInfo->JobDbQuery = jobQuery;
+    fileInfo->IODirectoryPath = ioPath;
+
+    error = utf8mkdir(ioPath);
+    return_if(error, error);
+
+    return BuildAndSetFileTargets(simContext);
+}
+
+// Sets the I/O directory with the passed folder format and id below the passed base I/O directory, creates it, and rebuilds the state file targets
+static error_t ResolveMocassinSubFolderArguments(SCONTEXT_PARAMETER, char const* baseIoPath, char const* folderFormat, const int32_t folderId)
+{
+    error_t error;
+    var fileInfo = getFileInformation(simContext);
+
+    char* ioPath = malloc(strlen(baseIoPath) + strlen(folderFormat) + CMD_JOBQUERY_BYTECOUNT);
+    return_if(ioPath == NULL, ERR_MEMALLOCATION);
+    sprintf(ioPath, folderFormat, baseIoPath, folderId);
+
+    error = utf8mkdir(ioPath);
+    return_if(error, (free(ioPath), error));
+
+    // Note: The base I/O directory is owned by the command arguments, only the paths of previous sub folders are freed
+    if (fileInfo->IODirectoryPath != baseIoPath) free((void*) fileInfo->IODirectoryPath);
+    free((void*) fileInfo->MainStateFile);
+    free((void*) fileInfo->PrerunStateFile);
+    fileInfo->IODirectoryPath = ioPath;
+
+    return BuildAndSetFileTargets(simContext);
+}
+
+error_t ResolveMocassinSweepPointArguments(SCONTEXT_PARAMETER, char const* baseIoPath, const int32_t pointId)
+{
+    return ResolveMocassinSubFolderArguments(simContext, baseIoPath, CMD_SWEEP_POINTFOLDER_FORMAT, pointId);
+}
+
+error_t ResolveMocassinEnsembleMemberArguments(SCONTEXT_PARAMETER, const SimulationContext_t* ownerContext, char const* baseIoPath, const int32_t memberId)
+{
+    if (ownerContext != NULL)
+    {
+        var fileInfo = getFileInformation(simContext);
+        setCommandArguments(simContext, ownerContext->CommandArguments.Count, ownerContext->CommandArguments.Values);
+        *getCommandArgumentOverwrites(simContext) = ownerContext->CmdOverwrites;
+        simContext->IsWarmStartNormalizationActive = ownerContext->IsWarmStartNormalizationActive;
+
+        // Note: The member shares all strings of the owner except the I/O directory and the state file targets
+        *fileInfo = ownerContext->DynamicModel.FileInfo;
+        fileInfo->IODirectoryPath = baseIoPath;
+        fileInfo->MainStateFile = NULL;
+        fileInfo->PrerunStateFile = NULL;
+    }
+
+    return ResolveMocassinSubFolderArguments(simContext, baseIoPath, CMD_ENSEMBLE_MEMBERFOLDER_FORMAT, memberId);
+}
+
+void DeleteMocassinEnsembleMemberArguments(SCONTEXT_PARAMETER)
+{
+    var fileInfo = getFileInformation(simContext);
+    free((void*) fileInfo->IODirectoryPath);
+    free((void*) fileInfo->MainStateFile);
+    free((void*) fileInfo->PrerunStateFile);
+    memset(fileInfo, 0, sizeof(FileInfo_t));
+}
+
+void DeleteMocassinBatchJobArguments(SCONTEXT_PARAMETER)
+{
+    var fileInfo = getFileInformation(simContext);
+    free((void*) fileInfo->JobDbQuery);
+    free((void*) fileInfo->IODirectoryPath);
+    free((void*) fileInfo->MainStateFile);
+    free((void*) fileInfo->PrerunStateFile);
+    memset(fileInfo, 0, sizeof(FileInfo_t));
 }
\ No newline at end of file
@@ -13,5 +13,39 @@
 #include "Libraries/Framework/Errors/McErrors.h"
 #include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
 
+// Defines the number of bytes reserved for the job id query string of a batch job
+#define CMD_JOBQUERY_BYTECOUNT 16
+
+// Defines the format of the I/O directory of a batch job relative to the set I/O directory (Matches the job folders of the python job runner)
+#define CMD_BATCH_JOBFOLDER_FORMAT "%s/Job%05i"
+
+// Defines the format of the I/O directory of a parameter sweep point relative to the set I/O directory
+#define CMD_SWEEP_POINTFOLDER_FORMAT "%s/Sweep%03i"
+
+// Defines the format of the I/O directory of an ensemble member relative to the set I/O directory
+#define CMD_ENSEMBLE_MEMBERFOLDER_FORMAT "%s/Ensemble%03i"
+
 // Resolves all passed command line arguments and sets the affiliated context information
-void ResolveMocassinCommandLineArguments(SCONTEXT_PARAMETER, int32_t argCount, char const * const * argValues);
\ No newline at end of file
+void ResolveMocassinCommandLineArguments(SCONTEXT_PARAMETER, int32_t argCount, char const * const * argValues);
+
+// Parses a job id range string of the batch mode (e.g. '1-500' or '1,4,10-20') and writes the ids to the passed buffer if it is not NULL. Returns the number of ids or zero if the string is invalid
+int32_t ParseJobIdRangeString(char const* value, int32_t*restrict outIds);
+
+// Parses a comma separated value list of the parameter sweep mode (e.g. '300,400,500') and writes the values to the passed buffer if it is not NULL. Returns the number of values or zero if the string is invalid
+int32_t ParseSweepValueString(char const* value, double*restrict outValues);
+
+// Sets the I/O directory of the sweep point with the passed id below the passed base I/O directory, creates it, and rebuilds the state file targets
+error_t ResolveMocassinSweepPointArguments(SCONTEXT_PARAMETER, char const* baseIoPath, int32_t pointId);
+
+// Sets the resolved arguments of the passed owner context on the passed member context and sets the I/O directory of the ensemble member with the passed id
+// below the passed base I/O directory (Passing NULL as owner only sets the I/O directory, member directories are created if required)
+error_t ResolveMocassinEnsembleMemberArguments(SCONTEXT_PARAMETER, const SimulationContext_t* ownerContext, char const* baseIoPath, int32_t memberId);
+
+// Frees the member specific file information strings that have been created by the ensemble member argument resolving
+void DeleteMocassinEnsembleMemberArguments(SCONTEXT_PARAMETER);
+
+// Sets the resolved arguments of the passed batch context on the passed job context and creates the I/O directory of the job with the passed id
+error_t ResolveMocassinBatchJobArguments(SCONTEXT_PARAMETER, const SimulationContext_t*restrict batchContext, int32_t jobId);
+
+// Frees the job specific file information strings that have been created by the batch job argument resolving
+void DeleteMocassinBatchJobArguments(SCONTEXT_PARAMETER);
\ No newline at end of file
@@ -245,3 +245,126 @@ void BuildJumpStatusCollection(SCONTEXT_PARAMETER)
     error = AssignPossibleStaticCorrectionValuesToRules(simContext);
     assert_success(error, "Fatal error during attempt to determine KMC bias corrections.");
 }
+
+// Get the range of the passed cluster energy table as the maximal possible cluster delta in [kT]
+static double GetClusterTableEnergyRange(const ClusterTable_t*restrict clusterTable)
+{
+    double min = INFINITY, max = -INFINITY;
+    cpp_foreach(energy, clusterTable->EnergyTable)
+    {
+        min = getMinOfTwo(min, *energy);
+        max = getMaxOfTwo(max, *energy);
+    }
+    return (min <= max) ? max - min : 0.0;
+}
+
+// Adds the bounds of the pair delta of the passed jump link to the passed envelope. The bounds cover all pair tables since the runtime table is selected by the sender environment
+static void AddJumpLinkPairDeltaToEnvelope(SCONTEXT_PARAMETER, JumpRule_t*restrict jumpRule, const JumpLink_t*restrict jumpLink, const int32_t receiverId, JumpEnergyEnvelope_t*restrict envelope)
+{
+    let updateParticleId = GetOccupationCodeByteAt(&jumpRule->StateCode2, receiverId);
+    let oldSenderParticle = GetOccupationCodeByteAt(&jumpRule->StateCode0, jumpLink->SenderPathId);
+    let newSenderParticle = GetOccupationCodeByteAt(&jumpRule->StateCode2, jumpLink->SenderPathId);
+    double min = INFINITY, max = -INFINITY;
+
+    cpp_foreach(pairTable, *getPairEnergyTables(simContext))
+    {
+        continue_if(array_IsIndexOutOfRange(pairTable->EnergyTable, updateParticleId, oldSenderParticle));
+        continue_if(array_IsIndexOutOfRange(pairTable->EnergyTable, updateParticleId, newSenderParticle));
+        let delta = getPairEnergyAt(pairTable, updateParticleId, newSenderParticle) - getPairEnergyAt(pairTable, updateParticleId, oldSenderParticle);
+        min = getMinOfTwo(min, delta);
+        max = getMaxOfTwo(max, delta);
+    }
+    return_if(min > max);
+    envelope->MinS2Correction += min;
+    envelope->MaxS2Correction += max;
+}
+
+// Tries to calculate the energy envelope of a dynamic jump rule from the pair and cluster deltas that its jump links can cause
+static error_t TryFindDynamicJumpEnergyEnvelope(SCONTEXT_PARAMETER, JumpCollection_t*restrict jumpCollection, JumpRule_t*restrict jumpRule, JumpEnergyEnvelope_t*restrict outEnvelope)
+{
+    // Note: Due to symmetry it is enough to check the first direction, the others have to be the same by definition
+    let jumpDirection = &span_Get(jumpCollection->JumpDirections, 0);
+    let jumpStatusVector = (Vector4_t) {.A = 0, .B = 0, .C = 0, .D = jumpDirection->ObjectId};
+    let jumpStatus = getJumpStatusByVector4(simContext, &jumpStatusVector);
+    var error = PrepareJumpPathForLinkSearch(simContext, &jumpStatusVector, jumpDirection);
+    return_if(error, error);
+    *outEnvelope = (JumpEnergyEnvelope_t) {.MinS2Correction = 0.0, .MaxS2Correction = 0.0};
+
+    cpp_foreach(jumpLink, jumpStatus->JumpLinks)
+    {
+        let environmentLink = getEnvLinkByJumpLink(simContext, jumpLink);
+        var receiverId = 0;
+        c_foreach(item, JUMPPATH)
+        {
+            if (getEnvironmentStateIdByPointer(simContext, *item) == environmentLink->TargetEnvironmentId) break;
+            ++receiverId;
+        }
+        return_if(receiverId >= JUMPS_JUMPLENGTH_MAX, ERR_DATACONSISTENCY);
+        AddJumpLinkPairDeltaToEnvelope(simContext, jumpRule, jumpLink, receiverId, outEnvelope);
+
+        let receiver = getEnvironmentStateAt(simContext, environmentLink->TargetEnvironmentId);
+        cpp_foreach(clusterLink, environmentLink->ClusterLinks)
+        {
+            let clusterDefinition = getEnvironmentClusterDefinitionAt(receiver, clusterLink->ClusterId);
+            let energyRange = GetClusterTableEnergyRange(getClusterEnergyTableAt(simContext, clusterDefinition->EnergyTableId));
+            outEnvelope->MinS2Correction -= energyRange;
+            outEnvelope->MaxS2Correction += energyRange;
+        }
+    }
+    return ERR_OK;
+}
+
+// Allocates the envelope system and calculates the energy envelopes of all jump rules
+static error_t ConstructKmcEnergyEnvelopes(SCONTEXT_PARAMETER)
+{
+    let jumpCollections = getJumpCollections(simContext);
+    var envelopeSystem = getKmcEnvelopeSystem(simContext);
+    var ruleCount = 0;
+    span_Delete(envelopeSystem->Envelopes);
+    span_Delete(envelopeSystem->RuleOffsets);
+    envelopeSystem->RuleOffsets = span_New(envelopeSystem->RuleOffsets, span_Length(*jumpCollections));
+    for (int32_t i = 0; i < span_Length(*jumpCollections); i++)
+    {
+        span_Get(envelopeSystem->RuleOffsets, i) = ruleCount;
+        ruleCount += (int32_t) span_Length(span_Get(*jumpCollections, i).JumpRules);
+    }
+
+    envelopeSystem->Envelopes = span_New(envelopeSystem->Envelopes, ruleCount);
+    var envelope = envelopeSystem->Envelopes.Begin;
+    cpp_foreach(jumpCollection, *jumpCollections)
+    {
+        cpp_foreach(jumpRule, jumpCollection->JumpRules)
+        {
+            if (isnan(jumpRule->StaticVirtualJumpEnergyCorrection))
+            {
+                let error = TryFindDynamicJumpEnergyEnvelope(simContext, jumpCollection, jumpRule, envelope);
+                return_if(error, error);
+            }
+            else
+            {
+                envelope->MinS2Correction = envelope->MaxS2Correction = jumpRule->StaticVirtualJumpEnergyCorrection;
+            }
+            envelope->MinS2Correction -= MC_CONST_ENVELOPE_TOLERANCE;
+            envelope->MaxS2Correction += MC_CONST_ENVELOPE_TOLERANCE;
+            ++envelope;
+        }
+    }
+    printf("[Init-Info]: KMC energy envelopes BUILD [RULE_COUNT=%i]\n", ruleCount);
+    return ERR_OK;
+}
+
+void BuildKmcEnergyEnvelopes(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsKmcEarlyRejectionActive);
+
+    // Note: A transition state plugin can use any S1 interpolation, the envelope bounds are only valid for the default method
+    if (getPluginCollection(simContext)->OnSetTransitionStateEnergy != NULL)
+    {
+        simContext->IsKmcEarlyRejectionActive = false;
+        printf("[Init-Info]: KMC early rejection SKIPPED => Not supported with a transition state energy plugin.\n");
+        return;
+    }
+
+    let error = ConstructKmcEnergyEnvelopes(simContext);
+    assert_success(error, "Fatal error during construction of the KMC energy envelopes.");
+}
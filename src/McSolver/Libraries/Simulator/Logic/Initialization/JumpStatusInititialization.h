@@ -14,4 +14,7 @@
 #include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
 
 // Builds the jump status collection on the passed initialized simulation context
-void BuildJumpStatusCollection(SCONTEXT_PARAMETER);
\ No newline at end of file
+void BuildJumpStatusCollection(SCONTEXT_PARAMETER);
+
+// Builds or rebuilds the per rule energy envelopes of the KMC early rejection on the passed context with a built jump status collection
+void BuildKmcEnergyEnvelopes(SCONTEXT_PARAMETER);
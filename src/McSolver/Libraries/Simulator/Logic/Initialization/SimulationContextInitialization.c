@@ -18,6 +18,12 @@
 #include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
 #include "Libraries/Simulator/Logic/Initialization/JumpStatusInititialization.h"
 #include "Libraries/Simulator/Logic/Routines/TransitionTrackingRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/RateCatalogRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/SublatticeKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/ReplicaExchangeRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/ExchangeEquilibrationRoutines.h"
+#include "Libraries/Simulator/Data/State/SimulationStateUtility.h"
 
 // Allocates the environment energy and cluster buffers with the required sizes
 static void AllocateEnvironmentBuffers(EnvironmentState_t *restrict env, EnvironmentDefinition_t *restrict envDef)
@@ -66,9 +72,31 @@ static void AllocateEnergyFluctuationAbortBuffer(Flp64Buffer_t *restrict bufferA
     };
 }
 
+// Allocates the block value list of the statistical precision abort if a precision target is defined
+static void AllocatePrecisionAbortSystem(SCONTEXT_PARAMETER)
+{
+    var precisionSystem = getPrecisionAbortSystem(simContext);
+    precisionSystem->LastObservableSum = NAN;
+    precisionSystem->RelativeError = INFINITY;
+    precisionSystem->AbsoluteError = INFINITY;
+    return_if(!IsPrecisionAbortActive(simContext));
+
+    // Note: The main run consists of at most CYCLE_BLOCKCOUNT blocks, further values are not recorded
+    precisionSystem->BlockValues = list_New(precisionSystem->BlockValues, CYCLE_BLOCKCOUNT);
+}
+
+// Allocates the probability counters of the quantile KMC normalization if the normalization is active
+static void AllocateKmcNormalizationSystem(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsQuantileKmcNormalizationActive);
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    normalizationSystem->ProbabilityCounters = span_New(normalizationSystem->ProbabilityCounters, KMC_NORMQUANTILE_BINCOUNT);
+}
+
 // Allocates the abort condition buffers if they are required
 static void AllocateAbortConditionBuffers(SCONTEXT_PARAMETER)
 {
+    AllocatePrecisionAbortSystem(simContext);
     return_if(!JobInfoFlagsAreSet(simContext, INFO_FLG_MMC));
 
     let jobInfo = getDbModelJobInfo(simContext);
@@ -82,23 +110,34 @@ static void ConstructSimulationModel(SCONTEXT_PARAMETER)
 {
     AllocateEnvironmentLattice(simContext);
     AllocateAbortConditionBuffers(simContext);
+    AllocateKmcNormalizationSystem(simContext);
 }
 
-// Constructs the selection pool index redirection that redirects jump counts to selection pool id
+// Constructs the selection pool index redirection that redirects jump counts (and particle ids if grouped) to selection pool id
 static error_t ConstructSelectionPoolIndexRedirection(SCONTEXT_PARAMETER)
 {
     let transitionModel = getDbTransitionModel(simContext);
-    let maxPoolCount = 1 + FindMaxJumpDirectionCount(&transitionModel->JumpCountMappingTable);
+    let jumpCountTable = &transitionModel->JumpCountMappingTable;
+    let maxPoolCount = 1 + FindMaxJumpDirectionCount(jumpCountTable);
     var poolMapping = getDirectionPoolMapping(simContext);
     var selectionPool = getJumpSelectionPool(simContext);
     int32_t poolIndex = 1;
 
-    *poolMapping = span_New(*poolMapping, maxPoolCount);
-    cpp_foreach(dirCount, transitionModel->JumpCountMappingTable)
+    // Note: The grouped normalization requires one pool per combination of particle id and jump count
+    selectionPool->ParticlePoolStride = simContext->IsGroupKmcNormalizationActive ? maxPoolCount : 0;
+    *poolMapping = span_New(*poolMapping, simContext->IsGroupKmcNormalizationActive ? maxPoolCount * PARTICLE_IDLIMIT : maxPoolCount);
+    cpp_foreach(dirCount, *jumpCountTable)
     {
-        if ((*dirCount > JPOOL_DIRCOUNT_PASSIVE) && (getDirectionPoolIdByJumpCount(simContext, *dirCount) == 0))
+        continue_if(*dirCount <= JPOOL_DIRCOUNT_PASSIVE);
+
+        // Note: With active selection masks an environment can have any number of masked jumps up to its jump count
+        let particleId = (int32_t) ((dirCount - jumpCountTable->Begin) % jumpCountTable->Header->Blocks[0]);
+        let minCount = simContext->IsKmcSelectionMaskActive ? JPOOL_DIRCOUNT_PASSIVE + 1 : *dirCount;
+        for (int32_t count = minCount; count <= *dirCount; count++)
         {
-            setDirectionPoolIdByJumpCount(simContext, *dirCount, poolIndex);
+            let mappingIndex = count + particleId * selectionPool->ParticlePoolStride;
+            continue_if(span_Get(*poolMapping, mappingIndex) != 0);
+            span_Get(*poolMapping, mappingIndex) = poolIndex;
             poolIndex++;
         }
     }
@@ -109,24 +148,58 @@ static error_t ConstructSelectionPoolIndexRedirection(SCONTEXT_PARAMETER)
 // Construct the selection pool direction buffers
 static error_t ConstructSelectionPoolDirectionBuffers(SCONTEXT_PARAMETER)
 {
-    let poolCount = getJumpSelectionPool(simContext)->DirectionPoolCount;
+    let selectionPool = getJumpSelectionPool(simContext);
+    let poolCount = selectionPool->DirectionPoolCount;
     let poolSize = getNumberOfSelectables(simContext);
     let poolMapping = getDirectionPoolMapping(simContext);
     var directionPools = getDirectionPools(simContext);
 
     *directionPools = span_New(*directionPools, poolCount);
     cpp_foreach(dirPool, *directionPools)
+    {
         dirPool->EnvironmentPool = list_New(dirPool->EnvironmentPool, poolSize);
+        dirPool->SelectionWeight = 1.0;
+    }
 
-    int32_t jumpCount = 0;
+    int32_t mappingIndex = 0;
     cpp_foreach(id, *poolMapping)
     {
-        if (*id > 0) span_Get(*directionPools, *id).DirectionCount = jumpCount;
-        jumpCount++;
+        if (*id > 0)
+        {
+            var dirPool = &span_Get(*directionPools, *id);
+            dirPool->DirectionCount = (selectionPool->ParticlePoolStride > 0) ? mappingIndex % selectionPool->ParticlePoolStride : mappingIndex;
+            dirPool->ParticleId = (selectionPool->ParticlePoolStride > 0) ? mappingIndex / selectionPool->ParticlePoolStride : 0;
+        }
+        mappingIndex++;
     }
     return ERR_OK;
 }
 
+// Construct the jump slot masks and path origin offsets of the KMC selection masks if required
+static error_t ConstructSelectionPoolJumpSlotMasks(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsKmcSelectionMaskActive, ERR_OK);
+    var selectionPool = getJumpSelectionPool(simContext);
+    return_if(FindMaxJumpDirectionCount(getJumpCountMapping(simContext)) > JPOOL_SLOTMASK_BITCOUNT, ERR_DATACONSISTENCY);
+
+    selectionPool->JumpSlotMasks = span_New(selectionPool->JumpSlotMasks, array_Length(*getEnvironmentLattice(simContext)));
+    ConstructPathOriginOffsets(simContext, &selectionPool->PathOriginOffsets, &selectionPool->PathOriginOffsetBegins);
+    return ERR_OK;
+}
+
+// Construct the flat jump slot table and the slot id mapping if required
+static error_t ConstructSelectionPoolJumpSlotTable(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsFlatJumpSlotTableActive, ERR_OK);
+    var selectionPool = getJumpSelectionPool(simContext);
+    selectionPool->JumpSlotStride = FindMaxJumpDirectionCount(getJumpCountMapping(simContext));
+    return_if(selectionPool->JumpSlotStride <= JPOOL_DIRCOUNT_PASSIVE, ERR_DATACONSISTENCY);
+
+    selectionPool->JumpSlotTable = list_New(selectionPool->JumpSlotTable, getNumberOfSelectables(simContext) * selectionPool->JumpSlotStride);
+    selectionPool->JumpSlotIds = span_New(selectionPool->JumpSlotIds, array_Length(*getEnvironmentLattice(simContext)) * selectionPool->JumpSlotStride);
+    return ERR_OK;
+}
+
 // Construct the jump selection pool on the simulation context
 static void ConstructJumpSelectionPool(SCONTEXT_PARAMETER)
 {
@@ -135,6 +208,12 @@ static void ConstructJumpSelectionPool(SCONTEXT_PARAMETER)
 
     error = ConstructSelectionPoolDirectionBuffers(simContext);
     assert_success(error, "Failed to construct selection pool direction buffers.");
+
+    error = ConstructSelectionPoolJumpSlotMasks(simContext);
+    assert_success(error, "Failed to construct selection masks, the number of jump directions of a position exceeds the mask size.");
+
+    error = ConstructSelectionPoolJumpSlotTable(simContext);
+    assert_success(error, "Failed to construct the flat jump slot table.");
 }
 
 // Get the number of bytes the state header requires
@@ -395,12 +474,31 @@ static void SetFlagDependentValuesOnContext(SCONTEXT_PARAMETER)
 {
     simContext->IsJumpLoggingDisabled = JobInfoFlagsAreSet(simContext, INFO_FLG_NOJUMPLOGGING);
     simContext->IsExpApproximationActive = JobInfoFlagsAreSet(simContext, INFO_FLG_USEFASTEXP);
+    simContext->IsRejectionFreeKmcActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) && JobInfoFlagsAreSet(simContext, INFO_FLG_REJECTIONFREE);
+    simContext->IsDirectKmcNormalizationActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) && !simContext->IsRejectionFreeKmcActive && getKmcDirectNormThreadCount(simContext) > 0;
+    simContext->IsSublatticeParallelKmcActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) && !simContext->IsRejectionFreeKmcActive && (getKmcThreadCount(simContext) > 1 || GetDistributedRankCount() > 1);
+    simContext->IsGroupKmcNormalizationActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) && !simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive && getKmcGroupNormWeightLimit(simContext) > 0.0;
+    simContext->IsQuantileKmcNormalizationActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) && !simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive && getKmcNormalizationQuantile(simContext) > 0.0;
+    simContext->IsKmcSelectionMaskActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC | INFO_FLG_SELECTIONMASKS) && !simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive;
+    simContext->IsReplicaExchangeMmcActive = JobInfoFlagsAreSet(simContext, INFO_FLG_MMC) && getMmcReplicaCount(simContext) > 1;
+    simContext->IsSublatticeParallelMmcActive = JobInfoFlagsAreSet(simContext, INFO_FLG_MMC) && !simContext->IsReplicaExchangeMmcActive && getMmcThreadCount(simContext) > 1 && GetDistributedRankCount() <= 1;
+    simContext->IsMmcPartnerSelectionActive = JobInfoFlagsAreSet(simContext, INFO_FLG_MMC | INFO_FLG_SELECTIONMASKS) && !simContext->IsSublatticeParallelMmcActive;
+    simContext->IsFlatJumpSlotTableActive = JobInfoFlagsAreSet(simContext, INFO_FLG_FLATSLOTTABLE) && !simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive && !simContext->IsSublatticeParallelMmcActive && !simContext->IsGroupKmcNormalizationActive;
+    simContext->IsKmcEarlyRejectionActive = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC | INFO_FLG_EARLYREJECTION) && simContext->IsJumpLoggingDisabled && !simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive && !simContext->IsQuantileKmcNormalizationActive;
+}
+
+// Validates that a job started on multiple MPI ranks uses the sublattice parallel KMC routine, the only routine that distributes the lattice onto the ranks
+static void ValidateDistributedModeCompatibility(SCONTEXT_PARAMETER)
+{
+    return_if(GetDistributedRankCount() <= 1);
+    assert_true(simContext->IsSublatticeParallelKmcActive, ERR_CMDARGUMENT, "The distributed mode only supports the sublattice parallel KMC routine, MMC and rejection-free KMC jobs cannot run on multiple MPI ranks.");
 }
 
 // Construct the components of the simulation context
 void ConstructSimulationContext(SCONTEXT_PARAMETER)
 {
     SetFlagDependentValuesOnContext(simContext);
+    ValidateDistributedModeCompatibility(simContext);
     ConstructSimulationModel(simContext);
     ConstructMainState(simContext);
     ConstructJumpSelectionPool(simContext);
@@ -525,19 +623,78 @@ static error_t CopyDbLatticeToMainState(SCONTEXT_PARAMETER)
     return ERR_OK;
 }
 
-// Translates the db lattice data into a mobile tracker id mapping on the state
+// Checks if the passed particle id is part of the position particle set of the passed environment definition
+static bool_t IsPositionParticleId(const EnvironmentDefinition_t*restrict envDefinition, const byte_t particleId)
+{
+    for (int32_t i = 0; i < PARTICLE_IDLIMIT && envDefinition->PositionParticleIds[i] != PARTICLE_NULL; i++)
+        return_if(envDefinition->PositionParticleIds[i] == particleId, true);
+    return false;
+}
+
+// Validates that the passed lattice of a foreign state has the size, the particle set per position and the particle counts of the database lattice
+static error_t ValidateWarmStartLatticeCompatibility(SCONTEXT_PARAMETER, const LatticeState_t*restrict lattice)
+{
+    let dbLattice = getDbModelLattice(simContext);
+    return_if(span_Length(*lattice) != dbLattice->Header->Size, ERR_DATACONSISTENCY);
+
+    int64_t particleCountDeltas[PARTICLE_IDLIMIT] = {0};
+    cpp_foreach(envState, *getEnvironmentLattice(simContext))
+    {
+        let envId = getEnvironmentStateIdByPointer(simContext, envState);
+        let dbParticleId = span_Get(*dbLattice, envId);
+        let particleId = span_Get(*lattice, envId);
+        continue_if(particleId == dbParticleId);
+        return_if(particleId >= PARTICLE_IDLIMIT || !IsPositionParticleId(envState->EnvironmentDefinition, particleId), ERR_DATACONSISTENCY);
+        ++particleCountDeltas[particleId];
+        --particleCountDeltas[dbParticleId];
+    }
+
+    for (int32_t i = 0; i < PARTICLE_IDLIMIT; i++) return_if(particleCountDeltas[i] != 0, ERR_DATACONSISTENCY);
+    return ERR_OK;
+}
+
+// Imports the lattice and optionally the KMC pre-run normalization from the warm start state file into the main state if a warm start is requested
+static error_t TryImportWarmStartState(SCONTEXT_PARAMETER)
+{
+    let filePath = getWarmStartStateFile(simContext);
+    return_if(filePath == NULL, ERR_OK);
+
+    SimulationState_t warmState;
+    var error = LoadContextFreeSimulationStateFromFile(filePath, &warmState);
+    assert_success(error, "Failed to load the warm start state file.");
+
+    error = ValidateWarmStartLatticeCompatibility(simContext, &warmState.Lattice);
+    assert_success(error, "The warm start state lattice is not compatible with the lattice model of the job.");
+
+    var stLattice = getMainStateLattice(simContext);
+    CopyBuffer(warmState.Lattice.Begin, stLattice->Begin, span_Length(*stLattice));
+
+    let isNormalizationImported = simContext->IsWarmStartNormalizationActive && JobInfoFlagsAreSet(simContext, INFO_FLG_KMC);
+    if (isNormalizationImported)
+    {
+        var metaData = getMainStateMetaData(simContext);
+        metaData->RawMaxJumpProbability = warmState.Meta.Data->RawMaxJumpProbability;
+        metaData->JumpNormalization = warmState.Meta.Data->JumpNormalization;
+    }
+
+    printf("[Init-Info]: Warm start state IMPORTED [FILE=%s, NORMALIZATION=%s]\n", filePath, isNormalizationImported ? "TRUE" : "FALSE");
+    span_Delete(warmState.Buffer);
+    return ERR_OK;
+}
+
+// Translates the main state lattice data into a mobile tracker id mapping on the state
 static error_t CopyDefaultMobileTrackersToMainState(SCONTEXT_PARAMETER)
 {
     return_if(JobInfoFlagsAreSet(simContext, INFO_FLG_MMC), ERR_OK);
 
-    let dbLattice = getDbModelLattice(simContext);
+    let stLattice = getMainStateLattice(simContext);
     var mapping = getMobileTrackerMapping(simContext);
     int32_t trackerId = 0;
 
     cpp_foreach(envState, *getEnvironmentLattice(simContext))
     {
         let envId = getEnvironmentStateIdByPointer(simContext, envState);
-        let particleId = span_Get(*dbLattice, envId);
+        let particleId = span_Get(*stLattice, envId);
         let jumpCount = getJumpCountAt(simContext, envState->EnvironmentDefinition->PositionId, particleId);
         if ((jumpCount >= JPOOL_DIRCOUNT_PASSIVE) && (particleId != PARTICLE_VOID))
         {
@@ -606,7 +763,14 @@ static void SetMainStateFlagsToStartConditions(SCONTEXT_PARAMETER)
 {
     setMainStateFlags(simContext, STATE_FLG_FIRSTCYCLE);
 
-    if (JobInfoFlagsAreSet(simContext, INFO_FLG_USEPRERUN))
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_USEPRERUN) && !simContext->IsWarmStartNormalizationActive)
+        setMainStateFlags(simContext, STATE_FLG_PRERUN);
+
+    // Note: The direct normalization replaces the pre-run, it is also applied to KMC jobs that do not request a pre-run
+    if (simContext->IsDirectKmcNormalizationActive && !simContext->IsWarmStartNormalizationActive)
+        setMainStateFlags(simContext, STATE_FLG_PRERUN);
+
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_MMC) && getMmcPreRunMcsp(simContext) > 0)
         setMainStateFlags(simContext, STATE_FLG_PRERUN);
 }
 
@@ -617,6 +781,9 @@ static error_t SyncMainStateToDatabaseModel(SCONTEXT_PARAMETER)
     var error = CopyDbLatticeToMainState(simContext);
     return_if(error, error);
 
+    error = TryImportWarmStartState(simContext);
+    return_if(error, error);
+
     error = CopyDbRngInfoToMainState(simContext);
     return_if(error, error);
 
@@ -694,7 +861,9 @@ static void PopulateDynamicSimulationModel(SCONTEXT_PARAMETER)
     var error = SyncDynamicModelToMainState(simContext);
     assert_success(error, "Data structure synchronization failed (state ==> dynamic model).");
 
+    // Note: A context with a shared linking system borrows the delta tables of the owning context
     #if defined(OPT_USE_3D_PAIRTABLES)
+    return_if(simContext->IsLinkingSystemShared);
     error = GenerateAndSetPairDeltaTables(simContext);
     assert_success(error, "Error on generation of pair delta tables.");
     #endif
@@ -736,16 +905,23 @@ static void SyncSelectionPoolWithDynamicModel(SCONTEXT_PARAMETER)
 
     var error = getJumpSelectionPool(simContext)->SelectableJumpCount == 0 ? ERR_DATACONSISTENCY : ERR_OK;
     assert_success(error, "Model synchronization yielded an empty transition pool. Are you missing a doping?");
+
+    if (simContext->IsKmcSelectionMaskActive)
+        printf("[Init-Info]: KMC selection masks BUILD [MASKED_JUMP_COUNT=%i]\n", getJumpSelectionPool(simContext)->SelectableJumpCount);
+
+    if (simContext->IsFlatJumpSlotTableActive)
+        printf("[Init-Info]: Flat jump slot table BUILD [SLOT_COUNT=%i]\n", (int32_t) span_Length(*getJumpSlotTable(simContext)));
+
+    BuildMmcPartnerSystem(simContext);
 }
 
-// Converts all energy values in pair, cluster tables, and delta tables (if enabled) & others from [eV] to units of [kT]
-static error_t ConvertEnergyTablesToInternalUnits(SCONTEXT_PARAMETER)
+// Scales all energy values in pair, cluster tables, and delta tables (if enabled) & others by the passed factor
+static error_t ScaleEnergyTablesByFactor(SCONTEXT_PARAMETER, const double factor)
 {
     let pairTables = getPairEnergyTables(simContext);
     let clusterTables = getClusterEnergyTables(simContext);
     let defectBackground = getDefectBackground(simContext);
     let latticeBackground = getLatticeEnergyBackground(simContext);
-    let factor = getPhysicalFactors(simContext)->EnergyFactorEvToKt;
     return_if(!isfinite(factor) || (factor <  0), ERR_DATACONSISTENCY);
 
     cpp_foreach(table, *pairTables)
@@ -772,6 +948,12 @@ static error_t ConvertEnergyTablesToInternalUnits(SCONTEXT_PARAMETER)
     return ERR_OK;
 }
 
+// Converts all energy values in pair, cluster tables, and delta tables (if enabled) & others from [eV] to units of [kT]
+static error_t ConvertEnergyTablesToInternalUnits(SCONTEXT_PARAMETER)
+{
+    return ScaleEnergyTablesByFactor(simContext, getPhysicalFactors(simContext)->EnergyFactorEvToKt);
+}
+
 // Corrects all loaded electric field mapping factors from [eV * m/V] to units of [kT]
 static error_t ConvertElectricFieldFactorsToInternalUnits(SCONTEXT_PARAMETER)
 {
@@ -792,14 +974,17 @@ static error_t ConvertElectricFieldFactorsToInternalUnits(SCONTEXT_PARAMETER)
     return ERR_OK;
 }
 
-// Synchronizes the physical simulation with the loaded db data and makes required data corrections to the input data
-static void SyncPhysicalParametersAndEnergyTables(SCONTEXT_PARAMETER)
+// Synchronizes the physical simulation with the loaded db data and makes required data corrections to the input data (Corrections are skipped for a shared model)
+static void SyncPhysicalParametersAndEnergyTables(SCONTEXT_PARAMETER, const bool_t isModelShared)
 {
     var physicalFactors = getPhysicalFactors(simContext);
 
     var error = SetPhysicalSimulationFactorsToDefault(simContext, physicalFactors);
     assert_success(error, "Failed to calculate default physical factors.");
 
+    // Note: The tables of a shared model are already converted in place by the context that owns the model
+    return_if(isModelShared);
+
     error = ConvertEnergyTablesToInternalUnits(simContext);
     assert_success(error, "Failed to convert energy tables to internal units");
 
@@ -890,24 +1075,450 @@ error_t ResetContextAfterKmcPreRun(SCONTEXT_PARAMETER)
     return error;
 }
 
+// Clears the lattice energy abort buffer and its sums
+static void ResetLatticeEnergyBufferToNull(SCONTEXT_PARAMETER)
+{
+    var buffer = getLatticeEnergyBuffer(simContext);
+    buffer->End = buffer->Begin;
+    buffer->CurrentSum = 0.0;
+    buffer->LastSum = 0.0;
+}
+
+error_t ResetContextAfterMmcPreRun(SCONTEXT_PARAMETER)
+{
+    var error = ResetStateCounterCollectionsToNull(simContext);
+    return_if(error, error);
+
+    // Note: The annealing changes the lattice energy strongly, the energy status is recalculated to start the main routine without drift
+    ResetLatticeEnergyBufferToNull(simContext);
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    return ERR_OK;
+}
+
+// Scales all static virtual jump energy corrections of the jump rules by the passed factor (Dynamic corrections stay NaN)
+static void ScaleStaticJumpCorrectionsByFactor(SCONTEXT_PARAMETER, const double factor)
+{
+    var jumpCollections = getJumpCollections(simContext);
+    cpp_foreach(jumpCollection, *jumpCollections)
+        cpp_foreach(jumpRule, jumpCollection->JumpRules)
+            jumpRule->StaticVirtualJumpEnergyCorrection *= factor;
+}
+
+// Clears the block values of the statistical precision abort system
+static void ResetPrecisionAbortSystemToNull(SCONTEXT_PARAMETER)
+{
+    var precisionSystem = getPrecisionAbortSystem(simContext);
+    precisionSystem->BlockValues.End = precisionSystem->BlockValues.Begin;
+    precisionSystem->LastObservableSum = NAN;
+    precisionSystem->LastSimulatedTime = 0.0;
+    precisionSystem->RelativeError = INFINITY;
+    precisionSystem->AbsoluteError = INFINITY;
+    precisionSystem->BlockSampleSum = 0.0;
+    precisionSystem->BlockSampleCount = 0;
+}
+
+// Resets the selection weights and pool maxima of the grouped KMC normalization to the global normalization state
+static void ResetSelectionPoolGroupWeights(SCONTEXT_PARAMETER)
+{
+    var selectionPool = getJumpSelectionPool(simContext);
+    cpp_foreach(directionPool, selectionPool->DirectionPools)
+    {
+        directionPool->SelectionWeight = 1.0;
+        directionPool->RawMaxJumpProbability = 0.0;
+    }
+    selectionPool->WeightedJumpCount = (double) selectionPool->SelectableJumpCount;
+}
+
+// Resets the recorded probabilities and overflow statistics of the quantile KMC normalization to null
+static void ResetKmcNormalizationSystemToNull(SCONTEXT_PARAMETER)
+{
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    let counters = normalizationSystem->ProbabilityCounters;
+    if (counters.Begin != NULL) memset(counters.Begin, 0, span_ByteCount(counters));
+    memset(normalizationSystem, 0, sizeof(KmcNormalizationSystem_t));
+    normalizationSystem->ProbabilityCounters = counters;
+}
+
+error_t ResetContextForParameterSweepPoint(SCONTEXT_PARAMETER, const double temperature)
+{
+    return_if(!isfinite(temperature) || (temperature <= 0.0), ERR_DATACONSISTENCY);
+    var physicalFactors = getPhysicalFactors(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    let oldEnergyFactor = physicalFactors->EnergyFactorEvToKt;
+
+    // Note: The reset normalization falls back to the fixed normalization until the pre-run of the new point has been completed
+    getDbModelJobInfo(simContext)->Temperature = temperature;
+    metaData->RawMaxJumpProbability = 0.0;
+    metaData->JumpNormalization = 0.0;
+    metaData->ProgramRunTime = 0.0;
+    ResetSelectionPoolGroupWeights(simContext);
+    ResetKmcNormalizationSystemToNull(simContext);
+    var error = SetPhysicalSimulationFactorsToDefault(simContext, physicalFactors);
+    return_if(error, error);
+
+    // Note: All energy values in [kT] are rescaled in place, this avoids a reload of the original [eV] tables
+    let scalingFactor = physicalFactors->EnergyFactorEvToKt / oldEnergyFactor;
+    error = ScaleEnergyTablesByFactor(simContext, scalingFactor);
+    return_if(error, error);
+    ScaleStaticJumpCorrectionsByFactor(simContext, scalingFactor);
+
+    // Note: The KMC energy envelopes are rebuilt from the rescaled tables, bounds of the previous point would reject valid jumps
+    BuildKmcEnergyEnvelopes(simContext);
+
+    error = ResetJumpStatisticsToNull(simContext);
+    return_if(error, error);
+
+    var counters = getMainStateCounters(simContext);
+    cpp_foreach(counter, *counters)
+        nullStructContent(*counter);
+
+    error = ResetStateMetaDataToNull(simContext);
+    return_if(error, error);
+
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_KMC))
+    {
+        error = ResetTrackingSystemToNull(simContext);
+        return_if(error, error);
+    }
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_MMC))
+        ResetLatticeEnergyBufferToNull(simContext);
+    ResetPrecisionAbortSystemToNull(simContext);
+
+    var stateHeader = getMainStateHeader(simContext)->Data;
+    stateHeader->Mcs = 0;
+    stateHeader->Cycles = 0;
+    stateHeader->Flags = 0;
+    SetMainStateFlagsToStartConditions(simContext);
+    SyncSimulationCycleStateWithModel(simContext);
+
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    return ERR_OK;
+}
+
 // Populates a freshly constructed simulation context with the required runtime information
-static void PopulateSimulationContext(SCONTEXT_PARAMETER)
+static void PopulateSimulationContext(SCONTEXT_PARAMETER, const bool_t isModelShared)
 {
     PopulatePluginDelegates(simContext);
     PopulateSimulationState(simContext);
     PopulateDynamicSimulationModel(simContext);
     SyncSimulationCycleStateWithModel(simContext);
     SyncSelectionPoolWithDynamicModel(simContext);
-    SyncPhysicalParametersAndEnergyTables(simContext);
+    SyncPhysicalParametersAndEnergyTables(simContext, isModelShared);
     PopulateRngFromMainState(simContext);
 }
 
 void InitializeContextForSimulation(SCONTEXT_PARAMETER)
 {
     ConstructSimulationContext(simContext);
-    PopulateSimulationContext(simContext);
+    PopulateSimulationContext(simContext, false);
 
     InitializeEnvironmentLinkingSystem(simContext);
     BuildJumpStatusCollection(simContext);
+    BuildKmcEnergyEnvelopes(simContext);
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    RunKmcExchangeEquilibration(simContext);
+    BuildKmcRateCatalog(simContext);
+    BuildKmcSublatticeSystem(simContext);
+    BuildMmcReplicaSystem(simContext);
+}
+
+void InitializeSharedModelContextForSimulation(SCONTEXT_PARAMETER)
+{
+    ConstructSimulationContext(simContext);
+    PopulateSimulationContext(simContext, true);
+
+    InitializeEnvironmentLinkingSystem(simContext);
     ResynchronizeEnvironmentEnergyStatus(simContext);
 }
+
+// Sets the environment links, the jump status array and the pair delta tables of the owner context on the member context
+static void ShareEnvironmentLinkingSystem(const SimulationContext_t*restrict owner, SimulationContext_t*restrict member)
+{
+    var ownerEnvironment = owner->DynamicModel.EnvironmentLattice.Begin;
+    cpp_foreach(environment, *getEnvironmentLattice(member))
+        environment->EnvironmentLinks = (ownerEnvironment++)->EnvironmentLinks;
+
+    *getJumpStatusArray(member) = owner->DynamicModel.JumpStatusArray;
+    *getPairDeltaTables(member) = owner->DynamicModel.PairDeltaTables;
+}
+
+// Seeds an independent rng stream for the ensemble member with the passed id if the state is fresh (A state loaded from file keeps its rng state)
+static void SeedEnsembleMemberRng(SCONTEXT_PARAMETER, const int32_t memberId)
+{
+    let jobInfo = getDbModelJobInfo(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    return_if(metaData->RngState != jobInfo->RngStartState || metaData->RngIncrease != jobInfo->RngIncValue);
+
+    var rng = Pcg32SeedGenerator(getMainRng(simContext), jobInfo->RngStartState, (jobInfo->RngIncValue >> 1U) + (uint64_t) memberId);
+    metaData->RngState = rng->State;
+    metaData->RngIncrease = rng->Inc;
+}
+
+void InitializeEnsembleMemberContextForSimulation(SCONTEXT_PARAMETER, const SimulationContext_t*restrict ownerContext, const int32_t memberId)
+{
+    // Note: The linking system only depends on the immutable model and the set of mobile positions, this set is identical for all members of a job
+    simContext->IsLinkingSystemShared = true;
+    ConstructSimulationContext(simContext);
+    PopulateSimulationContext(simContext, true);
+
+    ShareEnvironmentLinkingSystem(ownerContext, simContext);
+    BuildKmcEnergyEnvelopes(simContext);
+    SeedEnsembleMemberRng(simContext, memberId);
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    RunKmcExchangeEquilibration(simContext);
+    BuildKmcRateCatalog(simContext);
+}
+
+// Rebases a pointer into the passed source access to the identical element of the passed target access (NULL stays NULL)
+#define rebaseElementPointer(PTR, SOURCE, TARGET) (((PTR) == NULL) ? NULL : (TARGET).Begin + ((PTR) - (SOURCE).Begin))
+
+// Deep copies the energy fluctuation abort buffer including the buffered values and the sums (A NULL buffer stays NULL)
+static void CloneEnergyFluctuationAbortBuffer(const Flp64Buffer_t*restrict source, Flp64Buffer_t*restrict clone)
+{
+    *clone = *source;
+    return_if(source->Begin == NULL);
+
+    Buffer_t tmp = span_New(tmp, (source->CapacityEnd - source->Begin) * sizeof(double));
+    let valueCount = source->End - source->Begin;
+    if (valueCount != 0) memcpy(tmp.Begin, source->Begin, valueCount * sizeof(double));
+    clone->Begin = (void*) tmp.Begin;
+    clone->End = clone->Begin + valueCount;
+    clone->CapacityEnd = (void*) tmp.End;
+}
+
+// Deep copies the environment lattice including all energy states, cluster states and environment links of the environments
+static void CloneEnvironmentLattice(const SimulationContext_t*restrict source, SimulationContext_t*restrict clone)
+{
+    var cloneLattice = getEnvironmentLattice(clone);
+    *cloneLattice = array_Clone(*cloneLattice, source->DynamicModel.EnvironmentLattice);
+    cpp_foreach(environment, *cloneLattice)
+    {
+        let sourceEnvironment = *environment;
+        environment->EnergyStates = span_Clone(environment->EnergyStates, sourceEnvironment.EnergyStates);
+        environment->ClusterStates = span_Clone(environment->ClusterStates, sourceEnvironment.ClusterStates);
+        environment->EnvironmentLinks = list_Clone(environment->EnvironmentLinks, sourceEnvironment.EnvironmentLinks);
+        cpp_foreach(link, environment->EnvironmentLinks)
+        {
+            let sourceLinks = link->ClusterLinks;
+            link->ClusterLinks = span_Clone(link->ClusterLinks, sourceLinks);
+        }
+    }
+}
+
+// Deep copies the jump status array, the pair delta tables, the selection pool and the rate catalog
+static void CloneJumpSystemBuffers(const SimulationContext_t*restrict source, SimulationContext_t*restrict clone)
+{
+    var jumpStatusArray = getJumpStatusArray(clone);
+    *jumpStatusArray = array_Clone(*jumpStatusArray, source->DynamicModel.JumpStatusArray);
+    cpp_foreach(jumpStatus, *jumpStatusArray)
+    {
+        let sourceLinks = jumpStatus->JumpLinks;
+        jumpStatus->JumpLinks = span_Clone(jumpStatus->JumpLinks, sourceLinks);
+    }
+
+    var deltaTables = getPairDeltaTables(clone);
+    *deltaTables = span_Clone(*deltaTables, source->DynamicModel.PairDeltaTables);
+    cpp_foreach(deltaTable, *deltaTables)
+    {
+        let sourceTable = *deltaTable;
+        *deltaTable = array_Clone(*deltaTable, sourceTable);
+    }
+
+    var selectionPool = getJumpSelectionPool(clone);
+    selectionPool->DirectionPoolMapping = span_Clone(selectionPool->DirectionPoolMapping, source->SelectionPool.DirectionPoolMapping);
+    selectionPool->DirectionPools = span_Clone(selectionPool->DirectionPools, source->SelectionPool.DirectionPools);
+    cpp_foreach(directionPool, selectionPool->DirectionPools)
+    {
+        let sourcePool = directionPool->EnvironmentPool;
+        directionPool->EnvironmentPool = list_Clone(directionPool->EnvironmentPool, sourcePool);
+    }
+    selectionPool->JumpSlotMasks = span_Clone(selectionPool->JumpSlotMasks, source->SelectionPool.JumpSlotMasks);
+    selectionPool->PathOriginOffsets = span_Clone(selectionPool->PathOriginOffsets, source->SelectionPool.PathOriginOffsets);
+    selectionPool->PathOriginOffsetBegins = span_Clone(selectionPool->PathOriginOffsetBegins, source->SelectionPool.PathOriginOffsetBegins);
+    selectionPool->JumpSlotTable = list_Clone(selectionPool->JumpSlotTable, source->SelectionPool.JumpSlotTable);
+    selectionPool->JumpSlotIds = span_Clone(selectionPool->JumpSlotIds, source->SelectionPool.JumpSlotIds);
+
+    var partnerSystem = getMmcPartnerSystem(clone);
+    let sourcePartnerSystem = &source->SelectionPool.PartnerSystem;
+    partnerSystem->ParticlePools = span_Clone(partnerSystem->ParticlePools, sourcePartnerSystem->ParticlePools);
+    cpp_foreach(particlePool, partnerSystem->ParticlePools)
+    {
+        let sourcePool = particlePool->EnvironmentPool;
+        particlePool->EnvironmentPool = list_Clone(particlePool->EnvironmentPool, sourcePool);
+    }
+    partnerSystem->StartPoolIds = span_Clone(partnerSystem->StartPoolIds, sourcePartnerSystem->StartPoolIds);
+    partnerSystem->PoolPositionIds = span_Clone(partnerSystem->PoolPositionIds, sourcePartnerSystem->PoolPositionIds);
+    partnerSystem->PartnerParticleMasks = span_Clone(partnerSystem->PartnerParticleMasks, sourcePartnerSystem->PartnerParticleMasks);
+
+    var rateCatalog = getKmcRateCatalog(clone);
+    let sourceCatalog = &source->DynamicModel.RateCatalog;
+    rateCatalog->RateSumTree = span_Clone(rateCatalog->RateSumTree, sourceCatalog->RateSumTree);
+    rateCatalog->PathOriginOffsets = span_Clone(rateCatalog->PathOriginOffsets, sourceCatalog->PathOriginOffsets);
+    rateCatalog->PathOriginOffsetBegins = span_Clone(rateCatalog->PathOriginOffsetBegins, sourceCatalog->PathOriginOffsetBegins);
+    rateCatalog->RefreshPool = list_Clone(rateCatalog->RefreshPool, sourceCatalog->RefreshPool);
+    rateCatalog->RefreshMarkers = span_Clone(rateCatalog->RefreshMarkers, sourceCatalog->RefreshMarkers);
+}
+
+// Rebases all cycle state pointers that address dynamic buffers of the source context to the copied buffers of the clone
+static void RebaseClonedCycleStatePointers(const SimulationContext_t*restrict source, SimulationContext_t*restrict clone)
+{
+    var cycleState = getCycleState(clone);
+    let sourceLattice = &source->DynamicModel.EnvironmentLattice;
+    let cloneLattice = getEnvironmentLattice(clone);
+
+    cycleState->ActiveCounterCollection = rebaseElementPointer(cycleState->ActiveCounterCollection, source->MainState.Counters, clone->MainState.Counters);
+    cycleState->ActiveJumpStatus = rebaseElementPointer(cycleState->ActiveJumpStatus, source->DynamicModel.JumpStatusArray, clone->DynamicModel.JumpStatusArray);
+    c_foreach(pathEnvironment, cycleState->ActivePathEnvironments)
+        *pathEnvironment = rebaseElementPointer(*pathEnvironment, *sourceLattice, *cloneLattice);
+
+    // Note: The work cluster is always a cluster state of the work environment
+    let sourceWorkEnvironment = source->CycleState.WorkEnvironment;
+    cycleState->WorkEnvironment = rebaseElementPointer(cycleState->WorkEnvironment, *sourceLattice, *cloneLattice);
+    cycleState->WorkCluster = (sourceWorkEnvironment == NULL) ? NULL
+        : rebaseElementPointer(cycleState->WorkCluster, sourceWorkEnvironment->ClusterStates, cycleState->WorkEnvironment->ClusterStates);
+
+    #if defined(OPT_USE_3D_PAIRTABLES)
+    cycleState->WorkPairTable = rebaseElementPointer(cycleState->WorkPairTable, source->DynamicModel.PairDeltaTables, clone->DynamicModel.PairDeltaTables);
+    #endif
+}
+
+SimulationContext_t* CloneSimulationContext(SCONTEXT_PARAMETER)
+{
+    SimulationContext_t* clone = malloc(sizeof(SimulationContext_t));
+    assert_true(clone != NULL, ERR_MEMALLOCATION, "Failed to allocate a simulation context clone.");
+
+    // Note: The plain copy shares the database model, file information and arguments, all dynamic buffers are replaced by copies afterwards
+    *clone = *simContext;
+    clone->MainState.Buffer = span_Clone(clone->MainState.Buffer, simContext->MainState.Buffer);
+    var error = RestoreSimulationStateAccessToBuffer(&clone->MainState.Buffer, &clone->MainState);
+    assert_success(error, "Failed to restore the state access of a simulation context clone.");
+
+    CloneEnvironmentLattice(simContext, clone);
+    CloneJumpSystemBuffers(simContext, clone);
+    RebaseClonedCycleStatePointers(simContext, clone);
+
+    CloneEnergyFluctuationAbortBuffer(&simContext->DynamicModel.LatticeEnergyBuffer, getLatticeEnergyBuffer(clone));
+    var precisionSystem = getPrecisionAbortSystem(clone);
+    precisionSystem->BlockValues = list_Clone(precisionSystem->BlockValues, simContext->DynamicModel.PrecisionAbortSystem.BlockValues);
+    var normalizationSystem = getKmcNormalizationSystem(clone);
+    normalizationSystem->ProbabilityCounters = span_Clone(normalizationSystem->ProbabilityCounters, simContext->DynamicModel.NormalizationSystem.ProbabilityCounters);
+    var envelopeSystem = getKmcEnvelopeSystem(clone);
+    envelopeSystem->Envelopes = span_Clone(envelopeSystem->Envelopes, simContext->DynamicModel.EnvelopeSystem.Envelopes);
+    envelopeSystem->RuleOffsets = span_Clone(envelopeSystem->RuleOffsets, simContext->DynamicModel.EnvelopeSystem.RuleOffsets);
+
+    // Note: The clone does not own parallel sub-systems, a clone of a parallel context continues with the serial routines
+    memset(getKmcSublatticeSystem(clone), 0, sizeof(KmcSublatticeSystem_t));
+    memset(getMmcReplicaSystem(clone), 0, sizeof(MmcReplicaSystem_t));
+    clone->IsSublatticeParallelKmcActive = false;
+    clone->IsSublatticeParallelMmcActive = false;
+    clone->IsReplicaExchangeMmcActive = false;
+    clone->IsLinkingSystemShared = false;
+    return clone;
+}
+
+SimulationContext_t* ConstructSharedModelWorkerContext(SCONTEXT_PARAMETER, const int32_t streamId)
+{
+    // Note: The worker is a clone of the initialized context, this skips the linking and energy synchronization of a full initialization
+    var worker = CloneSimulationContext(simContext);
+    worker->CmdOverwrites.MmcReplicaCount = 0;
+    worker->CmdOverwrites.MmcThreadCount = 0;
+    worker->CmdOverwrites.ExtensionThreadCount = 0;
+    worker->CmdOverwrites.PrecisionAbortTarget = 0.0;
+    worker->CmdOverwrites.PrecisionAbortAbsolute = 0.0;
+
+    // Note: All workers start with the rng state of the passed context, the streams are reseeded to avoid identical chains
+    var mainRng = getMainRng(simContext);
+    let state = ((uint64_t) Pcg32NextRandom(mainRng) << 32U) | Pcg32NextRandom(mainRng);
+    Pcg32SeedGenerator(getMainRng(worker), state, (uint64_t) streamId);
+    return worker;
+}
+
+void DeleteSimulationContextDynamicBuffers(SCONTEXT_PARAMETER)
+{
+    var environmentLattice = getEnvironmentLattice(simContext);
+    let isLinkingSystemOwned = !simContext->IsLinkingSystemShared;
+    cpp_foreach(environment, *environmentLattice)
+    {
+        span_Delete(environment->EnergyStates);
+        span_Delete(environment->ClusterStates);
+        continue_if(!isLinkingSystemOwned);
+        cpp_foreach(link, environment->EnvironmentLinks)
+            span_Delete(link->ClusterLinks);
+        list_Delete(environment->EnvironmentLinks);
+    }
+    array_Delete(*environmentLattice);
+
+    var jumpStatusArray = getJumpStatusArray(simContext);
+    if (isLinkingSystemOwned)
+    {
+        cpp_foreach(jumpStatus, *jumpStatusArray)
+            span_Delete(jumpStatus->JumpLinks);
+        array_Delete(*jumpStatusArray);
+    }
+
+    cpp_foreach(directionPool, *getDirectionPools(simContext))
+        list_Delete(directionPool->EnvironmentPool);
+    span_Delete(*getDirectionPools(simContext));
+    span_Delete(*getDirectionPoolMapping(simContext));
+    span_Delete(*getJumpSlotMasks(simContext));
+    span_Delete(getJumpSelectionPool(simContext)->PathOriginOffsets);
+    span_Delete(getJumpSelectionPool(simContext)->PathOriginOffsetBegins);
+    list_Delete(*getJumpSlotTable(simContext));
+    span_Delete(getJumpSelectionPool(simContext)->JumpSlotIds);
+
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    cpp_foreach(particlePool, partnerSystem->ParticlePools)
+        list_Delete(particlePool->EnvironmentPool);
+    span_Delete(partnerSystem->ParticlePools);
+    span_Delete(partnerSystem->StartPoolIds);
+    span_Delete(partnerSystem->PoolPositionIds);
+    span_Delete(partnerSystem->PartnerParticleMasks);
+
+    if (isLinkingSystemOwned)
+    {
+        cpp_foreach(deltaTable, *getPairDeltaTables(simContext))
+            array_Delete(*deltaTable);
+        span_Delete(*getPairDeltaTables(simContext));
+    }
+
+    var rateCatalog = getKmcRateCatalog(simContext);
+    span_Delete(rateCatalog->RateSumTree);
+    span_Delete(rateCatalog->PathOriginOffsets);
+    span_Delete(rateCatalog->PathOriginOffsetBegins);
+    list_Delete(rateCatalog->RefreshPool);
+    span_Delete(rateCatalog->RefreshMarkers);
+
+    var sublatticeSystem = getKmcSublatticeSystem(simContext);
+    cpp_foreach(sector, sublatticeSystem->Sectors)
+    {
+        span_Delete(sector->EnvironmentIds);
+        span_Delete(sector->Counters);
+        span_Delete(sector->GlobalTrackers);
+        span_Delete(sector->JumpStatistics);
+        list_Delete(sector->EnvironmentChanges);
+    }
+    span_Delete(sublatticeSystem->Sectors);
+    span_Delete(sublatticeSystem->ReferenceState);
+
+    // Note: Replica zero is the passed context itself
+    var replicaSystem = getMmcReplicaSystem(simContext);
+    cpp_offset_foreach(replica, replicaSystem->Replicas, 1)
+    {
+        DeleteSimulationContextDynamicBuffers(replica->Context);
+        free(replica->Context);
+    }
+    span_Delete(replicaSystem->Replicas);
+
+    span_Delete(*getLatticeEnergyBuffer(simContext));
+    list_Delete(getPrecisionAbortSystem(simContext)->BlockValues);
+    span_Delete(getKmcNormalizationSystem(simContext)->ProbabilityCounters);
+    span_Delete(getKmcEnvelopeSystem(simContext)->Envelopes);
+    span_Delete(getKmcEnvelopeSystem(simContext)->RuleOffsets);
+    span_Delete(*getMainStateBuffer(simContext));
+
+    let fileInfo = *getFileInformation(simContext);
+    memset(&simContext->DynamicModel, 0, sizeof(DynamicModel_t));
+    *getFileInformation(simContext) = fileInfo;
+    memset(&simContext->SelectionPool, 0, sizeof(JumpSelectionPool_t));
+    memset(&simContext->MainState, 0, sizeof(SimulationState_t));
+}
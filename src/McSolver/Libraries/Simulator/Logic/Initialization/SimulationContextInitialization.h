@@ -14,5 +14,30 @@
 // Prepares the simulation context for the simulation
 void InitializeContextForSimulation(SCONTEXT_PARAMETER);
 
+// Prepares a context that shares the database model of an already initialized context for the simulation (The shared tables are not converted again)
+void InitializeSharedModelContextForSimulation(SCONTEXT_PARAMETER);
+
+// Prepares an ensemble member context that shares the database model and the immutable linking system of an initialized owner context
+// (A fresh member state gets an independent rng stream by the member id, the member has to be deleted before the owner)
+void InitializeEnsembleMemberContextForSimulation(SCONTEXT_PARAMETER, const SimulationContext_t*restrict ownerContext, int32_t memberId);
+
+// Constructs a worker context as a clone of an initialized context that owns an independent rng stream with the passed stream id
+// (The worker does not start parallel sub-systems of its own, the context has to be deleted and freed manually)
+SimulationContext_t* ConstructSharedModelWorkerContext(SCONTEXT_PARAMETER, int32_t streamId);
+
+// Constructs a deep copy of an initialized context that shares the database model and owns copies of all dynamic buffers and the rng state
+// (Parallel sub-systems are not copied, the clone has to be deleted with DeleteSimulationContextDynamicBuffers and freed manually)
+SimulationContext_t* CloneSimulationContext(SCONTEXT_PARAMETER);
+
 // Resets the required simulation context components after pre run completion in KMC routines
-error_t ResetContextAfterKmcPreRun(SCONTEXT_PARAMETER);
\ No newline at end of file
+error_t ResetContextAfterKmcPreRun(SCONTEXT_PARAMETER);
+
+// Resets the required simulation context components after pre run completion in MMC routines
+error_t ResetContextAfterMmcPreRun(SCONTEXT_PARAMETER);
+
+// Resets an initialized simulation context to the start of a new parameter sweep point with the passed temperature in [K]
+// (The lattice of the previous point is kept, the temperature dependent tables are rescaled and all result collections are cleared)
+error_t ResetContextForParameterSweepPoint(SCONTEXT_PARAMETER, double temperature);
+
+// Frees the dynamic buffers of a finished simulation context (The database model and the file information are not affected)
+void DeleteSimulationContextDynamicBuffers(SCONTEXT_PARAMETER);
\ No newline at end of file
@@ -0,0 +1,459 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	DistributedKmcRoutines.c	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Distributed (MPI) KMC       //
+//////////////////////////////////////////
+
+#if defined(MC_MPIBUILD)
+#include <mpi.h>
+#endif
+#include "DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/EnvironmentRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/SublatticeKmcRoutines.h"
+
+/* Local helper routines */
+
+// Checks if the passed sector id is owned by the rank of the passed sublattice system
+static inline bool_t IsSectorOwnedByRank(const KmcSublatticeSystem_t*restrict system, const int32_t sectorId)
+{
+    return (sectorId >= system->SectorBegin) && (sectorId < system->SectorEnd);
+}
+
+// Get the cyclic distance in sectors between the passed sector id and the owned sector range of the rank (Zero for owned sectors, one for the halo sectors)
+static inline int32_t GetSectorDistanceToRank(const KmcSublatticeSystem_t*restrict system, const int32_t sectorId)
+{
+    return_if(IsSectorOwnedByRank(system, sectorId), 0);
+    let sectorCount = (int32_t) span_Length(system->Sectors);
+    let lowerDistance = (system->SectorBegin - sectorId + sectorCount) % sectorCount;
+    let upperDistance = (sectorId - system->SectorEnd + 1 + sectorCount) % sectorCount;
+    return getMinOfTwo(lowerDistance, upperDistance);
+}
+
+// Get the rank id that owns the passed sector id (Inverse of the slab assignment of the sector range setter)
+static inline int32_t GetSectorOwnerRankId(const KmcSublatticeSystem_t*restrict system, const int32_t sectorId)
+{
+    let sectorCount = (int32_t) span_Length(system->Sectors);
+    return (int32_t) (((int64_t) (sectorId + 1) * system->RankCount - 1) / sectorCount);
+}
+
+// Applies the passed environment change to the rank local lattice through the environment link update system
+static inline void ApplyEnvironmentChange(SCONTEXT_PARAMETER, const EnvironmentChange_t*restrict change)
+{
+    var environment = getEnvironmentStateAt(simContext, change->EnvironmentId);
+    SetEnvironmentStateParticleId(simContext, environment, change->ParticleId);
+    environment->MobileTrackerId = change->MobileTrackerId;
+}
+
+// Get the pointer into the reference state that corresponds to the passed pointer into the main state buffer
+static inline void* GetReferenceStatePointer(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, const void* mainStatePointer)
+{
+    return system->ReferenceState.Begin + ((const byte_t*) mainStatePointer - getMainStateBuffer(simContext)->Begin);
+}
+
+#if defined(MC_MPIBUILD)
+
+/* Process environment routines */
+
+// Get the id of the calling rank in the distributed process environment
+static int32_t GetDistributedRankId(void)
+{
+    int32_t rankId;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rankId);
+    return rankId;
+}
+
+void StartDistributedProcessEnvironment(void)
+{
+    MPI_Init(NULL, NULL);
+    return_if(IsDistributedRootRank());
+
+    // Note: Only the root rank holds the merged main state at the block ends, thus only the root rank prints and writes the output
+    let nullStream = freopen("/dev/null", "w", stdout);
+    assert_true(nullStream != NULL, ERR_STREAM, "Failed to silence the stdout of a non-root MPI rank.");
+}
+
+void FinishDistributedProcessEnvironment(void)
+{
+    MPI_Finalize();
+}
+
+int32_t GetDistributedRankCount(void)
+{
+    int32_t rankCount;
+    MPI_Comm_size(MPI_COMM_WORLD, &rankCount);
+    return rankCount;
+}
+
+bool_t IsDistributedRootRank(void)
+{
+    return GetDistributedRankId() == 0;
+}
+
+/* Simulation routines */
+
+// Sends the change log of the passed sector to the target rank, receives the change log of the source rank and applies the received changes that are located in the halo
+static void ExchangeBoundarySectorChanges(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, const KmcSector_t*restrict sector, const int32_t targetRankId, const int32_t sourceRankId)
+{
+    let sendCount = (int32_t) span_Length(sector->EnvironmentChanges);
+    int32_t receiveCount = 0;
+    MPI_Sendrecv(&sendCount, 1, MPI_INT32_T, targetRankId, 0, &receiveCount, 1, MPI_INT32_T, sourceRankId, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    // Note: The list is allocated with one additional entry as zero sized allocations are not portable
+    EnvironmentChanges_t receiveChanges = list_New(receiveChanges, receiveCount + 1);
+    MPI_Sendrecv(sector->EnvironmentChanges.Begin, sendCount * (int32_t) sizeof(EnvironmentChange_t), MPI_BYTE, targetRankId, 1,
+                 receiveChanges.Begin, receiveCount * (int32_t) sizeof(EnvironmentChange_t), MPI_BYTE, sourceRankId, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    receiveChanges.End = receiveChanges.Begin + receiveCount;
+
+    cpp_foreach(change, receiveChanges)
+    {
+        continue_if(!IsEnvironmentInDistributedRankDomain(system, getEnvironmentStateAt(simContext, change->EnvironmentId)));
+        ApplyEnvironmentChange(simContext, change);
+    }
+    list_Delete(receiveChanges);
+}
+
+void ExchangeDistributedSublatticePhaseChanges(SCONTEXT_PARAMETER)
+{
+    var system = getKmcSublatticeSystem(simContext);
+    return_if(system->RankCount <= 1);
+
+    let lowerRankId = (system->RankId - 1 + system->RankCount) % system->RankCount;
+    let upperRankId = (system->RankId + 1) % system->RankCount;
+    var firstSector = &span_Get(system->Sectors, system->SectorBegin);
+    var lastSector = &span_Get(system->Sectors, system->SectorEnd - 1);
+
+    // Note: The halo sectors of a rank are the boundary sectors of its neighbors, the changes of all inner sectors never leave the rank
+    ExchangeBoundarySectorChanges(simContext, system, lastSector, upperRankId, lowerRankId);
+    ExchangeBoundarySectorChanges(simContext, system, firstSector, lowerRankId, upperRankId);
+    list_Clear(firstSector->EnvironmentChanges);
+    list_Clear(lastSector->EnvironmentChanges);
+}
+
+void SumReduceDistributedInt64Values(const KmcSublatticeSystem_t*restrict system, int64_t*restrict values, const int32_t count)
+{
+    return_if(system->RankCount <= 1);
+    MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+}
+
+void SumReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, const int32_t count)
+{
+    return_if(system->RankCount <= 1);
+    MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+}
+
+void MaxReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, const int32_t count)
+{
+    return_if(system->RankCount <= 1);
+    MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+}
+
+// Writes the particle ids and mobile tracker ids of all environments that are owned by the rank in ascending environment id order to the passed buffers
+static void PackOwnedLatticeOccupations(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, Buffer_t*restrict particleIds, IdMappingSpan_t*restrict trackerIds)
+{
+    int32_t index = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        continue_if(!IsEnvironmentOwnedByDistributedRank(system, environment));
+        span_Get(*particleIds, index) = environment->ParticleId;
+        span_Get(*trackerIds, index) = environment->MobileTrackerId;
+        ++index;
+    }
+}
+
+// Writes the gathered occupations of all ranks to the environments outside of the root domain. The entries of each rank are in ascending environment id order
+static void UnpackGatheredLatticeOccupations(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, const Buffer_t*restrict particleIds, const IdMappingSpan_t*restrict trackerIds, int32_t*restrict offsets)
+{
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        let index = offsets[GetSectorOwnerRankId(system, GetEnvironmentSectorId(system, environment))]++;
+        continue_if(IsEnvironmentInDistributedRankDomain(system, environment));
+
+        // Note: The environments outside of the root domain hold no maintained energy status, the occupation is set without link updates
+        environment->ParticleId = span_Get(*particleIds, index);
+        environment->MobileTrackerId = span_Get(*trackerIds, index);
+    }
+}
+
+// Gathers the occupations and mobile tracker ids of the owned environments of all ranks onto the lattice of the root rank
+static void GatherDistributedLatticeOccupations(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system)
+{
+    int32_t ownedCount = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+        ownedCount += IsEnvironmentOwnedByDistributedRank(system, environment);
+
+    // Note: The spans are allocated with one additional entry as zero sized allocations are not portable
+    Buffer_t particleIds = span_New(particleIds, ownedCount + 1);
+    IdMappingSpan_t trackerIds = span_New(trackerIds, ownedCount + 1);
+    PackOwnedLatticeOccupations(simContext, system, &particleIds, &trackerIds);
+
+    let isRoot = IsDistributedRootRank();
+    let environmentCount = isRoot ? (int32_t) array_Length(*getEnvironmentLattice(simContext)) : 0;
+    int32_t counts[system->RankCount], offsets[system->RankCount];
+    MPI_Gather(&ownedCount, 1, MPI_INT32_T, counts, 1, MPI_INT32_T, 0, MPI_COMM_WORLD);
+    for (int32_t i = 0, offset = 0; isRoot && (i < system->RankCount); offset += counts[i++]) offsets[i] = offset;
+
+    Buffer_t rootParticleIds = span_New(rootParticleIds, environmentCount + 1);
+    IdMappingSpan_t rootTrackerIds = span_New(rootTrackerIds, environmentCount + 1);
+    MPI_Gatherv(particleIds.Begin, ownedCount, MPI_UINT8_T, rootParticleIds.Begin, counts, offsets, MPI_UINT8_T, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(trackerIds.Begin, ownedCount, MPI_INT32_T, rootTrackerIds.Begin, counts, offsets, MPI_INT32_T, 0, MPI_COMM_WORLD);
+    if (isRoot) UnpackGatheredLatticeOccupations(simContext, system, &rootParticleIds, &rootTrackerIds, offsets);
+
+    span_Delete(particleIds);
+    span_Delete(trackerIds);
+    span_Delete(rootParticleIds);
+    span_Delete(rootTrackerIds);
+}
+
+// Sum reduces the rank local changes of the passed int64 state values relative to the reference state onto the root rank (The other ranks keep their local values)
+static void SumReduceInt64StateChanges(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, int64_t*restrict values, const int32_t count)
+{
+    let referenceValues = (const int64_t*) GetReferenceStatePointer(simContext, system, values);
+    for (int32_t i = 0; i < count; ++i) values[i] -= referenceValues[i];
+    MPI_Reduce(IsDistributedRootRank() ? MPI_IN_PLACE : values, values, count, MPI_INT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    for (int32_t i = 0; i < count; ++i) values[i] += referenceValues[i];
+}
+
+// Sum reduces the rank local changes of the passed double state values relative to the reference state onto the root rank (The other ranks keep their local values)
+static void SumReduceDoubleStateChanges(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system, double*restrict values, const int32_t count)
+{
+    let referenceValues = (const double*) GetReferenceStatePointer(simContext, system, values);
+    for (int32_t i = 0; i < count; ++i) values[i] -= referenceValues[i];
+    MPI_Reduce(IsDistributedRootRank() ? MPI_IN_PLACE : values, values, count, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    for (int32_t i = 0; i < count; ++i) values[i] += referenceValues[i];
+}
+
+// Merges the counters, movement trackers and jump histograms of all ranks into the main state of the root rank
+static void MergeDistributedStateAccumulators(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system)
+{
+    let counters = getMainStateCounters(simContext);
+    SumReduceInt64StateChanges(simContext, system, (int64_t*) counters->Begin, (int32_t) (span_ByteCount(*counters) / sizeof(int64_t)));
+
+    TrackersState_t* trackers[] = {getGlobalMovementTrackers(simContext), getMobileMovementTrackers(simContext), getStaticMovementTrackers(simContext)};
+    c_foreach(tracker, trackers)
+        SumReduceDoubleStateChanges(simContext, system, (double*) (*tracker)->Begin, (int32_t) (span_ByteCount(**tracker) / sizeof(double)));
+
+    // Note: The overflow, underflow and count buffer entries of a histogram form one continuous block of int64 values
+    cpp_foreach(statistic, *getJumpStatistics(simContext))
+    {
+        JumpHistogram_t* histograms[] = {&statistic->EdgeEnergyHistogram, &statistic->PosConfEnergyHistogram, &statistic->NegConfEnergyHistogram, &statistic->TotalEnergyHistogram};
+        c_foreach(histogram, histograms)
+            SumReduceInt64StateChanges(simContext, system, &(*histogram)->OverflowCount, STATE_JUMPSTAT_SIZE + 2);
+    }
+}
+
+void MergeDistributedSublatticeStates(SCONTEXT_PARAMETER)
+{
+    let system = getKmcSublatticeSystem(simContext);
+    return_if(system->RankCount <= 1);
+
+    GatherDistributedLatticeOccupations(simContext, system);
+    MergeDistributedStateAccumulators(simContext, system);
+}
+
+error_t BroadcastDistributedAbortDecision(SCONTEXT_PARAMETER, error_t abortFlag)
+{
+    return_if(getKmcSublatticeSystem(simContext)->RankCount <= 1, abortFlag);
+
+    // Note: The abort conditions include wall clock times that differ between the ranks, the root rank decides for all
+    MPI_Bcast(&abortFlag, 1, MPI_INT32_T, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&getMainStateHeader(simContext)->Data->Flags, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+    MPI_Bcast(getMainStateMetaData(simContext), sizeof(StateMetaData_t), MPI_BYTE, 0, MPI_COMM_WORLD);
+    return abortFlag;
+}
+
+#else
+
+/* Process environment routines */
+
+// Get the id of the calling rank in the distributed process environment
+static int32_t GetDistributedRankId(void)
+{
+    return 0;
+}
+
+void StartDistributedProcessEnvironment(void)
+{
+}
+
+void FinishDistributedProcessEnvironment(void)
+{
+}
+
+int32_t GetDistributedRankCount(void)
+{
+    return 1;
+}
+
+bool_t IsDistributedRootRank(void)
+{
+    return true;
+}
+
+/* Simulation routines */
+
+void ExchangeDistributedSublatticePhaseChanges(SCONTEXT_PARAMETER)
+{
+}
+
+void SumReduceDistributedInt64Values(const KmcSublatticeSystem_t*restrict system, int64_t*restrict values, const int32_t count)
+{
+}
+
+void SumReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, const int32_t count)
+{
+}
+
+void MaxReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, const int32_t count)
+{
+}
+
+void MergeDistributedSublatticeStates(SCONTEXT_PARAMETER)
+{
+}
+
+error_t BroadcastDistributedAbortDecision(SCONTEXT_PARAMETER, const error_t abortFlag)
+{
+    return abortFlag;
+}
+
+#endif
+
+/* Initializer routines */
+
+// Releases the link and energy buffers of all environments and the jump links of all unit cells that are not required by the rank
+static int32_t ReleaseRemoteLatticeBuffers(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system)
+{
+    int32_t heldCount = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        let distance = GetSectorDistanceToRank(system, GetEnvironmentSectorId(system, environment));
+        heldCount += (distance <= SUBLATTICE_RANK_HALODISTANCE);
+        continue_if(distance <= SUBLATTICE_RANK_HALODISTANCE);
+
+        // Note: The fringe environments receive the link updates of the halo changes, they keep the energy and cluster buffers but never send updates
+        cpp_foreach(environmentLink, environment->EnvironmentLinks) span_Delete(environmentLink->ClusterLinks);
+        list_Delete(environment->EnvironmentLinks);
+        environment->EnvironmentLinks = (EnvironmentLinks_t) {.Begin = NULL, .End = NULL, .CapacityEnd = NULL};
+        continue_if(distance <= SUBLATTICE_RANK_FRINGEDISTANCE);
+
+        span_Delete(environment->EnergyStates);
+        span_Delete(environment->ClusterStates);
+        environment->EnergyStates = (EnergyStates_t) {.Begin = NULL, .End = NULL};
+        environment->ClusterStates = (ClusterStates_t) {.Begin = NULL, .End = NULL};
+    }
+
+    // Note: Jumps only start in owned sectors, the jump status of all other unit cells is never accessed
+    let latticeSizes = getLatticeSizeVector(simContext);
+    let jumpDirectionCount = (int32_t) span_Length(*getJumpDirections(simContext));
+    var jumpStatusArray = getJumpStatusArray(simContext);
+    for (int32_t a = 0; a < latticeSizes->A; ++a)
+    {
+        for (int32_t b = 0; b < latticeSizes->B; ++b)
+        {
+            for (int32_t c = 0; c < latticeSizes->C; ++c)
+            {
+                let vector = (Vector4_t) {.A = a, .B = b, .C = c, .D = 0};
+                continue_if(IsSectorOwnedByRank(system, GetVector4SectorId(system, &vector)));
+                for (int32_t d = 0; d < jumpDirectionCount; ++d)
+                {
+                    var jumpStatus = &array_Get(*jumpStatusArray, a, b, c, d);
+                    span_Delete(jumpStatus->JumpLinks);
+                    jumpStatus->JumpLinks = (JumpLinks_t) {.Begin = NULL, .End = NULL};
+                }
+            }
+        }
+    }
+    return heldCount;
+}
+
+// Releases the environment ids and the local accumulators of all sectors that are not owned by the rank
+static void ReleaseRemoteSectorBuffers(KmcSublatticeSystem_t*restrict system)
+{
+    cpp_foreach(sector, system->Sectors)
+    {
+        continue_if(IsSectorOwnedByRank(system, (int32_t) (sector - system->Sectors.Begin)));
+        span_Delete(sector->EnvironmentIds);
+        span_Delete(sector->Counters);
+        span_Delete(sector->GlobalTrackers);
+        span_Delete(sector->JumpStatistics);
+        sector->EnvironmentIds = (IdMappingSpan_t) {.Begin = NULL, .End = NULL};
+        sector->Counters = (CountersState_t) {.Begin = NULL, .End = NULL};
+        sector->GlobalTrackers = (TrackersState_t) {.Begin = NULL, .End = NULL};
+        sector->JumpStatistics = (JumpStatisticsState_t) {.Begin = NULL, .End = NULL};
+    }
+}
+
+error_t SetDistributedSectorRangeOnSublatticeSystem(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    let sectorCount = (int32_t) span_Length(system->Sectors);
+    system->RankId = GetDistributedRankId();
+    system->RankCount = GetDistributedRankCount();
+    return_if(system->RankCount > sectorCount, ERR_VALIDATION);
+
+    // Note: Each rank owns a contiguous slab of sectors, the slab sizes of the ranks differ by at most one sector
+    system->SectorBegin = (int32_t) ((int64_t) system->RankId * sectorCount / system->RankCount);
+    system->SectorEnd = (int32_t) ((int64_t) (system->RankId + 1) * sectorCount / system->RankCount);
+    return_if(system->RankCount <= 1, ERR_OK);
+
+    // Note: Only the changes of the two boundary sectors affect the halo of a neighbor rank, thus only these sectors log their changes
+    var firstSector = &span_Get(system->Sectors, system->SectorBegin);
+    var lastSector = &span_Get(system->Sectors, system->SectorEnd - 1);
+    firstSector->EnvironmentChanges = list_New(firstSector->EnvironmentChanges, system->CyclesPerPhase * JUMPS_JUMPLENGTH_MAX);
+    if (lastSector != firstSector)
+        lastSector->EnvironmentChanges = list_New(lastSector->EnvironmentChanges, system->CyclesPerPhase * JUMPS_JUMPLENGTH_MAX);
+
+    let heldCount = ReleaseRemoteLatticeBuffers(simContext, system);
+    ReleaseRemoteSectorBuffers(system);
+    printf("[Init-Info]: KMC distributed system BUILD [RANK_COUNT=%i, OWNED_SECTORS=%i, HELD_ENVIRONMENTS=%i of %i]\n",
+           system->RankCount, system->SectorEnd - system->SectorBegin, heldCount, (int32_t) array_Length(*getEnvironmentLattice(simContext)));
+    return ERR_OK;
+}
+
+/* Simulation routines */
+
+bool_t IsEnvironmentInDistributedRankDomain(const KmcSublatticeSystem_t*restrict system, const EnvironmentState_t*restrict environment)
+{
+    return_if(system->RankCount <= 1, true);
+    return GetSectorDistanceToRank(system, GetEnvironmentSectorId(system, environment)) <= SUBLATTICE_RANK_HALODISTANCE;
+}
+
+bool_t IsEnvironmentOwnedByDistributedRank(const KmcSublatticeSystem_t*restrict system, const EnvironmentState_t*restrict environment)
+{
+    return_if(system->RankCount <= 1, true);
+    return IsSectorOwnedByRank(system, GetEnvironmentSectorId(system, environment));
+}
+
+void LogDistributedSectorPathChanges(SCONTEXT_PARAMETER, KmcSector_t*restrict sector)
+{
+    // Note: Only the boundary sectors of a rank in the distributed mode own a change log
+    return_if(sector->EnvironmentChanges.Begin == NULL);
+    return_if((simContext->CycleResult != MC_ACCEPTED_CYCLE) && (simContext->CycleResult != MC_STARTUNSTABLE_CYCLE));
+
+    let jumpLength = getActiveJumpDirection(simContext)->JumpLength;
+    for (int32_t pathId = 0; pathId < jumpLength; ++pathId)
+    {
+        let environment = JUMPPATH[pathId];
+        let change = (EnvironmentChange_t) {
+            .EnvironmentId = getEnvironmentStateIdByPointer(simContext, environment),
+            .MobileTrackerId = environment->MobileTrackerId,
+            .ParticleId = environment->ParticleId
+        };
+        list_PushBack(sector->EnvironmentChanges, change);
+    }
+}
+
+void SetDistributedReferenceState(SCONTEXT_PARAMETER)
+{
+    var system = getKmcSublatticeSystem(simContext);
+    let stateBuffer = getMainStateBuffer(simContext);
+    return_if(system->RankCount <= 1);
+
+    if (system->ReferenceState.Begin == NULL)
+        system->ReferenceState = span_New(system->ReferenceState, span_Length(*stateBuffer));
+    memcpy(system->ReferenceState.Begin, stateBuffer->Begin, span_ByteCount(*stateBuffer));
+}
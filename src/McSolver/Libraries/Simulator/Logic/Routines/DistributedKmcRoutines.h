@@ -0,0 +1,66 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	DistributedKmcRoutines.h	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Distributed (MPI) KMC       //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* Process environment routines */
+
+// Starts the distributed process environment and silences the stdout of all non-root ranks (Has an effect only in MC_MPIBUILD builds)
+void StartDistributedProcessEnvironment(void);
+
+// Finishes the distributed process environment (Has an effect only in MC_MPIBUILD builds)
+void FinishDistributedProcessEnvironment(void);
+
+// Get the number of ranks of the distributed process environment (One for non MPI builds)
+int32_t GetDistributedRankCount(void);
+
+// Checks if the calling process is the root rank that writes the simulation output (Always true for non MPI builds)
+bool_t IsDistributedRootRank(void);
+
+/* Initializer routines */
+
+// Assigns the rank information, the owned sector range and the boundary change logs to the passed sublattice system and releases the buffers that the rank does not require
+// (Returns an error if the sectors cannot be distributed onto the ranks)
+error_t SetDistributedSectorRangeOnSublatticeSystem(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system);
+
+/* Simulation routines */
+
+// Checks if the passed environment is owned by the rank or located in its halo and thus kept current (Always true if the distributed mode is inactive)
+bool_t IsEnvironmentInDistributedRankDomain(const KmcSublatticeSystem_t*restrict system, const EnvironmentState_t*restrict environment);
+
+// Checks if the passed environment is owned by the rank (Always true if the distributed mode is inactive)
+bool_t IsEnvironmentOwnedByDistributedRank(const KmcSublatticeSystem_t*restrict system, const EnvironmentState_t*restrict environment);
+
+// Logs the path environment changes of the last cycle of the passed context to the passed sector (Has an effect only on the boundary sectors of a rank in the distributed mode)
+void LogDistributedSectorPathChanges(SCONTEXT_PARAMETER, KmcSector_t*restrict sector);
+
+// Exchanges the logged changes of the boundary sectors with the two neighboring ranks and applies the received changes to the halo of the rank
+void ExchangeDistributedSublatticePhaseChanges(SCONTEXT_PARAMETER);
+
+// Sum reduces the passed int64 values over all ranks of the distributed mode
+void SumReduceDistributedInt64Values(const KmcSublatticeSystem_t*restrict system, int64_t*restrict values, int32_t count);
+
+// Sum reduces the passed double values over all ranks of the distributed mode
+void SumReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, int32_t count);
+
+// Max reduces the passed double values over all ranks of the distributed mode
+void MaxReduceDistributedDoubleValues(const KmcSublatticeSystem_t*restrict system, double*restrict values, int32_t count);
+
+// Copies the current main state buffer to the reference state of the distributed mode
+void SetDistributedReferenceState(SCONTEXT_PARAMETER);
+
+// Gathers the owned lattice occupations and reduces the counters, trackers and jump statistics of all ranks onto the root rank (Only the root rank holds the merged main state)
+void MergeDistributedSublatticeStates(SCONTEXT_PARAMETER);
+
+// Broadcasts the abort decision, the state flags and the meta data of the root rank to all ranks. Returns the abort decision of the root rank
+error_t BroadcastDistributedAbortDecision(SCONTEXT_PARAMETER, error_t abortFlag);
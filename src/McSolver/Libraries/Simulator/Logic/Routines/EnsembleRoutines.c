@@ -0,0 +1,256 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	EnsembleRoutines.c      	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC ensemble routines       //
+//////////////////////////////////////////
+
+#include <math.h>
+#include <pthread.h>
+#include "EnsembleRoutines.h"
+#include "Libraries/Framework/Basic/FileIO.h"
+#include "Libraries/ProgressPrint/ProgressPrint.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/StatisticsRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Initialization/CmdArgumentResolver.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
+
+// Defines the number of merged mobility observables per particle of the ensemble summary
+#define ENSEMBLE_OBSERVABLE_COUNT 5
+
+// Defines the output format of a merged observable as tag, unit, mean, standard error and relative standard error
+#define ENSEMBLE_SUMMARY_FORMAT "%-35s: [%-13s] %+.12e +/- %.3e (%.3e%%)\n"
+
+// Type for the member context pointer span of the ensemble. Member zero is the owner context
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(SimulationContext_t*, EnsembleMembers) EnsembleMembers_t;
+
+// Type for the shared data of the ensemble mode that is accessed by all ensemble worker threads
+typedef struct EnsembleRun
+{
+    // The member contexts of the ensemble
+    EnsembleMembers_t   Members;
+
+    // The I/O directory that contains the ensemble folders and the merged summary
+    char const*         BaseIoPath;
+
+    // The index of the next member that is not yet claimed by a worker
+    int32_t             NextMemberIndex;
+
+    // The number of members that were simulated by the workers
+    int32_t             RunMemberCount;
+
+    // The mutex that protects the member claiming
+    pthread_mutex_t     Mutex;
+
+} EnsembleRun_t;
+
+// Tag and unit strings of the merged observables in the order of the ensemble observable values
+static char const* const EnsembleObservableTags[ENSEMBLE_OBSERVABLE_COUNT][2] =
+{
+    {"Conductivity => Field direction", "S m^-1"},
+    {"Mobility => Field direction", "m^2 V^-1 s^-1"},
+    {"Mobility => Average migration rate", "Hz"},
+    {"Diffusion => D_Sigma (R^3)", "m^2 s^-1"},
+    {"Diffusion => D_Tracer (R^3)", "m^2 s^-1"}
+};
+
+// Checks that the ensemble mode is not combined with routines that cannot run on the member contexts
+static void AssertEnsembleIsSupported(SCONTEXT_PARAMETER)
+{
+    assert_true(JobInfoFlagsAreSet(simContext, INFO_FLG_KMC), ERR_CMDARGUMENT, "The ensemble mode requires a KMC job.");
+    assert_true(!simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive, ERR_CMDARGUMENT,
+                "The ensemble mode cannot be combined with the rejection-free or sublattice parallel KMC routines.");
+}
+
+// Constructs and initializes the member context with the passed id that shares the database model and the linking system of the passed owner context
+static SimulationContext_t* ConstructEnsembleMemberContext(SCONTEXT_PARAMETER, char const* baseIoPath, const int32_t memberId)
+{
+    SimulationContext_t* member = malloc(sizeof(SimulationContext_t));
+    assert_true(member != NULL, ERR_MEMALLOCATION, "Failed to allocate an ensemble member context.");
+    *member = ctor_SimulationContext();
+
+    var error = ResolveMocassinEnsembleMemberArguments(member, simContext, baseIoPath, memberId);
+    assert_success(error, "Failed to prepare the I/O directory of an ensemble member.");
+
+    // Note: The member only owns its mutable lattice state, the database model is already converted in place by the owner
+    member->DbModel = simContext->DbModel;
+    InitializeEnsembleMemberContextForSimulation(member, simContext, memberId);
+    SyncMainRoutineStartConditions(member);
+    return member;
+}
+
+// Runs the main routine on the member with the passed id if it is not completed
+static void RunMemberOfEnsemble(EnsembleRun_t*restrict run, const int32_t memberId)
+{
+    var member = span_Get(run->Members, memberId);
+    if (IsMainSimulationRoutineCompleted(member))
+    {
+        fprintf(stdout, "[Ensemble-Info]: Member %i is already completed.\n", memberId);
+        fflush(stdout);
+        return;
+    }
+
+    StartMainSimulationRoutine(member);
+    PrintMocassinSimulationFinishInfo(member, stdout);
+    fflush(stdout);
+
+    pthread_mutex_lock(&run->Mutex);
+    run->RunMemberCount++;
+    pthread_mutex_unlock(&run->Mutex);
+}
+
+// Claims the next member of the ensemble. Returns a negative member id if all members are claimed
+static int32_t ClaimNextMemberOfEnsemble(EnsembleRun_t*restrict run)
+{
+    pthread_mutex_lock(&run->Mutex);
+    let memberId = run->NextMemberIndex++;
+    pthread_mutex_unlock(&run->Mutex);
+    return (memberId < span_Length(run->Members)) ? memberId : -1;
+}
+
+// Ensemble worker thread entry that claims and runs members of the ensemble until all members are claimed
+static void* EnsembleWorkerThreadMain(void* args)
+{
+    EnsembleRun_t* run = args;
+    for (;;)
+    {
+        let memberId = ClaimNextMemberOfEnsemble(run);
+        break_if(memberId < 0);
+        RunMemberOfEnsemble(run, memberId);
+    }
+    return NULL;
+}
+
+// Runs all members of the ensemble on the set number of threads (One thread per member if not set), the calling thread acts as worker zero
+static void RunEnsembleMembers(EnsembleRun_t*restrict run, const int32_t setThreadCount)
+{
+    let memberCount = (int32_t) span_Length(run->Members);
+    let threadCount = (setThreadCount > 0) ? getMinOfTwo(setThreadCount, memberCount) : memberCount;
+    pthread_t threads[threadCount];
+    fprintf(stdout, "[Init-Info]: Running an ensemble of %i KMC walkers on %i threads in %s.\n", memberCount, threadCount, run->BaseIoPath);
+    fflush(stdout);
+
+    for (int32_t i = 1; i < threadCount; i++)
+    {
+        let error = pthread_create(&threads[i], NULL, EnsembleWorkerThreadMain, run) == 0 ? ERR_OK : ERR_UNKNOWN;
+        assert_success(error, "Failed to start a worker thread of the ensemble.");
+    }
+    EnsembleWorkerThreadMain(run);
+    for (int32_t i = 1; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+}
+
+// Gets the merged observable values from the passed mobility data in the order of the observable tags
+static void GetEnsembleObservableValues(const ParticleMobilityData_t*restrict data, double*restrict outValues)
+{
+    outValues[0] = data->TotalConductivity;
+    outValues[1] = data->TotalMobility;
+    outValues[2] = data->MigrationRate;
+    outValues[3] = data->TotalDSigma;
+    outValues[4] = data->TotalDTracer;
+}
+
+// Prints the mean and standard error of the mobility observables of the passed particle over all ensemble members to the passed stream
+static void PrintEnsembleParticleSummary(const EnsembleRun_t*restrict run, const byte_t particleId, const double particleCharge, file_t*restrict fstream)
+{
+    let memberCount = (int32_t) span_Length(run->Members);
+    double values[memberCount][ENSEMBLE_OBSERVABLE_COUNT];
+    int32_t particleCount = 0;
+
+    for (int32_t i = 0; i < memberCount; i++)
+    {
+        var statistics = (ParticleStatistics_t) { .ParticleId = particleId, .ParticleCharge = particleCharge };
+        PopulateParticleStatistics(span_Get(run->Members, i), &statistics);
+        var mobilityData = (ParticleMobilityData_t) { .ParticleStatistics = &statistics };
+        PopulateMobilityData(span_Get(run->Members, i), &mobilityData);
+        GetEnsembleObservableValues(&mobilityData, values[i]);
+        particleCount = statistics.ParticleCount;
+    }
+
+    fprintf(fstream, "<ENSEMBLE_DUMP ID=%i CHARGE=%+.2e COUNT=%i MEMBERS=%i>\n", particleId, particleCharge, particleCount, memberCount);
+    for (int32_t k = 0; k < ENSEMBLE_OBSERVABLE_COUNT; k++)
+    {
+        double mean = 0.0, variance = 0.0;
+        for (int32_t i = 0; i < memberCount; i++) mean += values[i][k];
+        mean /= memberCount;
+        for (int32_t i = 0; i < memberCount; i++) variance += (values[i][k] - mean) * (values[i][k] - mean);
+        variance /= (memberCount - 1);
+
+        // Note: The members are statistically independent, the standard error of the mean is the sample deviation over the square root of the member count
+        let standardError = sqrt(variance / memberCount);
+        let relativeError = (mean != 0.0) ? 100.0 * standardError / fabs(mean) : 0.0;
+        fprintf(fstream, ENSEMBLE_SUMMARY_FORMAT, EnsembleObservableTags[k][0], EnsembleObservableTags[k][1], mean, standardError, relativeError);
+    }
+    fprintf(fstream, "\n");
+}
+
+// Prints the merged summary of all mobile particles of the ensemble to the passed stream
+static void PrintEnsembleSummary(const EnsembleRun_t*restrict run, file_t*restrict fstream)
+{
+    let owner = span_Get(run->Members, 0);
+    let meta = getDbStructureModelMetaData(owner);
+    fprintf(fstream, "Ensemble summary of %i independent KMC walkers (mean +/- standard error):\n\n", (int32_t) span_Length(run->Members));
+    for (byte_t i = 1; isfinite(meta->ParticleCharges[i]); ++i)
+    {
+        continue_if(!ParticleIsMarkedAsMobile(owner, i));
+        PrintEnsembleParticleSummary(run, i, meta->ParticleCharges[i], fstream);
+    }
+    fflush(fstream);
+}
+
+// Prints the merged summary of the ensemble to stdout and writes it to the summary file in the base I/O directory
+static void WriteEnsembleSummary(const EnsembleRun_t*restrict run)
+{
+    char* filePath = NULL;
+    var error = ConcatStrings(run->BaseIoPath, "/" FILE_ENSEMBLELOG, &filePath);
+    assert_success(error, "Failed to build the ensemble summary file path.");
+
+    PrintEnsembleSummary(run, stdout);
+    var fstream = utf8fopen(filePath, FMODE_NORMAL_W);
+    assert_true(fstream != NULL, ERR_FILE, "Failed to open the ensemble summary file.");
+    PrintEnsembleSummary(run, fstream);
+    fclose(fstream);
+    free(filePath);
+}
+
+void StartEnsembleRoutine(SCONTEXT_PARAMETER)
+{
+    assert_true(GetDistributedRankCount() == 1, ERR_CMDARGUMENT, "The ensemble mode cannot be combined with the distributed mode.");
+    assert_true(!isParameterSweepModeRequested(simContext), ERR_CMDARGUMENT, "The ensemble mode cannot be combined with the parameter sweep mode.");
+
+    EnsembleRun_t run = {.BaseIoPath = getFileInformation(simContext)->IODirectoryPath, .NextMemberIndex = 0, .RunMemberCount = 0};
+    var error = pthread_mutex_init(&run.Mutex, NULL) == 0 ? ERR_OK : ERR_UNKNOWN;
+    assert_success(error, "Failed to create the member claiming mutex of the ensemble.");
+
+    // Note: The owner is initialized as a normal job in the first ensemble folder, all other members borrow its immutable data
+    error = ResolveMocassinEnsembleMemberArguments(simContext, NULL, run.BaseIoPath, 0);
+    assert_success(error, "Failed to prepare the I/O directory of an ensemble member.");
+    PrepareSimulationContextForMainRoutine(simContext);
+    AssertEnsembleIsSupported(simContext);
+
+    run.Members = span_New(run.Members, getEnsembleCount(simContext));
+    span_Get(run.Members, 0) = simContext;
+    for (int32_t memberId = 1; memberId < span_Length(run.Members); memberId++)
+        span_Get(run.Members, memberId) = ConstructEnsembleMemberContext(simContext, run.BaseIoPath, memberId);
+
+    RunEnsembleMembers(&run, getCommandArgumentOverwrites(simContext)->BatchThreadCount);
+    fprintf(stdout, "[Ensemble-Info]: Finished an ensemble of %i KMC walkers (%i simulated in this run).\n\n",
+            (int32_t) span_Length(run.Members), run.RunMemberCount);
+    WriteEnsembleSummary(&run);
+
+    cpp_offset_foreach(member, run.Members, 1)
+    {
+        DeleteSimulationContextDynamicBuffers(*member);
+        DeleteMocassinEnsembleMemberArguments(*member);
+        free(*member);
+    }
+    span_Delete(run.Members);
+    pthread_mutex_destroy(&run.Mutex);
+}
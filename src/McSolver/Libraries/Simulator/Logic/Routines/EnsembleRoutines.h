@@ -0,0 +1,20 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	EnsembleRoutines.h      	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC ensemble routines       //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* KMC ensemble routine */
+
+// Runs the set number of independent KMC walkers of one job on concurrent threads. Each walker is simulated to its own ensemble folder below the I/O directory,
+// the merged summary with standard errors is written to the I/O directory (Requires a loaded database model, existing ensemble folders resume their walker)
+void StartEnsembleRoutine(SCONTEXT_PARAMETER);
@@ -13,6 +13,7 @@
 #include "Libraries/Simulator/Logic/Helper/Constants.h"
 #include "HelperRoutines.h"
 #include "StatisticsRoutines.h"
+#include "DistributedKmcRoutines.h"
 #include "EnvironmentRoutines.h"
 
 /* Local helper routines */
@@ -485,14 +486,18 @@ void ResynchronizeEnvironmentEnergyStatus(SCONTEXT_PARAMETER)
     error = AllocateDynamicEnvOccupationBuffer(simContext, &occupationBuffer);
     assert_success(error, "Buffer creation for environment occupation lookup failed.");
 
+    // Note: A rank of the distributed KMC mode only holds the energy status of its domain, the energies of the owned environments are summed over all ranks
+    let sublatticeSystem = getKmcSublatticeSystem(simContext);
     cpp_foreach (envState, *getEnvironmentLattice(simContext))
     {
+        continue_if(!IsEnvironmentInDistributedRankDomain(sublatticeSystem, envState));
         let envId = getEnvironmentStateIdByPointer(simContext, envState);
         error = DynamicLookupEnvironmentStatus(simContext, envId, &occupationBuffer);
         assert_success(error, "Dynamic lookup of environment occupation and energy failed.");
-        continue_if(!envState->IsStable);
+        continue_if(!envState->IsStable || !IsEnvironmentOwnedByDistributedRank(sublatticeSystem, envState));
         energy += GetEnvironmentStateEnergy(envState);
     }
+    SumReduceDistributedDoubleValues(sublatticeSystem, &energy, 1);
     metaData->LatticeEnergy = energy * physicalFactors->EnergyFactorKtToEv * 0.5;
     span_Delete(occupationBuffer);
 }
@@ -749,23 +754,35 @@ void LoadKmcTransitionDeltaBackup(SCONTEXT_PARAMETER)
         LoadFinalStateEnergyBackup(simContext, i);
 }
 
-// Performs the action to set all KMC states in cases where the S2 bias correction is not static and requires dynamic calculation
-static void inline KMC_SetStateEnergiesWithDynamicCorrection(SCONTEXT_PARAMETER)
+// Performs the action to set the KMC final state in cases where the S2 bias correction is not static and requires dynamic calculation
+static void inline KMC_SetFinalStateEnergyWithDynamicCorrection(SCONTEXT_PARAMETER)
 {
-    SetKmcStartTransitionBaseAndFieldEnergyStatesOnContext(simContext);
     CreateAndBackupKmcTransitionDelta(simContext);
     SetFinalKmcStateEnergyOnContext(simContext);
     LoadKmcTransitionDeltaBackup(simContext);
 }
 
+// Adds the known constant S2 bias correction of the active jump rule to the uncorrected final state energy
+static void inline KMC_AddStaticFinalStateEnergyCorrection(SCONTEXT_PARAMETER)
+{
+    let jumpRule = getActiveJumpRule(simContext);
+    let energies = getJumpEnergyInfo(simContext);
+    energies->S2Energy += jumpRule->StaticVirtualJumpEnergyCorrection;
+}
+
+// Performs the action to set all KMC states in cases where the S2 bias correction is not static and requires dynamic calculation
+static void inline KMC_SetStateEnergiesWithDynamicCorrection(SCONTEXT_PARAMETER)
+{
+    SetKmcStartTransitionBaseAndFieldEnergyStatesOnContext(simContext);
+    KMC_SetFinalStateEnergyWithDynamicCorrection(simContext);
+}
+
 // Performs the action to set all KMC states in cases where the S2 bias correction is a known constant value
 static void inline KMC_SetStateEnergiesWithStaticCorrection(SCONTEXT_PARAMETER)
 {
     SetKmcStartTransitionBaseAndFieldEnergyStatesOnContext(simContext);
     SetFinalKmcStateEnergyOnContext(simContext);
-    let jumpRule = getActiveJumpRule(simContext);
-    let energies = getJumpEnergyInfo(simContext);
-    energies->S2Energy += jumpRule->StaticVirtualJumpEnergyCorrection;
+    KMC_AddStaticFinalStateEnergyCorrection(simContext);
 }
 
 void SetKmcStateEnergiesOnContext(SCONTEXT_PARAMETER)
@@ -777,6 +794,15 @@ void SetKmcStateEnergiesOnContext(SCONTEXT_PARAMETER)
         KMC_SetStateEnergiesWithStaticCorrection(simContext);
 }
 
+void SetCorrectedFinalKmcStateEnergyOnContext(SCONTEXT_PARAMETER)
+{
+    let jumpRule = getActiveJumpRule(simContext);
+    if (jumpRule->StaticVirtualJumpEnergyCorrection == JUMPS_JUMPCORRECTION_NOTSTATIC)
+        KMC_SetFinalStateEnergyWithDynamicCorrection(simContext);
+    else
+        KMC_AddStaticFinalStateEnergyCorrection(simContext);
+}
+
 //  Adds the current energy contribution to state S0 and S1 for a path id to the energy info
 static inline void AddPathStateS0AndS1EnergyByPathId(SCONTEXT_PARAMETER, const int32_t pathId, JumpRule_t*restrict jumpRule, JumpEnergyInfo_t*restrict energyInfo)
 {
@@ -989,4 +1015,11 @@ void AdvanceMmcSystemToFinalState(SCONTEXT_PARAMETER)
     envState0->ParticleId = newParticleId0;
     DistributeEnvironmentUpdate(simContext, envState1, newParticleId1);
     envState1->ParticleId = newParticleId1;
-}
\ No newline at end of file
+}
+
+void SetEnvironmentStateParticleId(SCONTEXT_PARAMETER, EnvironmentState_t*restrict environment, const byte_t particleId)
+{
+    return_if(environment->ParticleId == particleId);
+    DistributeEnvironmentUpdate(simContext, environment, particleId);
+    environment->ParticleId = particleId;
+}
@@ -40,6 +40,9 @@ void SetKmcStartTransitionBaseAndFieldEnergyStatesOnContext(SCONTEXT_PARAMETER);
 // Sets the state energy S2 for the current KMC transition on the main cycle state
 void SetFinalKmcStateEnergyOnContext(SCONTEXT_PARAMETER);
 
+// Applies the S2 bias correction of the active jump rule to the uncorrected state energy S2 that is already set on the main cycle state
+void SetCorrectedFinalKmcStateEnergyOnContext(SCONTEXT_PARAMETER);
+
 // Advances the system to the final state using the currently active KMC transition
 void AdvanceKmcSystemToFinalState(SCONTEXT_PARAMETER);
 
@@ -61,4 +64,9 @@ void SetMmcStartStateEnergyOnContext(SCONTEXT_PARAMETER);
 void SetMmcFinalStateEnergyOnContext(SCONTEXT_PARAMETER);
 
 // Advances the system to the final state using the currently active MMC transition
-void AdvanceMmcSystemToFinalState(SCONTEXT_PARAMETER);
\ No newline at end of file
+void AdvanceMmcSystemToFinalState(SCONTEXT_PARAMETER);
+
+/* Simulation routines shared */
+
+// Sets the particle id of the passed environment state and distributes the occupation change to all linked environments (Uses the active work environment of the cycle state)
+void SetEnvironmentStateParticleId(SCONTEXT_PARAMETER, EnvironmentState_t*restrict environment, byte_t particleId);
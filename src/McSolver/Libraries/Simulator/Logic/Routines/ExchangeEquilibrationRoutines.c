@@ -0,0 +1,162 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ExchangeEquilibrationRoutines.c	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC exchange equilibration  //
+//////////////////////////////////////////
+
+#include <math.h>
+#include "ExchangeEquilibrationRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/EnvironmentRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/JumpSelectionRoutines.h"
+
+/* Local helper routines */
+
+// Checks if the passed environment can take part in an exchange. Only stable centers that take part in the KMC transitions are exchanged
+static inline bool_t EnvironmentCanBeExchanged(const EnvironmentState_t*restrict environment)
+{
+    return environment->IsMobile && environment->IsStable;
+}
+
+// Creates the id span of all environments that can take part in an exchange. The set does not change as exchanges keep all centers mobile
+static IdMappingSpan_t CollectExchangeEnvironmentIds(SCONTEXT_PARAMETER)
+{
+    IdMappingSpan_t result;
+    int32_t count = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+        count += EnvironmentCanBeExchanged(environment);
+
+    result = span_New(result, count);
+    count = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        continue_if(!EnvironmentCanBeExchanged(environment));
+        span_Get(result, count++) = getEnvironmentStateIdByPointer(simContext, environment);
+    }
+    return result;
+}
+
+// Checks if an occupation change on the first environment updates the energy states of the second environment
+static bool_t EnvironmentsAreLinked(SCONTEXT_PARAMETER, const EnvironmentState_t*restrict lhs, const EnvironmentState_t*restrict rhs)
+{
+    return_if(!PositionAreInInteractionRange(simContext, &lhs->LatticeVector, &rhs->LatticeVector), false);
+
+    let rhsId = getEnvironmentStateIdByPointer(simContext, rhs);
+    cpp_foreach(environmentLink, lhs->EnvironmentLinks)
+        return_if(environmentLink->TargetEnvironmentId == rhsId, true);
+
+    return false;
+}
+
+// Swaps the mobile trackers of two environments after an exchange so that the trackers stay assigned to their particles
+static void SwapExchangedMobileTrackers(SCONTEXT_PARAMETER, EnvironmentState_t*restrict lhs, EnvironmentState_t*restrict rhs)
+{
+    var trackerMapping = getMobileTrackerMapping(simContext);
+    let trackerId = lhs->MobileTrackerId;
+    lhs->MobileTrackerId = rhs->MobileTrackerId;
+    rhs->MobileTrackerId = trackerId;
+
+    if (lhs->MobileTrackerId > INVALID_INDEX) span_Get(*trackerMapping, lhs->MobileTrackerId) = getEnvironmentStateIdByPointer(simContext, lhs);
+    if (rhs->MobileTrackerId > INVALID_INDEX) span_Get(*trackerMapping, rhs->MobileTrackerId) = getEnvironmentStateIdByPointer(simContext, rhs);
+}
+
+// Tries to exchange the particles of two environments using the Metropolis criterion. Returns true and the energy change in [kT] if the exchange is accepted
+static bool_t TryExchangeEnvironmentParticles(SCONTEXT_PARAMETER, EnvironmentState_t*restrict lhs, EnvironmentState_t*restrict rhs, double*restrict outEnergyChange)
+{
+    let particleId0 = lhs->ParticleId;
+    let particleId1 = rhs->ParticleId;
+    let isLinked = EnvironmentsAreLinked(simContext, lhs, rhs);
+    var energyChange = span_Get(lhs->EnergyStates, particleId1) - span_Get(lhs->EnergyStates, particleId0);
+
+    // Note: The change of the first environment alters the energy states of a linked partner, thus it is applied before the partner contribution is evaluated
+    if (isLinked) SetEnvironmentStateParticleId(simContext, lhs, particleId1);
+    energyChange += span_Get(rhs->EnergyStates, particleId0) - span_Get(rhs->EnergyStates, particleId1);
+
+    if ((energyChange > 0.0) && (exp(-energyChange) < GetNextRandomDoubleFromContextRng(simContext)))
+    {
+        if (isLinked) SetEnvironmentStateParticleId(simContext, lhs, particleId0);
+        return false;
+    }
+
+    if (!isLinked) SetEnvironmentStateParticleId(simContext, lhs, particleId1);
+    SetEnvironmentStateParticleId(simContext, rhs, particleId0);
+    SwapExchangedMobileTrackers(simContext, lhs, rhs);
+
+    JUMPPATH[0] = lhs;
+    JUMPPATH[1] = rhs;
+    UpdateTransitionPoolAfterMmcSystemAdvance(simContext);
+
+    *outEnergyChange = energyChange;
+    return true;
+}
+
+// Writes the passed window energy change in [kT] to the moving sequence buffer and updates the current sum in [eV] if the buffer is full
+static void PushWindowEnergyToSequenceBuffer(SCONTEXT_PARAMETER, Flp64Buffer_t*restrict buffer, const double energy, const int64_t windowId)
+{
+    let capacity = buffer->CapacityEnd - buffer->Begin;
+    if (buffer->End != buffer->CapacityEnd)
+        list_PushBack(*buffer, energy);
+    else
+        buffer->Begin[windowId % capacity] = energy;
+    return_if(buffer->End != buffer->CapacityEnd);
+
+    buffer->LastSum = buffer->CurrentSum;
+    buffer->CurrentSum = 0.0;
+    cpp_foreach(value, *buffer) buffer->CurrentSum += *value;
+    buffer->CurrentSum *= getPhysicalFactors(simContext)->EnergyFactorKtToEv;
+}
+
+/* Initializer routines */
+
+void RunKmcExchangeEquilibration(SCONTEXT_PARAMETER)
+{
+    let tolerance = getKmcEquilibrationTolerance(simContext);
+    return_if(tolerance <= 0.0 || !JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) || !StateFlagsAreSet(simContext, STATE_FLG_FIRSTCYCLE));
+
+    var environmentIds = CollectExchangeEnvironmentIds(simContext);
+    let environmentCount = (int32_t) span_Length(environmentIds);
+    let factors = getPhysicalFactors(simContext);
+    var latticeEnergy = &getMainStateMetaData(simContext)->LatticeEnergy;
+    let startEnergy = *latticeEnergy;
+    let attemptLimit = KMC_EQUILIBRATION_SWEEPLIMIT * environmentCount;
+    int64_t attemptCount = 0, acceptCount = 0, windowCount = 0, windowId = 0;
+    double windowEnergy = 0.0;
+    bool_t isRelaxed = false;
+
+    Buffer_t tmp = span_New(tmp, KMC_EQUILIBRATION_SEQUENCELENGTH * sizeof(double));
+    Flp64Buffer_t sequenceBuffer = {.Begin = (void*) tmp.Begin, .End = (void*) tmp.Begin, .CapacityEnd = (void*) tmp.End, .LastSum = INFINITY, .CurrentSum = INFINITY};
+
+    for (;(attemptCount < attemptLimit) && !isRelaxed && (environmentCount > 1); ++attemptCount)
+    {
+        var lhs = getEnvironmentStateAt(simContext, span_Get(environmentIds, GetNextCeiledRandomFromContextRng(simContext, environmentCount)));
+        var rhs = getEnvironmentStateAt(simContext, span_Get(environmentIds, GetNextCeiledRandomFromContextRng(simContext, environmentCount)));
+        continue_if((lhs->ParticleId == rhs->ParticleId) || (lhs->EnvironmentDefinition != rhs->EnvironmentDefinition));
+
+        double energyChange;
+        continue_if(!TryExchangeEnvironmentParticles(simContext, lhs, rhs, &energyChange));
+
+        ++acceptCount;
+        windowEnergy += energyChange;
+        *latticeEnergy += factors->EnergyFactorKtToEv * energyChange;
+        continue_if(++windowCount < environmentCount);
+
+        // Note: Equal to the MMC energy relaxation abort, the energy drift over the moving sequence of windows has to be within the relative tolerance of the lattice energy
+        PushWindowEnergyToSequenceBuffer(simContext, &sequenceBuffer, windowEnergy, windowId++);
+        isRelaxed = isfinite(sequenceBuffer.CurrentSum) && (fabs(sequenceBuffer.CurrentSum) <= fabs(*latticeEnergy * tolerance));
+        windowEnergy = 0.0;
+        windowCount = 0;
+    }
+
+    // Note: The immobile centers do not receive energy updates, the resynchronization restores them and removes the rounding drift
+    ResynchronizeEnvironmentEnergyStatus(simContext);
+    span_Delete(environmentIds);
+    span_Delete(tmp);
+
+    printf("[Init-Info]: KMC exchange equilibration %s [ATTEMPTS=" FORMAT_I64() ", ACCEPTED=" FORMAT_I64() ", E_START=%+.6e eV, E_END=%+.6e eV]\n",
+           isRelaxed ? "RELAXED" : "LIMITED", attemptCount, acceptCount, startEnergy, *latticeEnergy);
+}
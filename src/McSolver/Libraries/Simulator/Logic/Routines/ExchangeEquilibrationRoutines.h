@@ -0,0 +1,20 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ExchangeEquilibrationRoutines.h	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC exchange equilibration  //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* Initializer routines */
+
+// Equilibrates the lattice of a new KMC simulation by Metropolis exchanges of the mobile species until the energy fluctuation criterion is met
+// (Has an effect only for KMC jobs without a loaded state if an equilibration tolerance is set, requires the linking system and synchronized energies)
+void RunKmcExchangeEquilibration(SCONTEXT_PARAMETER);
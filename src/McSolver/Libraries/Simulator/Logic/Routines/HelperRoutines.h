@@ -148,6 +148,33 @@ static inline int32_t GetParticleCountInLattice(SCONTEXT_PARAMETER, const byte_t
     return result;
 }
 
+// Checks if a particle id is potentially marked as mobile in any stable environment definition
+static inline bool_t ParticleIsMarkedAsMobile(SCONTEXT_PARAMETER, const byte_t particleId)
+{
+    let jumpCountTable = getJumpCountMapping(simContext);
+    int32_t dimensions[] = {0, 0};
+    GetArrayDimensions((VoidArray_t*) jumpCountTable, dimensions);
+    for (int32_t posId = 0; posId < dimensions[0]; ++posId)
+    {
+        let envState = getEnvironmentStateAt(simContext, posId);
+        if (!envState->IsStable) continue;
+
+        var canExistOnPosition = false;
+        c_foreach(id, envState->EnvironmentDefinition->PositionParticleIds)
+        {
+            if (*id != particleId) continue;
+            canExistOnPosition = true;
+        }
+        if (canExistOnPosition)
+        {
+            let jumpCount = array_Get(*jumpCountTable, posId, particleId);
+            if (jumpCount != JPOOL_DIRCOUNT_STATIC) return true;
+        }
+    }
+
+    return false;
+}
+
 // Get the currently valid energy value of the passed environment state in units of [kT]
 static inline double GetEnvironmentStateEnergy(const EnvironmentState_t* restrict envState)
 {
@@ -166,6 +193,12 @@ static inline int32_t GetNextCeiledRandomFromContextRng(SCONTEXT_PARAMETER, cons
     return Pcg32NextCeiledRandom(getMainRng(simContext), upperLimit);
 }
 
+// Get a bounded random number from [0...upperLimit) from the main RNG without a division in the common case
+static inline int32_t GetNextBoundedRandomFromContextRng(SCONTEXT_PARAMETER, const int32_t upperLimit)
+{
+    return (int32_t) Pcg32NextBoundedRandom(getMainRng(simContext), (uint32_t) upperLimit);
+}
+
 // Checks if the passed pair table is constant and has always the same energy value independent of context
 bool_t CheckPairEnergyTableIsConstant(SCONTEXT_PARAMETER, const PairTable_t *restrict table);
 
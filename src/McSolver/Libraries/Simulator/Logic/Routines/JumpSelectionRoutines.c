@@ -20,12 +20,99 @@ static inline bool_t EnvironmentIsSelectable(const EnvironmentState_t*restrict e
     return flagsAreTrue(environment->EnvironmentDefinition->SelectionParticleMask, 1 << environment->ParticleId);
 }
 
+// Get the direction pool mapping index of the passed jump count and particle id (The particle id is ignored if the pools are not grouped)
+static inline int32_t GetDirectionPoolMappingIndex(const JumpSelectionPool_t *restrict selectionPool, const int32_t jumpCount, const byte_t particleId)
+{
+    return jumpCount + particleId * selectionPool->ParticlePoolStride;
+}
+
+// Counts the set bits of the passed jump slot mask
+static inline int32_t CountJumpSlotMaskBits(uint64_t mask)
+{
+    int32_t count = 0;
+    for (; mask != 0; ++count) mask &= mask - 1;
+    return count;
+}
+
+// Get the relative jump id of the set bit of the passed jump slot mask with the passed rank (Rank zero is the lowest set bit)
+static inline int32_t FindJumpSlotMaskBitByRank(uint64_t mask, int32_t rank)
+{
+    debug_assert(rank < CountJumpSlotMaskBits(mask));
+    for (; rank > 0; --rank) mask &= mask - 1;
+
+    int32_t relativeJumpId = 0;
+    for (; (mask & 1ULL) == 0; mask >>= 1) ++relativeJumpId;
+    return relativeJumpId;
+}
+
+// Get the jump slot mask of the passed environment state
+static inline uint64_t* GetJumpSlotMaskOf(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment)
+{
+    return getJumpSlotMaskAt(simContext, getEnvironmentStateIdByPointer(simContext, environment));
+}
+
+// Checks if the passed relative jump of the passed environment has a jump rule for the current occupation of the jump path
+static bool_t JumpSlotHasMatchingJumpRule(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment, const int32_t relativeJumpId)
+{
+    let latticeSizes = getLatticeSizeVector(simContext);
+    let jumpId = array_Get(*getJumpDirectionMapping(simContext), environment->LatticeVector.D, environment->ParticleId, relativeJumpId);
+    let jumpDirection = getJumpDirectionAt(simContext, jumpId);
+    let jumpCollection = getJumpCollectionAt(simContext, jumpDirection->JumpCollectionId);
+    OccupationCode64_t stateCode = { .Value = 0ULL };
+
+    // Note: The code is built equal to the KMC path construction but the path ids of the environments are not changed
+    SetOccupationCodeByteAt(&stateCode, 0, environment->ParticleId);
+    for (int32_t i = 0; i < span_Length(jumpDirection->JumpSequence); i++)
+    {
+        let vector = AddAndTrimVector4(&environment->LatticeVector, &span_Get(jumpDirection->JumpSequence, i), latticeSizes);
+        SetOccupationCodeByteAt(&stateCode, i + 1, getEnvironmentStateByVector4(simContext, &vector)->ParticleId);
+    }
+
+    cpp_foreach(jumpRule, jumpCollection->JumpRules)
+        return_if(jumpRule->StateCode0.Value == stateCode.Value, true);
+    return false;
+}
+
+// Evaluates the jump slot mask of the passed environment state for the current lattice occupation
+static uint64_t EvaluateJumpSlotMask(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment)
+{
+    return_if(!environment->IsStable || !EnvironmentIsSelectable(environment), 0ULL);
+    let jumpCount = getJumpCountAt(simContext, environment->LatticeVector.D, environment->ParticleId);
+    uint64_t mask = 0ULL;
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; relativeJumpId++)
+    {
+        if (JumpSlotHasMatchingJumpRule(simContext, environment, relativeJumpId))
+            mask |= 1ULL << relativeJumpId;
+    }
+    return mask;
+}
+
+// Get the number of currently selectable jumps of the passed environment (The jump count table is ignored if the selection masks are active)
+static inline int32_t GetSelectableJumpCount(SCONTEXT_PARAMETER, const JumpCountTable_t *restrict jumpCountTable, const EnvironmentState_t *restrict environment)
+{
+    return_if(simContext->IsKmcSelectionMaskActive, CountJumpSlotMaskBits(*GetJumpSlotMaskOf(simContext, environment)));
+    return array_Get(*jumpCountTable, environment->LatticeVector.D, environment->ParticleId);
+}
+
 // Translates the passed environment state into the index of the required environment pool or an invalid index if not selectable
-static inline int32_t GetEnvironmentPoolId(JumpSelectionPool_t *restrict selectionPool, const JumpCountTable_t *restrict jumpCountTable, const EnvironmentState_t *restrict environment)
+static inline int32_t GetEnvironmentPoolId(SCONTEXT_PARAMETER, JumpSelectionPool_t *restrict selectionPool, const JumpCountTable_t *restrict jumpCountTable, const EnvironmentState_t *restrict environment)
 {
     return_if(!EnvironmentIsSelectable(environment), INVALID_INDEX);
-    let jumpCount = array_Get(*jumpCountTable, environment->LatticeVector.D, environment->ParticleId);
-    return span_Get(selectionPool->DirectionPoolMapping, jumpCount);
+    let jumpCount = GetSelectableJumpCount(simContext, jumpCountTable, environment);
+
+    // Note: With active selection masks a selectable particle can have no jump with a valid rule, the environment is then removed from the pools
+    return_if(simContext->IsKmcSelectionMaskActive && jumpCount == 0, JPOOL_NOT_SELECTABLE);
+    return span_Get(selectionPool->DirectionPoolMapping, GetDirectionPoolMappingIndex(selectionPool, jumpCount, environment->ParticleId));
+}
+
+// Calculates the weighted selectable jump count of the passed selection pool from the direction pool states
+static inline double CalculateWeightedJumpCount(const JumpSelectionPool_t *restrict selectionPool)
+{
+    double result = 0.0;
+    cpp_offset_foreach(directionPool, selectionPool->DirectionPools, 1)
+        result += directionPool->SelectionWeight * (double) directionPool->JumpCount;
+    return result;
 }
 
 // Adds the passed id to the enf of the passed direction pool without any counter updates
@@ -57,12 +144,220 @@ static inline void UpdateEnvStateSelectionStatus(EnvironmentState_t* restrict en
     environment->PoolPositionId = poolPositionId;
 }
 
+// Adds the jump slots [slotBegin, slotEnd) of the passed environment id to the end of the flat jump slot table
+static inline void AddFlatJumpSlots(JumpSelectionPool_t *restrict selectionPool, const int32_t environmentId, const int32_t slotBegin, const int32_t slotEnd)
+{
+    var slotIds = &span_Get(selectionPool->JumpSlotIds, environmentId * selectionPool->JumpSlotStride);
+    for (int32_t i = slotBegin; i < slotEnd; i++)
+    {
+        debug_assert(!list_IsFull(selectionPool->JumpSlotTable));
+        slotIds[i] = (int32_t) span_Length(selectionPool->JumpSlotTable);
+        list_PushBack(selectionPool->JumpSlotTable, ((JumpSlot_t) {.EnvironmentId = environmentId, .RelativeJumpId = i}));
+    }
+}
+
+// Removes the jump slots [slotBegin, slotEnd) of the passed environment id from the flat jump slot table by replacing each slot with the last one
+static inline void RemoveFlatJumpSlots(JumpSelectionPool_t *restrict selectionPool, const int32_t environmentId, const int32_t slotBegin, const int32_t slotEnd)
+{
+    let slotIds = &span_Get(selectionPool->JumpSlotIds, environmentId * selectionPool->JumpSlotStride);
+    for (int32_t i = slotEnd - 1; i >= slotBegin; i--)
+    {
+        let movedSlot = list_PopBack(selectionPool->JumpSlotTable);
+        span_Get(selectionPool->JumpSlotTable, slotIds[i]) = movedSlot;
+        span_Get(selectionPool->JumpSlotIds, movedSlot.EnvironmentId * selectionPool->JumpSlotStride + movedSlot.RelativeJumpId) = slotIds[i];
+    }
+}
+
+// Adds or removes the jump slots of the passed environment in the flat jump slot table if the selectable jump count changed (Has an effect only if the table is active)
+static inline void UpdateFlatJumpSlots(SCONTEXT_PARAMETER, JumpSelectionPool_t *restrict selectionPool, const EnvironmentState_t *restrict environment, const int32_t oldJumpCount, const int32_t newJumpCount)
+{
+    return_if(!simContext->IsFlatJumpSlotTableActive);
+    let envId = getEnvironmentStateIdByPointer(simContext, environment);
+
+    // Note: The slots of an environment are always the relative jump ids [0, jumpCount), thus only the difference has to be added or removed
+    if (newJumpCount > oldJumpCount)
+        AddFlatJumpSlots(selectionPool, envId, oldJumpCount, newJumpCount);
+    else
+        RemoveFlatJumpSlots(selectionPool, envId, newJumpCount, oldJumpCount);
+}
+
+// Get the MMC particle pool id of the passed position id and particle id
+static inline int32_t GetMmcParticlePoolId(const int32_t positionId, const byte_t particleId)
+{
+    return positionId * PARTICLE_IDLIMIT + particleId;
+}
+
+// Defines the pool count changes of an exchange [startPool, startTargetPool, partnerPool, partnerTargetPool]
+static const int64_t MmcExchangePoolDeltas[4] = { -1, +1, -1, +1 };
+
+// Get the current entry count of the passed particle pool
+static inline int64_t GetMmcParticlePoolCount(const MmcPartnerSystem_t *restrict partnerSystem, const int32_t poolId)
+{
+    return (int64_t) span_Length(span_Get(partnerSystem->ParticlePools, poolId).EnvironmentPool);
+}
+
+// Get the number of valid exchange partners of the passed jump direction and start particle
+static int64_t CountMmcDirectionPartners(SCONTEXT_PARAMETER, const int32_t jumpId, const byte_t particleId)
+{
+    let partnerSystem = getMmcPartnerSystem(simContext);
+    let positionId = getJumpDirectionAt(simContext, jumpId)->JumpSequence.Begin->D;
+    var partnerMask = span_Get(partnerSystem->PartnerParticleMasks, jumpId * PARTICLE_IDLIMIT + particleId);
+    int64_t result = 0;
+
+    for (byte_t partnerId = 0; partnerMask != 0; ++partnerId, partnerMask >>= 1)
+    {
+        continue_if((partnerMask & 1ULL) == 0);
+        result += GetMmcParticlePoolCount(partnerSystem, GetMmcParticlePoolId(positionId, partnerId));
+    }
+    return result;
+}
+
+// Get the number of valid exchange partners summed over all jump directions of one environment of the passed start pool
+static int64_t CountMmcStartPoolPartners(SCONTEXT_PARAMETER, const int32_t poolId)
+{
+    let jumpMapping = getJumpDirectionMapping(simContext);
+    let positionId = poolId / PARTICLE_IDLIMIT;
+    let particleId = (byte_t) (poolId % PARTICLE_IDLIMIT);
+    let jumpCount = getMmcParticlePoolAt(simContext, poolId)->JumpCount;
+    int64_t result = 0;
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; relativeJumpId++)
+        result += CountMmcDirectionPartners(simContext, array_Get(*jumpMapping, positionId, particleId, relativeJumpId), particleId);
+    return result;
+}
+
+// Get the change of the partner count of one environment of the passed start pool by the passed exchange (Zero if the pool is not a start pool)
+static int64_t GetMmcStartPoolPartnerCountChange(SCONTEXT_PARAMETER, const int32_t poolId, const int32_t *restrict exchangePoolIds)
+{
+    let partnerSystem = getMmcPartnerSystem(simContext);
+    let jumpMapping = getJumpDirectionMapping(simContext);
+    let positionId = poolId / PARTICLE_IDLIMIT;
+    let particleId = (byte_t) (poolId % PARTICLE_IDLIMIT);
+    let jumpCount = getMmcParticlePoolAt(simContext, poolId)->JumpCount;
+    int64_t result = 0;
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; relativeJumpId++)
+    {
+        let jumpId = array_Get(*jumpMapping, positionId, particleId, relativeJumpId);
+        let partnerPositionId = getJumpDirectionAt(simContext, jumpId)->JumpSequence.Begin->D;
+        let partnerMask = span_Get(partnerSystem->PartnerParticleMasks, jumpId * PARTICLE_IDLIMIT + particleId);
+        for (int32_t i = 0; i < 4; i++)
+        {
+            continue_if(exchangePoolIds[i] / PARTICLE_IDLIMIT != partnerPositionId);
+            continue_if((partnerMask & (1ULL << (exchangePoolIds[i] % PARTICLE_IDLIMIT))) == 0);
+            result += MmcExchangePoolDeltas[i];
+        }
+    }
+    return result;
+}
+
+// Adds the passed value to the target counts of all partner pools that are reached by the jump directions of one environment of the passed start pool
+static void AddToMmcPartnerPoolTargetCounts(SCONTEXT_PARAMETER, const int32_t poolId, const int64_t value)
+{
+    let partnerSystem = getMmcPartnerSystem(simContext);
+    let jumpMapping = getJumpDirectionMapping(simContext);
+    let positionId = poolId / PARTICLE_IDLIMIT;
+    let particleId = (byte_t) (poolId % PARTICLE_IDLIMIT);
+    let jumpCount = getMmcParticlePoolAt(simContext, poolId)->JumpCount;
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; relativeJumpId++)
+    {
+        let jumpId = array_Get(*jumpMapping, positionId, particleId, relativeJumpId);
+        let partnerPositionId = getJumpDirectionAt(simContext, jumpId)->JumpSequence.Begin->D;
+        var partnerMask = span_Get(partnerSystem->PartnerParticleMasks, jumpId * PARTICLE_IDLIMIT + particleId);
+        for (byte_t partnerId = 0; partnerMask != 0; ++partnerId, partnerMask >>= 1)
+        {
+            continue_if((partnerMask & 1ULL) == 0);
+            getMmcParticlePoolAt(simContext, GetMmcParticlePoolId(partnerPositionId, partnerId))->TargetCount += value;
+        }
+    }
+}
+
+// Calculates the change of the number of valid exchanges and start jumps by the passed exchange using the maintained partner and target counts
+static void CalculateMmcExchangeCountChanges(SCONTEXT_PARAMETER, const int32_t *restrict exchangePoolIds, int64_t *restrict outExchangeDelta, int64_t *restrict outStartJumpDelta)
+{
+    *outExchangeDelta = 0;
+    *outStartJumpDelta = 0;
+
+    // Note: The exchange count is the sum of startCount * partnerCount, thus the four changed pools contribute their partner and target counts and the pair term of the changed pools
+    for (int32_t i = 0; i < 4; i++)
+    {
+        let particlePool = getMmcParticlePoolAt(simContext, exchangePoolIds[i]);
+        let partnerCountChange = GetMmcStartPoolPartnerCountChange(simContext, exchangePoolIds[i], exchangePoolIds);
+        *outExchangeDelta += MmcExchangePoolDeltas[i] * (particlePool->PartnerCount + particlePool->TargetCount + partnerCountChange);
+        *outStartJumpDelta += MmcExchangePoolDeltas[i] * particlePool->JumpCount;
+    }
+}
+
+// Calculates the number of valid exchanges and start jumps and the partner and target counts of all pools from the current pool state
+static void InitializeMmcExchangeCounts(SCONTEXT_PARAMETER)
+{
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    partnerSystem->ExchangeCount = 0;
+    partnerSystem->StartJumpCount = 0;
+
+    cpp_foreach(particlePool, partnerSystem->ParticlePools) particlePool->TargetCount = 0;
+    cpp_foreach(poolId, partnerSystem->StartPoolIds)
+    {
+        var particlePool = getMmcParticlePoolAt(simContext, *poolId);
+        let startCount = GetMmcParticlePoolCount(partnerSystem, *poolId);
+        particlePool->PartnerCount = CountMmcStartPoolPartners(simContext, *poolId);
+        AddToMmcPartnerPoolTargetCounts(simContext, *poolId, startCount);
+
+        partnerSystem->ExchangeCount += startCount * particlePool->PartnerCount;
+        partnerSystem->StartJumpCount += startCount * particlePool->JumpCount;
+    }
+}
+
+// Updates the number of valid exchanges and start jumps and the partner and target counts of the MMC partner system by the passed exchange
+static void UpdateMmcExchangeCountsByExchange(SCONTEXT_PARAMETER, const int32_t *restrict exchangePoolIds)
+{
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    int64_t exchangeDelta, startJumpDelta;
+    CalculateMmcExchangeCountChanges(simContext, exchangePoolIds, &exchangeDelta, &startJumpDelta);
+    partnerSystem->ExchangeCount += exchangeDelta;
+    partnerSystem->StartJumpCount += startJumpDelta;
+
+    cpp_foreach(poolId, partnerSystem->StartPoolIds)
+        getMmcParticlePoolAt(simContext, *poolId)->PartnerCount += GetMmcStartPoolPartnerCountChange(simContext, *poolId, exchangePoolIds);
+
+    for (int32_t i = 0; i < 4; i++)
+        AddToMmcPartnerPoolTargetCounts(simContext, exchangePoolIds[i], MmcExchangePoolDeltas[i]);
+}
+
+// Adds the passed environment to the affiliated MMC particle pool (The pool buffer is allocated on first usage)
+static void AddMmcParticlePoolEntry(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment)
+{
+    let latticeSizes = getLatticeSizeVector(simContext);
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    var particlePool = getMmcParticlePoolAt(simContext, GetMmcParticlePoolId(environment->LatticeVector.D, environment->ParticleId));
+    let envId = getEnvironmentStateIdByPointer(simContext, environment);
+
+    if (particlePool->EnvironmentPool.Begin == NULL)
+        particlePool->EnvironmentPool = list_New(particlePool->EnvironmentPool, latticeSizes->A * latticeSizes->B * latticeSizes->C);
+
+    span_Get(partnerSystem->PoolPositionIds, envId) = (int32_t) span_Length(particlePool->EnvironmentPool);
+    list_PushBack(particlePool->EnvironmentPool, envId);
+}
+
+// Removes the passed environment from the MMC particle pool of the passed particle id
+static void RemoveMmcParticlePoolEntry(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment, const byte_t oldParticleId)
+{
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    var particlePool = getMmcParticlePoolAt(simContext, GetMmcParticlePoolId(environment->LatticeVector.D, oldParticleId));
+    let positionId = span_Get(partnerSystem->PoolPositionIds, getEnvironmentStateIdByPointer(simContext, environment));
+
+    let movedEnvId = list_PopBack(particlePool->EnvironmentPool);
+    span_Get(particlePool->EnvironmentPool, positionId) = movedEnvId;
+    span_Get(partnerSystem->PoolPositionIds, movedEnvId) = positionId;
+}
+
 /* Initializer routines*/
 
 static error_t AddEnvStateToSelectionPool(SCONTEXT_PARAMETER, EnvironmentState_t* restrict environment, const int32_t jumpCount)
 {
-    let poolId = getDirectionPoolIdByJumpCount(simContext, jumpCount);
     var selectionPool = getJumpSelectionPool(simContext);
+    let poolId = span_Get(selectionPool->DirectionPoolMapping, GetDirectionPoolMappingIndex(selectionPool, jumpCount, environment->ParticleId));
     var directionPool = getDirectionPoolAt(simContext, poolId);
     let envId = getEnvironmentStateIdByPointer(simContext, environment);
     return_if(!TryAddDirectionPoolEntry(directionPool, envId), ERR_BUFFEROVERFLOW);
@@ -70,6 +365,8 @@ static error_t AddEnvStateToSelectionPool(SCONTEXT_PARAMETER, EnvironmentState_t
     directionPool->PositionCount++;
     directionPool->JumpCount += jumpCount;
     selectionPool->SelectableJumpCount += jumpCount;
+    selectionPool->WeightedJumpCount += directionPool->SelectionWeight * (double) jumpCount;
+    UpdateFlatJumpSlots(simContext, selectionPool, environment, 0, jumpCount);
 
     UpdateEnvStateSelectionStatus(environment, poolId, directionPool->PositionCount - 1);
 
@@ -98,7 +395,13 @@ error_t RegisterEnvironmentStateInTransitionPool(SCONTEXT_PARAMETER, int32_t env
     if (directionCount > JPOOL_DIRCOUNT_PASSIVE)
     {
         environment->IsMobile = true;
-        if (EnvironmentIsSelectable(environment))
+        if (EnvironmentIsSelectable(environment) && simContext->IsKmcSelectionMaskActive)
+        {
+            var mask = GetJumpSlotMaskOf(simContext, environment);
+            *mask = EvaluateJumpSlotMask(simContext, environment);
+            if (*mask != 0ULL) return AddEnvStateToSelectionPool(simContext, environment, CountJumpSlotMaskBits(*mask));
+        }
+        else if (EnvironmentIsSelectable(environment))
             return AddEnvStateToSelectionPool(simContext, environment, directionCount);
 
         UpdateEnvStateSelectionStatus(environment, JPOOL_NOT_SELECTABLE, JPOOL_NOT_SELECTABLE);
@@ -108,11 +411,99 @@ error_t RegisterEnvironmentStateInTransitionPool(SCONTEXT_PARAMETER, int32_t env
     return ERR_UNKNOWN;
 }
 
+// Checks if the jump count table entry at the passed index defines a start pool of the MMC partner selection
+static bool_t IsMmcStartPoolEntry(SCONTEXT_PARAMETER, const JumpCountTable_t *restrict jumpCountTable, const int32_t entryId)
+{
+    let positionId = entryId / jumpCountTable->Header->Blocks[0];
+    let particleId = entryId % jumpCountTable->Header->Blocks[0];
+    let environment = getEnvironmentStateAt(simContext, positionId);
+
+    // Note: All environments of one position share the stability and environment definition, thus the first unit cell is representative
+    return_if(span_Get(*jumpCountTable, entryId) <= JPOOL_DIRCOUNT_PASSIVE || !environment->IsStable, false);
+    return flagsAreTrue(environment->EnvironmentDefinition->SelectionParticleMask, 1ULL << particleId);
+}
+
+// Constructs the start pool id list and sets the jump counts of the start pools of the MMC partner selection
+static void ConstructMmcStartPools(SCONTEXT_PARAMETER, MmcPartnerSystem_t *restrict partnerSystem)
+{
+    let jumpCountTable = getJumpCountMapping(simContext);
+    let entryCount = (int32_t) span_Length(*jumpCountTable);
+    int32_t startPoolCount = 0;
+
+    for (int32_t i = 0; i < entryCount; i++)
+        startPoolCount += IsMmcStartPoolEntry(simContext, jumpCountTable, i);
+
+    partnerSystem->StartPoolIds = span_New(partnerSystem->StartPoolIds, startPoolCount);
+    var poolId = partnerSystem->StartPoolIds.Begin;
+    for (int32_t i = 0; i < entryCount; i++)
+    {
+        continue_if(!IsMmcStartPoolEntry(simContext, jumpCountTable, i));
+        *poolId = GetMmcParticlePoolId(i / jumpCountTable->Header->Blocks[0], (byte_t) (i % jumpCountTable->Header->Blocks[0]));
+        getMmcParticlePoolAt(simContext, *poolId)->JumpCount = span_Get(*jumpCountTable, i);
+        ++poolId;
+    }
+}
+
+// Constructs the valid partner particle masks of all jump directions and start particles from the exchange rules of the jump collections
+static void ConstructMmcPartnerParticleMasks(SCONTEXT_PARAMETER, MmcPartnerSystem_t *restrict partnerSystem)
+{
+    let jumpDirections = getJumpDirections(simContext);
+    partnerSystem->PartnerParticleMasks = span_New(partnerSystem->PartnerParticleMasks, span_Length(*jumpDirections) * PARTICLE_IDLIMIT);
+
+    for (int32_t jumpId = 0; jumpId < span_Length(*jumpDirections); jumpId++)
+    {
+        let jumpCollection = getJumpCollectionAt(simContext, span_Get(*jumpDirections, jumpId).JumpCollectionId);
+        cpp_foreach(jumpRule, jumpCollection->JumpRules)
+        {
+            let startParticleId = jumpRule->StateCode0.ParticleIds[0];
+            span_Get(partnerSystem->PartnerParticleMasks, jumpId * PARTICLE_IDLIMIT + startParticleId) |= 1ULL << jumpRule->StateCode0.ParticleIds[1];
+        }
+    }
+}
+
+void BuildMmcPartnerSystem(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsMmcPartnerSelectionActive);
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    let lattice = getEnvironmentLattice(simContext);
+
+    partnerSystem->ParticlePools = span_New(partnerSystem->ParticlePools, getLatticeSizeVector(simContext)->D * PARTICLE_IDLIMIT);
+    partnerSystem->PoolPositionIds = span_New(partnerSystem->PoolPositionIds, lattice->Header->Size);
+    ConstructMmcPartnerParticleMasks(simContext, partnerSystem);
+    ConstructMmcStartPools(simContext, partnerSystem);
+
+    for (int32_t i = 0; i < lattice->Header->Size; i++)
+    {
+        let environment = getEnvironmentStateAt(simContext, i);
+        if (environment->IsStable) AddMmcParticlePoolEntry(simContext, environment);
+    }
+    InitializeMmcExchangeCounts(simContext);
+    partnerSystem->ProposalRatio = 1.0;
+
+    printf("[Init-Info]: MMC partner selection BUILD [START_JUMP_COUNT=" FORMAT_I64() ", EXCHANGE_COUNT=" FORMAT_I64() "]\n",
+           partnerSystem->StartJumpCount, partnerSystem->ExchangeCount);
+}
+
 /* Simulation routines*/
 
+// Rolls a start position and jump direction from the flat jump slot table with a single bounded random number
+static inline void RollPositionAndDirectionFromSlotTable(SCONTEXT_PARAMETER)
+{
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    let jumpSlot = getJumpSlotAt(simContext, GetNextBoundedRandomFromContextRng(simContext, simContext->SelectionPool.SelectableJumpCount));
+    selectionInfo->EnvironmentId = jumpSlot->EnvironmentId;
+    selectionInfo->RelativeJumpId = jumpSlot->RelativeJumpId;
+}
+
 // Rolls a start position and jump direction from the jump selection pool
 static inline void RollPositionAndDirectionFromPool(SCONTEXT_PARAMETER)
 {
+    if (simContext->IsFlatJumpSlotTableActive)
+    {
+        RollPositionAndDirectionFromSlotTable(simContext);
+        return;
+    }
+
     var selectionInfo = getJumpSelectionInfo(simContext);
     var random = GetNextCeiledRandomFromContextRng(simContext, simContext->SelectionPool.SelectableJumpCount);
 
@@ -131,6 +522,120 @@ static inline void RollPositionAndDirectionFromPool(SCONTEXT_PARAMETER)
     SIMERROR = ERR_UNKNOWN;
 }
 
+// Rolls a start position and jump direction from the jump selection pool where each pool is selected with its weighted jump count
+static inline void RollWeightedPositionAndDirectionFromPool(SCONTEXT_PARAMETER)
+{
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    var random = GetNextRandomDoubleFromContextRng(simContext) * simContext->SelectionPool.WeightedJumpCount;
+    DirectionPool_t* selectedPool = NULL;
+
+    // Note: A rounding overshoot of the weighted roll falls back to the last non-empty pool
+    cpp_offset_foreach(directionPool, simContext->SelectionPool.DirectionPools, 1)
+    {
+        continue_if(directionPool->JumpCount == 0);
+        selectedPool = directionPool;
+        let weightedJumpCount = directionPool->SelectionWeight * (double) directionPool->JumpCount;
+        break_if(random < weightedJumpCount);
+        random -= weightedJumpCount;
+    }
+
+    if (selectedPool == NULL)
+    {
+        SIMERROR = ERR_UNKNOWN;
+        return;
+    }
+
+    let rdiv = div(GetNextCeiledRandomFromContextRng(simContext, selectedPool->JumpCount), selectedPool->DirectionCount);
+    selectionInfo->EnvironmentId = getEnvironmentPoolEntryAt(selectedPool, rdiv.quot);
+    selectionInfo->RelativeJumpId = rdiv.rem;
+}
+
+// Calculates the ratio of the reverse and forward proposal probabilities of the exchange of the passed start and partner particles
+static double CalculateMmcProposalRatio(SCONTEXT_PARAMETER, const int32_t startPositionId, const byte_t startParticleId, const int32_t partnerPositionId, const byte_t partnerParticleId)
+{
+    let partnerSystem = getMmcPartnerSystem(simContext);
+
+    // Note: An exchange on one position does not change the pool counts, the reverse exchange thus has the same proposal probability
+    return_if(startPositionId == partnerPositionId, 1.0);
+
+    // Note: The exact ratio of the default selection is preserved by the relative change of the valid exchange fraction of all attempts
+    int32_t exchangePoolIds[4] =
+    {
+        GetMmcParticlePoolId(startPositionId, startParticleId), GetMmcParticlePoolId(startPositionId, partnerParticleId),
+        GetMmcParticlePoolId(partnerPositionId, partnerParticleId), GetMmcParticlePoolId(partnerPositionId, startParticleId)
+    };
+    int64_t exchangeDelta, startJumpDelta;
+    CalculateMmcExchangeCountChanges(simContext, exchangePoolIds, &exchangeDelta, &startJumpDelta);
+    let exchangeCount = partnerSystem->ExchangeCount + exchangeDelta;
+    let startJumpCount = partnerSystem->StartJumpCount + startJumpDelta;
+    return_if(exchangeCount == 0, 0.0);
+
+    return ((double) partnerSystem->ExchangeCount * (double) startJumpCount) / ((double) exchangeCount * (double) partnerSystem->StartJumpCount);
+}
+
+// Sets the relative jump id and the exchange partner of the passed partner rank of the start environment and the affiliated proposal ratio
+static void SetMmcPartnerSelectionByRank(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict environment, int64_t partnerRank)
+{
+    let jumpMapping = getJumpDirectionMapping(simContext);
+    var partnerSystem = getMmcPartnerSystem(simContext);
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    let positionId = environment->LatticeVector.D;
+    let particleId = environment->ParticleId;
+    let jumpCount = getMmcParticlePoolAt(simContext, GetMmcParticlePoolId(positionId, particleId))->JumpCount;
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; relativeJumpId++)
+    {
+        let jumpId = array_Get(*jumpMapping, positionId, particleId, relativeJumpId);
+        let partnerPositionId = getJumpDirectionAt(simContext, jumpId)->JumpSequence.Begin->D;
+        var partnerMask = span_Get(partnerSystem->PartnerParticleMasks, jumpId * PARTICLE_IDLIMIT + particleId);
+
+        for (byte_t partnerId = 0; partnerMask != 0; ++partnerId, partnerMask >>= 1)
+        {
+            continue_if((partnerMask & 1ULL) == 0);
+            let particlePool = getMmcParticlePoolAt(simContext, GetMmcParticlePoolId(partnerPositionId, partnerId));
+            let poolCount = (int64_t) span_Length(particlePool->EnvironmentPool);
+            if (partnerRank >= poolCount)
+            {
+                partnerRank -= poolCount;
+                continue;
+            }
+
+            selectionInfo->RelativeJumpId = relativeJumpId;
+            selectionInfo->MmcOffsetSourceId = span_Get(particlePool->EnvironmentPool, partnerRank);
+            partnerSystem->ProposalRatio = CalculateMmcProposalRatio(simContext, positionId, particleId, partnerPositionId, partnerId);
+            return;
+        }
+    }
+
+    SIMERROR = ERR_UNKNOWN;
+}
+
+// Rolls a start environment, jump direction and exchange partner from the MMC particle pools where each valid exchange has the same probability
+static void RollMmcExchangeFromPartnerPools(SCONTEXT_PARAMETER)
+{
+    let partnerSystem = getMmcPartnerSystem(simContext);
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    var random = (int64_t) (GetNextRandomDoubleFromContextRng(simContext) * (double) partnerSystem->ExchangeCount);
+    random = getMinOfTwo(random, partnerSystem->ExchangeCount - 1);
+
+    cpp_foreach(poolId, partnerSystem->StartPoolIds)
+    {
+        let particlePool = getMmcParticlePoolAt(simContext, *poolId);
+        let poolExchangeCount = (int64_t) span_Length(particlePool->EnvironmentPool) * particlePool->PartnerCount;
+        if (random >= poolExchangeCount)
+        {
+            random -= poolExchangeCount;
+            continue;
+        }
+
+        selectionInfo->EnvironmentId = span_Get(particlePool->EnvironmentPool, random / particlePool->PartnerCount);
+        SetMmcPartnerSelectionByRank(simContext, getEnvironmentStateAt(simContext, selectionInfo->EnvironmentId), random % particlePool->PartnerCount);
+        return;
+    }
+
+    SIMERROR = ERR_UNKNOWN;
+}
+
 // Roll an environment offset id for the MMC selection process
 static inline void RollMmcEnvironmentOffsetId(SCONTEXT_PARAMETER)
 {
@@ -161,7 +666,7 @@ static inline void OnPoolUpdateInvalidToSelectable(SCONTEXT_PARAMETER, JumpSelec
     newDirectionPool->PositionCount++;
     newDirectionPool->JumpCount += newDirectionPool->DirectionCount;
     selectionPool->SelectableJumpCount += newDirectionPool->DirectionCount;
-
+    UpdateFlatJumpSlots(simContext, selectionPool, environment, 0, newDirectionPool->DirectionCount);
 }
 
 // Environment pool entries update reaction to an environment change from selectable to not-selectable
@@ -173,6 +678,7 @@ static inline void OnPoolUpdateSelectableToInvalid(SCONTEXT_PARAMETER, JumpSelec
     oldDirectionPool->PositionCount--;
     oldDirectionPool->JumpCount -= oldDirectionPool->DirectionCount;
     selectionPool->SelectableJumpCount -= oldDirectionPool->DirectionCount;
+    UpdateFlatJumpSlots(simContext, selectionPool, environment, oldDirectionPool->DirectionCount, 0);
 
     environment->PoolId = JPOOL_NOT_SELECTABLE;
     environment->PoolPositionId = JPOOL_NOT_SELECTABLE;
@@ -197,6 +703,7 @@ static inline void OnPoolUpdateSelectableToSelectable(SCONTEXT_PARAMETER, JumpSe
     newDirectionPool->PositionCount++;
     newDirectionPool->JumpCount += newDirectionPool->DirectionCount;
     selectionPool->SelectableJumpCount += newDirectionPool->DirectionCount - oldDirectionPool->DirectionCount;
+    UpdateFlatJumpSlots(simContext, selectionPool, environment, oldDirectionPool->DirectionCount, newDirectionPool->DirectionCount);
 }
 
 
@@ -205,7 +712,7 @@ static inline void MakeEnvironmentPoolEntriesUpdate(SCONTEXT_PARAMETER, const Ju
 {
     return_if(!environment->IsStable);
     var selectionPool = getJumpSelectionPool(simContext);
-    let newPoolId = GetEnvironmentPoolId(selectionPool, jumpCountTable, environment);
+    let newPoolId = GetEnvironmentPoolId(simContext, selectionPool, jumpCountTable, environment);
 
     // Case: The pool id has not changed or both old and new are not selectable -> do nothing
     return_if(environment->PoolId == newPoolId);
@@ -226,31 +733,165 @@ static inline void MakeEnvironmentPoolEntriesUpdate(SCONTEXT_PARAMETER, const Ju
     OnPoolUpdateSelectableToSelectable(simContext, selectionPool, environment, newPoolId);
 }
 
+// Reevaluates the jump slot mask of the passed environment state and creates the environment pool entry update
+static inline void MakeEnvironmentJumpSlotMaskUpdate(SCONTEXT_PARAMETER, const JumpCountTable_t *restrict jumpCountTable, EnvironmentState_t *restrict environment)
+{
+    *GetJumpSlotMaskOf(simContext, environment) = EvaluateJumpSlotMask(simContext, environment);
+    MakeEnvironmentPoolEntriesUpdate(simContext, jumpCountTable, environment);
+}
+
+// Updates the jump slot masks and pool entries of the passed changed environment and all jump path start environments that can contain it as a path member
+static void MakePathOriginJumpSlotMaskUpdates(SCONTEXT_PARAMETER, const JumpCountTable_t *restrict jumpCountTable, EnvironmentState_t *restrict environment)
+{
+    let selectionPool = getJumpSelectionPool(simContext);
+    let latticeSizes = getLatticeSizeVector(simContext);
+    let positionId = environment->LatticeVector.D;
+    let offsetBegin = span_Get(selectionPool->PathOriginOffsetBegins, positionId);
+    let offsetEnd = span_Get(selectionPool->PathOriginOffsetBegins, positionId + 1);
+
+    MakeEnvironmentJumpSlotMaskUpdate(simContext, jumpCountTable, environment);
+    for (int32_t i = offsetBegin; i < offsetEnd; ++i)
+    {
+        var originVector = SubtractVector4(&environment->LatticeVector, &span_Get(selectionPool->PathOriginOffsets, i));
+        PeriodicTrimVector4(&originVector, latticeSizes);
+        MakeEnvironmentJumpSlotMaskUpdate(simContext, jumpCountTable, getEnvironmentStateByVector4(simContext, &originVector));
+    }
+}
+
+// Creates the pool entry updates of the passed changed environment (Includes the affected jump slot masks if the selection masks are active)
+static inline void MakeChangedEnvironmentPoolUpdates(SCONTEXT_PARAMETER, const JumpCountTable_t *restrict jumpCountTable, EnvironmentState_t *restrict environment)
+{
+    if (simContext->IsKmcSelectionMaskActive)
+    {
+        MakePathOriginJumpSlotMaskUpdates(simContext, jumpCountTable, environment);
+        return;
+    }
+    MakeEnvironmentPoolEntriesUpdate(simContext, jumpCountTable, environment);
+}
+
 bool_t UpdateTransitionPoolAfterKmcSystemAdvance(SCONTEXT_PARAMETER)
 {
-    let oldSelectableJumpCount = getJumpSelectionPool(simContext)->SelectableJumpCount;
+    var selectionPool = getJumpSelectionPool(simContext);
+    let oldSelectableJumpCount = selectionPool->SelectableJumpCount;
     let jumpCountMapping = getJumpCountMapping(simContext);
 
     for (int32_t i = 0; i < getActiveJumpDirection(simContext)->JumpLength; i++)
-        MakeEnvironmentPoolEntriesUpdate(simContext, jumpCountMapping, JUMPPATH[i]);
+        MakeChangedEnvironmentPoolUpdates(simContext, jumpCountMapping, JUMPPATH[i]);
+
+    return_if(!simContext->IsGroupKmcNormalizationActive, oldSelectableJumpCount != selectionPool->SelectableJumpCount);
+
+    // Note: Pool changes between groups of different weight change the time step without changing the jump count
+    let oldWeightedJumpCount = selectionPool->WeightedJumpCount;
+    selectionPool->WeightedJumpCount = CalculateWeightedJumpCount(selectionPool);
+    return oldWeightedJumpCount != selectionPool->WeightedJumpCount;
+}
+
+void UpdateSelectionPoolKmcGroupWeights(SCONTEXT_PARAMETER, const double rawMaxJumpProbability, const double weightLimit)
+{
+    var selectionPool = getJumpSelectionPool(simContext);
+    double particleMaxProbabilities[PARTICLE_IDLIMIT] = { 0.0 };
+
+    cpp_offset_foreach(directionPool, selectionPool->DirectionPools, 1)
+    {
+        var particleMax = &particleMaxProbabilities[directionPool->ParticleId];
+        *particleMax = getMaxOfTwo(*particleMax, directionPool->RawMaxJumpProbability);
+    }
 
-    return oldSelectableJumpCount != getJumpSelectionPool(simContext)->SelectableJumpCount;
+    // Note: Groups without any sampled jump keep the global normalization as no information about their probabilities is available
+    cpp_offset_foreach(directionPool, selectionPool->DirectionPools, 1)
+    {
+        let particleMax = particleMaxProbabilities[directionPool->ParticleId];
+        let weight = (particleMax > 0.0 && isfinite(rawMaxJumpProbability)) ? particleMax / rawMaxJumpProbability : 1.0;
+        directionPool->SelectionWeight = getMinOfTwo(1.0, getMaxOfTwo(weightLimit, weight));
+    }
+    selectionPool->WeightedJumpCount = CalculateWeightedJumpCount(selectionPool);
+}
+
+// Moves the passed exchanged environments to their new MMC particle pools and updates the exchange counts
+static void UpdateMmcParticlePoolsAfterExchange(SCONTEXT_PARAMETER, const EnvironmentState_t *restrict lhs, const EnvironmentState_t *restrict rhs)
+{
+    return_if(lhs->ParticleId == rhs->ParticleId);
+
+    // Note: An unstable environment is not part of the pools, its remove and add entries are set to the same pool and cancel out
+    let lhsPoolId = GetMmcParticlePoolId(lhs->LatticeVector.D, lhs->ParticleId);
+    let rhsPoolId = GetMmcParticlePoolId(rhs->LatticeVector.D, rhs->ParticleId);
+    int32_t exchangePoolIds[4] =
+    {
+        lhs->IsStable ? GetMmcParticlePoolId(lhs->LatticeVector.D, rhs->ParticleId) : lhsPoolId, lhsPoolId,
+        rhs->IsStable ? GetMmcParticlePoolId(rhs->LatticeVector.D, lhs->ParticleId) : rhsPoolId, rhsPoolId
+    };
+    UpdateMmcExchangeCountsByExchange(simContext, exchangePoolIds);
+
+    // Note: The exchange swaps the particles of both environments, thus the old particle of one environment is the new particle of the other
+    if (lhs->IsStable)
+    {
+        RemoveMmcParticlePoolEntry(simContext, lhs, rhs->ParticleId);
+        AddMmcParticlePoolEntry(simContext, lhs);
+    }
+    if (rhs->IsStable)
+    {
+        RemoveMmcParticlePoolEntry(simContext, rhs, lhs->ParticleId);
+        AddMmcParticlePoolEntry(simContext, rhs);
+    }
 }
 
 void UpdateTransitionPoolAfterMmcSystemAdvance(SCONTEXT_PARAMETER)
 {
     let jumpCountMapping = getJumpCountMapping(simContext);
-    MakeEnvironmentPoolEntriesUpdate(simContext, jumpCountMapping, JUMPPATH[0]);
-    MakeEnvironmentPoolEntriesUpdate(simContext, jumpCountMapping, JUMPPATH[1]);
+    MakeChangedEnvironmentPoolUpdates(simContext, jumpCountMapping, JUMPPATH[0]);
+    MakeChangedEnvironmentPoolUpdates(simContext, jumpCountMapping, JUMPPATH[1]);
+
+    return_if(!simContext->IsMmcPartnerSelectionActive);
+    UpdateMmcParticlePoolsAfterExchange(simContext, JUMPPATH[0], JUMPPATH[1]);
 }
 
 void UniformSelectNextKmcJumpSelection(SCONTEXT_PARAMETER)
 {
-    RollPositionAndDirectionFromPool(simContext);
+    if (simContext->IsGroupKmcNormalizationActive)
+        RollWeightedPositionAndDirectionFromPool(simContext);
+    else
+        RollPositionAndDirectionFromPool(simContext);
+
+    // Note: With active selection masks the rolled direction is the rank of the set bit in the mask of the environment
+    return_if(!simContext->IsKmcSelectionMaskActive);
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    let mask = *getJumpSlotMaskAt(simContext, selectionInfo->EnvironmentId);
+    selectionInfo->RelativeJumpId = FindJumpSlotMaskBitByRank(mask, selectionInfo->RelativeJumpId);
+}
+
+bool_t TryUniformSelectNextKmcJumpSlot(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, const int32_t slotsPerEnvironment)
+{
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    let slotCount = (int32_t) span_Length(*environmentIds) * slotsPerEnvironment;
+    let rdiv = div(GetNextCeiledRandomFromContextRng(simContext, slotCount), slotsPerEnvironment);
+
+    selectionInfo->EnvironmentId = span_Get(*environmentIds, rdiv.quot);
+    selectionInfo->RelativeJumpId = rdiv.rem;
+
+    // Note: The check replaces the pool lookup as the selection pool is not maintained by the sector routines
+    let environment = getEnvironmentStateAt(simContext, selectionInfo->EnvironmentId);
+    return_if(!environment->IsStable || !EnvironmentIsSelectable(environment), false);
+    return rdiv.rem < getJumpCountAt(simContext, environment->LatticeVector.D, environment->ParticleId);
 }
 
 void UniformSelectNextMmcJumpSelection(SCONTEXT_PARAMETER)
 {
+    // Note: Without any valid exchange the partner selection falls back to the default selection, the attempt is then site-blocked
+    if (simContext->IsMmcPartnerSelectionActive && getMmcPartnerSystem(simContext)->ExchangeCount > 0)
+    {
+        RollMmcExchangeFromPartnerPools(simContext);
+        return;
+    }
     RollPositionAndDirectionFromPool(simContext);
     RollMmcEnvironmentOffsetId(simContext);
+}
+
+bool_t TryUniformSelectNextMmcJumpSlot(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, const int32_t slotsPerEnvironment)
+{
+    return_if(!TryUniformSelectNextKmcJumpSlot(simContext, environmentIds, slotsPerEnvironment), false);
+
+    // Note: The offset source is restricted to the passed environments, thus both exchange partners are located in the same sector
+    let offsetId = GetNextCeiledRandomFromContextRng(simContext, (int32_t) span_Length(*environmentIds));
+    getJumpSelectionInfo(simContext)->MmcOffsetSourceId = span_Get(*environmentIds, offsetId);
+    return true;
 }
\ No newline at end of file
@@ -14,22 +14,40 @@
 #include "Libraries/Framework/Basic/BaseTypes.h"
 #include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
 
+// Get the ratio of the reverse and forward proposal probabilities of the last MMC jump selection (Always one if the MMC partner selection is not active)
+static inline double GetMmcSelectionProposalRatio(SCONTEXT_PARAMETER)
+{
+    return simContext->IsMmcPartnerSelectionActive ? getMmcPartnerSystem(simContext)->ProposalRatio : 1.0;
+}
+
 /* Initializer routines*/
 
 // Handles the environment state registration in the pool for the passed environment id on the passed context
 error_t RegisterEnvironmentStateInTransitionPool(SCONTEXT_PARAMETER, int32_t environmentId);
 
+// Builds the particle pools of the MMC partner selection on the passed context (Has an effect only if the MMC partner selection is active)
+void BuildMmcPartnerSystem(SCONTEXT_PARAMETER);
+
 /* Simulation required routines */
 
-// Rolls the next jump selection data for a KMC simulation on the passed context
+// Rolls the next jump selection data for a KMC simulation on the passed context (Pools are selected by weighted jump count if the grouped normalization is active, only masked jumps are selected if the selection masks are active)
 void UniformSelectNextKmcJumpSelection(SCONTEXT_PARAMETER);
 
-// Rolls the next jump selection data for an MMC simulation on the passed context
+// Rolls a uniform jump slot from the passed environment ids with a fixed slot count per environment. Returns false if the slot does not contain a selectable jump
+bool_t TryUniformSelectNextKmcJumpSlot(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, int32_t slotsPerEnvironment);
+
+// Rolls the next jump selection data for an MMC simulation on the passed context (Only valid exchanges are selected if the MMC partner selection is active)
 void UniformSelectNextMmcJumpSelection(SCONTEXT_PARAMETER);
 
-// Makes the jump pool update on the passed context after a KMC transition. Returns true if the number of jumps has changed
+// Rolls a uniform MMC jump slot and the exchange offset source from the passed environment ids. Returns false if the slot does not contain a selectable jump
+bool_t TryUniformSelectNextMmcJumpSlot(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, int32_t slotsPerEnvironment);
+
+// Makes the jump pool update on the passed context after a KMC transition (Includes the affected jump slot masks). Returns true if the number of jumps (or the weighted number if grouped) has changed
 bool_t UpdateTransitionPoolAfterKmcSystemAdvance(SCONTEXT_PARAMETER);
 
-// Makes the jump pool update on the passed context after a MMC transition
+// Sets the selection weights of the grouped KMC normalization from the pool maxima relative to the passed global maximum raw probability (Weights are limited to [weightLimit,1])
+void UpdateSelectionPoolKmcGroupWeights(SCONTEXT_PARAMETER, double rawMaxJumpProbability, double weightLimit);
+
+// Makes the jump pool update on the passed context after a MMC transition (Includes the MMC particle pools if the partner selection is active)
 void UpdateTransitionPoolAfterMmcSystemAdvance(SCONTEXT_PARAMETER);
 
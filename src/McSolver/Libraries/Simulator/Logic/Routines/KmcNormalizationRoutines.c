@@ -0,0 +1,248 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	KmcNormalizationRoutines.c	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC jump normalization      //
+//////////////////////////////////////////
+
+#include <pthread.h>
+#include "KmcNormalizationRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/StatisticsRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
+
+// Type for a worker of the direct enumeration normalization. Each worker evaluates a contiguous environment range on its own context
+// Layout@ggc_x86_64 => 56@[8,8,8,4,4,8,8]
+typedef struct DirectNormalizationWorker
+{
+    // The context of the worker. Worker zero uses the passed context, all other workers use a clone
+    SimulationContext_t*    Context;
+
+    // The sublattice system of the passed context that defines the environments owned by the rank (Clones do not own the system)
+    const KmcSublatticeSystem_t* SublatticeSystem;
+
+    // The thread handle of the worker
+    pthread_t               Thread;
+
+    // The first environment id of the evaluated range
+    int32_t                 EnvironmentBegin;
+
+    // The environment id behind the evaluated range
+    int32_t                 EnvironmentEnd;
+
+    // The number of evaluated jumps
+    int64_t                 JumpCount;
+
+    // The maximum raw jump probability of the evaluated range
+    double                  RawMaxJumpProbability;
+
+} DirectNormalizationWorker_t;
+
+// Type for the worker span of the direct enumeration normalization
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(DirectNormalizationWorker_t, DirectNormalizationWorkers) DirectNormalizationWorkers_t;
+
+// Evaluates all selectable jumps of the environment range of the passed worker and stores the maximum raw probability of the range and of each direction pool
+// (The probabilities are also recorded for the quantile normalization if it is active)
+static void* DirectNormalizationWorkerThreadMain(void* argument)
+{
+    DirectNormalizationWorker_t* worker = argument;
+    var simContext = worker->Context;
+    worker->JumpCount = 0;
+    worker->RawMaxJumpProbability = 0.0;
+
+    for (int32_t environmentId = worker->EnvironmentBegin; environmentId < worker->EnvironmentEnd; ++environmentId)
+    {
+        let environment = getEnvironmentStateAt(simContext, environmentId);
+        continue_if(environment->PoolId == JPOOL_NOT_SELECTABLE || !IsEnvironmentOwnedByDistributedRank(worker->SublatticeSystem, environment));
+
+        var directionPool = getDirectionPoolAt(simContext, environment->PoolId);
+        let jumpCount = getJumpCountAt(simContext, environment->LatticeVector.D, environment->ParticleId);
+        for (int32_t relativeJumpId = 0; relativeJumpId < jumpCount; ++relativeJumpId)
+        {
+            let probability = EvaluateKmcJumpNormalizationProbabilityByIds(simContext, environmentId, relativeJumpId);
+            worker->RawMaxJumpProbability = getMaxOfTwo(worker->RawMaxJumpProbability, probability);
+            directionPool->RawMaxJumpProbability = getMaxOfTwo(directionPool->RawMaxJumpProbability, probability);
+            if (simContext->IsQuantileKmcNormalizationActive) AddKmcNormalizationSample(getKmcNormalizationSystem(simContext), probability);
+        }
+        worker->JumpCount += jumpCount;
+    }
+    return NULL;
+}
+
+// Merges the direction pool maximum raw probabilities of the passed worker context into the pools of the passed context
+static void MergeDirectionPoolMaxJumpProbabilities(SCONTEXT_PARAMETER, const SimulationContext_t*restrict workerContext)
+{
+    let workerPools = &workerContext->SelectionPool.DirectionPools;
+    cpp_foreach(directionPool, *getDirectionPools(simContext))
+    {
+        let workerPool = &span_Get(*workerPools, directionPool - getDirectionPools(simContext)->Begin);
+        directionPool->RawMaxJumpProbability = getMaxOfTwo(directionPool->RawMaxJumpProbability, workerPool->RawMaxJumpProbability);
+    }
+}
+
+// Adds the recorded probabilities of the quantile normalization of the passed worker context to the passed context
+static void MergeKmcNormalizationSamples(SCONTEXT_PARAMETER, const SimulationContext_t*restrict workerContext)
+{
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    let workerSystem = &workerContext->DynamicModel.NormalizationSystem;
+    cpp_foreach(counter, normalizationSystem->ProbabilityCounters)
+        *counter += span_Get(workerSystem->ProbabilityCounters, counter - normalizationSystem->ProbabilityCounters.Begin);
+    normalizationSystem->SampleCount += workerSystem->SampleCount;
+}
+
+// Creates the workers with evenly split environment ranges and starts all worker threads, the calling thread acts as worker zero
+static error_t RunDirectNormalizationWorkers(SCONTEXT_PARAMETER, DirectNormalizationWorkers_t*restrict workers)
+{
+    let environmentCount = (int32_t) array_Length(*getEnvironmentLattice(simContext));
+    let workerCount = (int32_t) span_Length(*workers);
+
+    cpp_foreach(worker, *workers)
+    {
+        let workerId = (int32_t) (worker - workers->Begin);
+        worker->EnvironmentBegin = (int32_t) ((int64_t) environmentCount * workerId / workerCount);
+        worker->EnvironmentEnd = (int32_t) ((int64_t) environmentCount * (workerId + 1) / workerCount);
+        worker->SublatticeSystem = getKmcSublatticeSystem(simContext);
+
+        // Note: The evaluation overwrites the cycle state and work buffers of the context, thus each thread requires its own context
+        worker->Context = (workerId == 0) ? simContext : CloneSimulationContext(simContext);
+        continue_if(workerId == 0);
+        return_if(pthread_create(&worker->Thread, NULL, DirectNormalizationWorkerThreadMain, worker) != 0, ERR_UNKNOWN);
+    }
+
+    DirectNormalizationWorkerThreadMain(workers->Begin);
+    cpp_offset_foreach(worker, *workers, 1)
+    {
+        pthread_join(worker->Thread, NULL);
+        MergeDirectionPoolMaxJumpProbabilities(simContext, worker->Context);
+        MergeKmcNormalizationSamples(simContext, worker->Context);
+        DeleteSimulationContextDynamicBuffers(worker->Context);
+        free(worker->Context);
+    }
+    return ERR_OK;
+}
+
+error_t StartKmcDirectNormalizationRoutine(SCONTEXT_PARAMETER)
+{
+    let environmentCount = (int32_t) array_Length(*getEnvironmentLattice(simContext));
+    let workerCount = getMaxOfTwo(1, getMinOfTwo(getKmcDirectNormThreadCount(simContext), environmentCount));
+    DirectNormalizationWorkers_t workers = span_New(workers, workerCount);
+
+    var error = RunDirectNormalizationWorkers(simContext, &workers);
+    return_if(error, (span_Delete(workers), error));
+
+    int64_t jumpCount = 0;
+    var metaData = getMainStateMetaData(simContext);
+    metaData->RawMaxJumpProbability = 0.0;
+    cpp_foreach(worker, workers)
+    {
+        jumpCount += worker->JumpCount;
+        metaData->RawMaxJumpProbability = getMaxOfTwo(metaData->RawMaxJumpProbability, worker->RawMaxJumpProbability);
+    }
+    span_Delete(workers);
+
+    // Note: Each rank of the distributed KMC mode only evaluates the jumps of its owned environments
+    SumReduceDistributedInt64Values(getKmcSublatticeSystem(simContext), &jumpCount, 1);
+    MaxReduceDistributedDoubleValues(getKmcSublatticeSystem(simContext), &metaData->RawMaxJumpProbability, 1);
+
+    // Note: Without any jump below the jump limit the basic normalization is not finite and the fixed normalization is used
+    UpdateTotalKmcJumpNormalization(simContext);
+    printf("[Init-Info]: KMC direct normalization COMPLETE [JUMP_COUNT=" FORMAT_I64() ", THREADS=%i, MAX_PROBABILITY=%e, NORMALIZATION=%e]\n",
+           jumpCount, workerCount, metaData->RawMaxJumpProbability, getPhysicalFactors(simContext)->TotalJumpNormalization);
+    fflush(stdout);
+
+    return FinishKmcPreRunRoutine(simContext);
+}
+
+// Finds the upper probability limit of the counter bin that contains the passed quantile of the recorded probabilities (NaN if too few probabilities are recorded)
+static double FindKmcNormalizationQuantileProbability(const KmcNormalizationSystem_t*restrict normalizationSystem, const double quantile)
+{
+    return_if(normalizationSystem->SampleCount < KMC_NORMQUANTILE_SAMPLEMIN, NAN);
+    let targetCount = (int64_t) ceil(quantile * (double) normalizationSystem->SampleCount);
+    int64_t count = 0;
+    int32_t binIndex = 0;
+
+    cpp_foreach(counter, normalizationSystem->ProbabilityCounters)
+    {
+        count += *counter;
+        break_if(count >= targetCount);
+        ++binIndex;
+    }
+
+    let exponent = binIndex / KMC_NORMQUANTILE_SUBBINCOUNT + KMC_NORMQUANTILE_EXPONENTMIN;
+    let subBinIndex = binIndex % KMC_NORMQUANTILE_SUBBINCOUNT;
+    let mantissa = 0.5 * (double) (KMC_NORMQUANTILE_SUBBINCOUNT + subBinIndex + 1) / KMC_NORMQUANTILE_SUBBINCOUNT;
+    return getMinOfTwo(MC_CONST_JUMPLIMIT_MAX, ldexp(mantissa, exponent));
+}
+
+// Resets the overflow counter of the passed quantile normalization system and sets the passed accepted jump count as the adaption start
+static inline void ResetKmcNormalizationOverflows(KmcNormalizationSystem_t*restrict normalizationSystem, const int64_t mcsCount)
+{
+    normalizationSystem->OverflowCount = 0;
+    normalizationSystem->LastAdaptionMcsCount = mcsCount;
+}
+
+void ApplyKmcQuantileNormalization(SCONTEXT_PARAMETER)
+{
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    let quantile = getKmcNormalizationQuantile(simContext);
+    let maxProbability = metaData->RawMaxJumpProbability;
+    let probability = FindKmcNormalizationQuantileProbability(normalizationSystem, quantile);
+
+    ResetKmcNormalizationOverflows(normalizationSystem, getMainCycleCounters(simContext)->McsCount);
+    return_if(!isfinite(probability));
+
+    // Note: The upper bin limit can exceed the largest recorded probability which is the upper limit of any quantile
+    metaData->RawMaxJumpProbability = getMinOfTwo(maxProbability, probability);
+    UpdateTotalKmcJumpNormalization(simContext);
+    printf("[Init-Info]: KMC quantile normalization COMPLETE [QUANTILE=%e, SAMPLES=" FORMAT_I64() ", MAX_PROBABILITY=%e, QUANTILE_PROBABILITY=%e, NORMALIZATION=%e]\n",
+           quantile, normalizationSystem->SampleCount, maxProbability, metaData->RawMaxJumpProbability, getPhysicalFactors(simContext)->TotalJumpNormalization);
+    fflush(stdout);
+}
+
+void AdaptKmcQuantileNormalization(SCONTEXT_PARAMETER)
+{
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    let quantile = getKmcNormalizationQuantile(simContext);
+    let mcsCount = getMainCycleCounters(simContext)->McsCount;
+    let acceptedCount = getMaxOfTwo((int64_t) 1, mcsCount - normalizationSystem->LastAdaptionMcsCount);
+    let oldProbability = metaData->RawMaxJumpProbability;
+    let overflowCount = normalizationSystem->OverflowCount;
+    ResetKmcNormalizationOverflows(normalizationSystem, mcsCount);
+
+    var probability = FindKmcNormalizationQuantileProbability(normalizationSystem, quantile);
+    if (!isfinite(probability)) probability = oldProbability;
+    return_if(fabs(probability - oldProbability) <= KMC_NORMQUANTILE_CHANGELIMIT * oldProbability);
+
+    // Note: The new normalization and time step only affect the following attempts, thus the simulated time of the previous attempts stays valid
+    metaData->RawMaxJumpProbability = probability;
+    UpdateTotalKmcJumpNormalization(simContext);
+    printf("[Kmc-Info]: Quantile normalization ADAPTED [OVERFLOWS=" FORMAT_I64() ", ACCEPTED=" FORMAT_I64() ", OLD_PROBABILITY=%e, NEW_PROBABILITY=%e, NORMALIZATION=%e]\n",
+           overflowCount, acceptedCount, oldProbability, probability, getPhysicalFactors(simContext)->TotalJumpNormalization);
+    fflush(stdout);
+}
+
+void RaiseKmcQuantileNormalizationToCurrentJump(SCONTEXT_PARAMETER)
+{
+    var normalizationSystem = getKmcNormalizationSystem(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    var energyInfo = getJumpEnergyInfo(simContext);
+    // Note: The pre-run only records the probabilities, the quantile normalization is defined at its end
+    return_if(StateFlagsAreSet(simContext, STATE_FLG_PRERUN));
+
+    // Note: Accepting the jump with certainty would cut its rate by the overflow factor. The raised normalization applies to the current attempt,
+    // thus its time step and acceptance are exact. The previous attempts were exact with the previous time step and do not require a time correction.
+    // The raise is not kept as a lower limit, the next block adaption returns to the quantile such that a rare outlier does not define the normalization of the run
+    metaData->RawMaxJumpProbability *= energyInfo->NormalizedS0toS2TransitionProbability;
+    ++normalizationSystem->OverflowCount;
+    UpdateTotalKmcJumpNormalization(simContext);
+    energyInfo->NormalizedS0toS2TransitionProbability = energyInfo->RawS0toS2TransitionProbability * GetCurrentProbabilityPreFactor(simContext);
+}
@@ -0,0 +1,50 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	KmcNormalizationRoutines.h	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   KMC jump normalization      //
+//////////////////////////////////////////
+
+#pragma once
+#include <math.h>
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* Direct enumeration normalization routines */
+
+// Determines the KMC jump normalization by evaluating all selectable jumps of the current lattice on the set number of threads
+// and finishes the pre-run phase (Replaces the simulated auto optimization pre-run)
+error_t StartKmcDirectNormalizationRoutine(SCONTEXT_PARAMETER);
+
+/* Quantile normalization routines */
+
+// Get the counter bin index of the passed raw jump probability in [0,1]
+static inline int32_t GetKmcNormalizationBinIndex(const double probability)
+{
+    int32_t exponent;
+    let mantissa = frexp(probability, &exponent);
+    return_if((probability <= 0.0) || (exponent < KMC_NORMQUANTILE_EXPONENTMIN), 0);
+    return (exponent - KMC_NORMQUANTILE_EXPONENTMIN) * KMC_NORMQUANTILE_SUBBINCOUNT + (int32_t) ((2.0 * mantissa - 1.0) * KMC_NORMQUANTILE_SUBBINCOUNT);
+}
+
+// Adds a raw jump probability in [0,1] to the probability counters of the passed quantile normalization system
+static inline void AddKmcNormalizationSample(KmcNormalizationSystem_t*restrict normalizationSystem, const double probability)
+{
+    ++span_Get(normalizationSystem->ProbabilityCounters, GetKmcNormalizationBinIndex(probability));
+    ++normalizationSystem->SampleCount;
+}
+
+// Sets the KMC jump normalization to the set quantile of the recorded probabilities after the pre-run phase (No effect if too few probabilities are recorded)
+void ApplyKmcQuantileNormalization(SCONTEXT_PARAMETER);
+
+// Adapts the KMC jump normalization and the time step to the recorded probabilities of the last main run block
+void AdaptKmcQuantileNormalization(SCONTEXT_PARAMETER);
+
+// Raises the KMC jump normalization and the time step before the evaluation of a jump attempt with a normalized probability above one
+// such that the attempt is evaluated with a normalized probability of exactly one
+void RaiseKmcQuantileNormalizationToCurrentJump(SCONTEXT_PARAMETER);
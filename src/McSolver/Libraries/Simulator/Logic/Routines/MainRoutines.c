@@ -15,6 +15,11 @@
 #include "StatisticsRoutines.h"
 #include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
 #include "TransitionTrackingRoutines.h"
+#include "RateCatalogRoutines.h"
+#include "SublatticeKmcRoutines.h"
+#include "ReplicaExchangeRoutines.h"
+#include "DistributedKmcRoutines.h"
+#include "KmcNormalizationRoutines.h"
 #include "Libraries/ProgressPrint/ProgressPrint.h"
 #include "Libraries/Framework/Math/Approximation.h"
 
@@ -36,7 +41,7 @@ static inline void AdvanceMainCycleCounterToNextStepGoal(SCONTEXT_PARAMETER)
 static inline void SetRuntimeInfoToCurrent(SCONTEXT_PARAMETER)
 {
     var runInfo = getRuntimeInformation(simContext);
-    runInfo->MainRoutineStartClock = clock();
+    runInfo->MainRoutineStartClock = GetCallingThreadClock();
     runInfo->PreviousBlockFinishClock = runInfo->MainRoutineStartClock;
 }
 
@@ -47,23 +52,33 @@ static inline void SetActiveCounterCollection(SCONTEXT_PARAMETER)
     cycleState->ActiveCounterCollection = getMainStateCounterAt(simContext, JUMPPATH[0]->ParticleId);
 }
 
-void PrepareSimulationContextForMainRoutine(SCONTEXT_PARAMETER)
+void SyncMainRoutineStartConditions(SCONTEXT_PARAMETER)
 {
     let cycleCounters = getMainCycleCounters(simContext);
-
-    InitializeContextForSimulation(simContext);
     while (cycleCounters->NextExecutionPhaseGoalMcsCount <= cycleCounters->McsCount)
         AdvanceMainCycleCounterToNextStepGoal(simContext);
 
     SetRuntimeInfoToCurrent(simContext);
 }
 
-static void ExitIfAlreadyCompleted(SCONTEXT_PARAMETER)
+void PrepareSimulationContextForMainRoutine(SCONTEXT_PARAMETER)
+{
+    InitializeContextForSimulation(simContext);
+    SyncMainRoutineStartConditions(simContext);
+}
+
+bool_t IsMainSimulationRoutineCompleted(SCONTEXT_PARAMETER)
 {
     let counters = getMainCycleCounters(simContext);
-    if (counters->McsCount >= counters->TotalSimulationGoalMcsCount)
+    return counters->McsCount >= counters->TotalSimulationGoalMcsCount;
+}
+
+static void ExitIfAlreadyCompleted(SCONTEXT_PARAMETER)
+{
+    if (IsMainSimulationRoutineCompleted(simContext))
     {
         printf("Simulation already completed!\n");
+        FinishDistributedProcessEnvironment();
         exit(0);
     }
 }
@@ -79,7 +94,13 @@ error_t StartMainSimulationRoutine(SCONTEXT_PARAMETER)
     {
         if (StateFlagsAreSet(simContext, STATE_FLG_PRERUN))
         {
-            SIMERROR = StartKmcPreRunRoutine(simContext);
+            // Note: The rejection-free mode does not use a jump normalization, thus the pre-run is skipped
+            if (simContext->IsRejectionFreeKmcActive)
+                SIMERROR = FinishKmcPreRunRoutine(simContext);
+            else if (simContext->IsDirectKmcNormalizationActive)
+                SIMERROR = StartKmcDirectNormalizationRoutine(simContext);
+            else
+                SIMERROR = StartKmcPreRunRoutine(simContext);
             assert_success(SIMERROR, "Pre-run execution of main KMC routine aborted with an error");
         }
         return SIMERROR = StartKmcMainRoutine(simContext);
@@ -115,11 +136,26 @@ error_t StartKmcPreRunRoutine(SCONTEXT_PARAMETER)
     return FinishKmcPreRunRoutine(simContext);
 }
 
+// Applies the grouped KMC normalization to the selection pool using the pool maxima of the finished normalization
+static void ApplyKmcGroupNormalizationAfterPreRun(SCONTEXT_PARAMETER)
+{
+    let selectionPool = getJumpSelectionPool(simContext);
+    UpdateSelectionPoolKmcGroupWeights(simContext, getMainStateMetaData(simContext)->RawMaxJumpProbability, getKmcGroupNormWeightLimit(simContext));
+    UpdateTimeStepPerJumpToCurrent(simContext);
+
+    printf("[Init-Info]: KMC group normalization ACTIVE [POOLS=%i, SELECTABLE_JUMPS=%i, WEIGHTED_JUMPS=%e, TIME_STEP=%e]\n",
+           selectionPool->DirectionPoolCount - 1, selectionPool->SelectableJumpCount, selectionPool->WeightedJumpCount, getPhysicalFactors(simContext)->TimeStepPerJumpAttempt);
+    fflush(stdout);
+}
+
 error_t FinishKmcPreRunRoutine(SCONTEXT_PARAMETER)
 {
     SIMERROR = ResetContextAfterKmcPreRun(simContext);
     return_if(SIMERROR, SIMERROR);
 
+    if (simContext->IsQuantileKmcNormalizationActive) ApplyKmcQuantileNormalization(simContext);
+    if (simContext->IsGroupKmcNormalizationActive) ApplyKmcGroupNormalizationAfterPreRun(simContext);
+
     setMainStateFlags(simContext, STATE_FLG_PRERUN_RESET);
     unSetMainStateFlags(simContext, STATE_FLG_PRERUN);
 
@@ -143,9 +179,16 @@ error_t StartKmcMainRoutine(SCONTEXT_PARAMETER)
     AdvanceStepGoalMcsBeyondCurrentMcs(simContext);
     while(abortFlag == STATE_FLG_CONTINUE)
     {
-        SIMERROR = RunOneKmcExecutionBlock(simContext);
+        if (simContext->IsRejectionFreeKmcActive)
+            SIMERROR = RunOneRejectionFreeKmcExecutionBlock(simContext);
+        else if (simContext->IsSublatticeParallelKmcActive)
+            SIMERROR = RunOneSublatticeKmcExecutionBlock(simContext);
+        else
+            SIMERROR = RunOneKmcExecutionBlock(simContext);
         assert_success(SIMERROR, "Simulation abort due to error in KMC cycle block execution.");
 
+        if (simContext->IsQuantileKmcNormalizationActive) AdaptKmcQuantileNormalization(simContext);
+
         SIMERROR = FinishKmcExecutionBlock(simContext);
         assert_success(SIMERROR, "Simulation abort due to error in KMC cycle block finisher execution.");
 
@@ -157,21 +200,47 @@ error_t StartKmcMainRoutine(SCONTEXT_PARAMETER)
 
 error_t StartMmcPreRunRoutine(SCONTEXT_PARAMETER)
 {
-    return ERR_NOTIMPLEMENTED;
+    var abortFlag = UpdateAndEvaluateMmcAbortConditions(simContext);
+    while(abortFlag == STATE_FLG_CONTINUE)
+    {
+        SIMERROR = RunOneMmcAnnealingExecutionBlock(simContext);
+        assert_success(SIMERROR, "Simulation abort due to error in MMC cycle block execution.");
+
+        SIMERROR = FinishMmcExecutionBlock(simContext);
+        assert_success(SIMERROR, "Simulation abort due to error in MMC cycle block finisher execution.");
+
+        abortFlag = UpdateAndEvaluateMmcAbortConditions(simContext);
+        PrintMocassinSimulationBlockInfo(simContext, stdout, true);
+    }
+    return_if(abortFlag != STATE_FLG_PRERUN_RESET, ERR_OK);
+    return FinishMmcPreRunRoutine(simContext);
 }
 
 error_t FinishMmcPreRunRoutine(SCONTEXT_PARAMETER)
 {
-    return ERR_NOTIMPLEMENTED;
+    SIMERROR = ResetContextAfterMmcPreRun(simContext);
+    return_if(SIMERROR, SIMERROR);
+
+    setMainStateFlags(simContext, STATE_FLG_PRERUN_RESET);
+    unSetMainStateFlags(simContext, STATE_FLG_PRERUN);
+
+    PrintMocassinSimulationContextResetInfo(simContext, stdout);
+    return ERR_OK;
 }
 
 // Starts the main metropolis simulation routine
 error_t StartMmcMainRoutine(SCONTEXT_PARAMETER)
 {
     var abortFlag = UpdateAndEvaluateMmcAbortConditions(simContext);
+    AdvanceStepGoalMcsBeyondCurrentMcs(simContext);
     while(abortFlag == STATE_FLG_CONTINUE)
     {
-        SIMERROR = RunOneMmcExecutionBlock(simContext);
+        if (simContext->IsReplicaExchangeMmcActive)
+            SIMERROR = RunOneReplicaExchangeMmcExecutionBlock(simContext);
+        else if (simContext->IsSublatticeParallelMmcActive)
+            SIMERROR = RunOneSublatticeMmcExecutionBlock(simContext);
+        else
+            SIMERROR = RunOneMmcExecutionBlock(simContext);
         assert_success(SIMERROR, "Simulation abort due to error in MMC cycle block execution.");
 
         SIMERROR = FinishMmcExecutionBlock(simContext);
@@ -179,6 +248,7 @@ error_t StartMmcMainRoutine(SCONTEXT_PARAMETER)
 
         abortFlag = UpdateAndEvaluateMmcAbortConditions(simContext);
         PrintMocassinSimulationBlockInfo(simContext, stdout, true);
+        if (simContext->IsReplicaExchangeMmcActive) PrintMmcReplicaExchangeInfo(simContext, stdout);
     }
 
     return FinishMmcMainRoutine(simContext);
@@ -187,21 +257,17 @@ error_t StartMmcMainRoutine(SCONTEXT_PARAMETER)
 // Calls the output plugin callback if any is set
 static inline error_t TryCallOutputPlugin(SCONTEXT_PARAMETER)
 {
-    return_if(simContext->Plugins.OnDataOutput == NULL, ERR_OK);
+    return_if(simContext->Plugins.OnDataOutput == NULL || !IsDistributedRootRank(), ERR_OK);
     let plugins = getPluginCollection(simContext);
 
     plugins->OnDataOutput(simContext);
     return SIMERROR;
 }
 
-// Writes the current jump delta energy of an MMC transition to the abort buffer (If the abort tolerance is equal or below 0, the buffer write is skipped)
-static inline void WriteMmcJumpEnergyToAbortBuffer(SCONTEXT_PARAMETER)
+// Writes the passed delta energy in [kT] to the abort buffer and updates the buffer sums if the buffer is full
+static inline void PushEnergyToMmcAbortBuffer(SCONTEXT_PARAMETER, const double energy)
 {
-    let header = getDbModelJobHeaderAsMMC(simContext);
-    return_if(header->AbortTolerance <= 0.0);
-
     var buffer = getLatticeEnergyBuffer(simContext);
-    let energyInfo = getJumpEnergyInfo(simContext);
     let factors = getPhysicalFactors(simContext);
 
     if (buffer->End == buffer->CapacityEnd)
@@ -215,7 +281,25 @@ static inline void WriteMmcJumpEnergyToAbortBuffer(SCONTEXT_PARAMETER)
         return;
     }
 
-    list_PushBack(*buffer, energyInfo->S0toS2EnergyBarrier);
+    list_PushBack(*buffer, energy);
+}
+
+// Writes the current jump delta energy of an MMC transition to the abort buffer (If the abort tolerance is equal or below 0, the buffer write is skipped)
+static inline void WriteMmcJumpEnergyToAbortBuffer(SCONTEXT_PARAMETER)
+{
+    let header = getDbModelJobHeaderAsMMC(simContext);
+    return_if(header->AbortTolerance <= 0.0);
+    PushEnergyToMmcAbortBuffer(simContext, getJumpEnergyInfo(simContext)->S0toS2EnergyBarrier);
+}
+
+void WriteMmcEnergyChangeSumToAbortBuffer(SCONTEXT_PARAMETER, const double energyChange, const int64_t jumpCount)
+{
+    let header = getDbModelJobHeaderAsMMC(simContext);
+    return_if(header->AbortTolerance <= 0.0 || jumpCount <= 0);
+
+    // Note: The sum is assigned to the first jump and the other jumps count as zero, thus the buffer still spans the same number of jumps
+    PushEnergyToMmcAbortBuffer(simContext, energyChange);
+    for (int64_t i = 1; i < jumpCount; ++i) PushEnergyToMmcAbortBuffer(simContext, 0.0);
 }
 
 // Action for cases where the MMC jump selection leads to an unstable end state
@@ -226,6 +310,7 @@ static inline void OnKmcEventEndStateIsUnstable(SCONTEXT_PARAMETER)
     ++counters->UnstableEndCount;
     AddCurrentKmcTransitionDataToHistograms(simContext);
     AdvanceSimulatedTimeByCurrentStep(simContext);
+    simContext->CycleResult = MC_ENDUNSTABLE_CYCLE;
 }
 
 // Action for cases where the jump selection enables to leave a currently unstable state
@@ -239,6 +324,7 @@ static inline void OnKmcEventStartStateIsUnstable(SCONTEXT_PARAMETER)
 
     let jumpCountHasChanged = UpdateTransitionPoolAfterKmcSystemAdvance(simContext);
     if (jumpCountHasChanged) UpdateTimeStepPerJumpToCurrent(simContext);
+    simContext->CycleResult = MC_STARTUNSTABLE_CYCLE;
 }
 
 // Updates the maximum jump probability to a new value if required (Skips values above the jump-limit value)
@@ -251,18 +337,30 @@ static inline void UpdateMaxJumpProbabilityBackjumpUnsafe(SCONTEXT_PARAMETER)
     metaData->RawMaxJumpProbability = getMaxOfTwo(metaData->RawMaxJumpProbability, energyInfo->RawS0toS2TransitionProbability);
 }
 
-// Updates the maximum jump probability to a new value if required (Skips values above the jump-limit value & does a backjump check)
-static inline void UpdateMaxJumpProbabilityBackjumpSafe(SCONTEXT_PARAMETER)
+// Get the raw probability of the current jump that is relevant for the normalization (Negative if the jump is above the jump-limit value & does a backjump check)
+static inline double GetBackjumpSafeRawJumpProbability(SCONTEXT_PARAMETER)
 {
     let energyInfo = getJumpEnergyInfo(simContext);
+    return_if(energyInfo->RawS0toS2TransitionProbability > MC_CONST_JUMPLIMIT_MAX, -1.0);
+
+    // Note: This is a safety check for the backjump to prevent the normalization system from accidentally over-normalizing
+    return_if(energyInfo->S0toS2EnergyBarrier >= energyInfo->S2toS0EnergyBarrier, energyInfo->RawS0toS2TransitionProbability);
+    return getMaxOfTwo(energyInfo->RawS0toS2TransitionProbability, CalculateExp(simContext, -energyInfo->S2toS0EnergyBarrier));
+}
+
+// Updates the maximum jump probability of the context and the passed direction pool to a new value if required (Skips values above the jump-limit value & does a backjump check)
+static inline void UpdateMaxJumpProbabilityBackjumpSafe(SCONTEXT_PARAMETER, const int32_t directionPoolId)
+{
     var metaData = getMainStateMetaData(simContext);
+    let probability = GetBackjumpSafeRawJumpProbability(simContext);
+    return_if(probability < 0.0);
 
-    return_if(energyInfo->RawS0toS2TransitionProbability > MC_CONST_JUMPLIMIT_MAX);
-    metaData->RawMaxJumpProbability = getMaxOfTwo(metaData->RawMaxJumpProbability, energyInfo->RawS0toS2TransitionProbability);
+    metaData->RawMaxJumpProbability = getMaxOfTwo(metaData->RawMaxJumpProbability, probability);
+    if (simContext->IsQuantileKmcNormalizationActive) AddKmcNormalizationSample(getKmcNormalizationSystem(simContext), probability);
+    return_if(!simContext->IsGroupKmcNormalizationActive);
 
-    // Note: This is a safety check for the backjump to prevent the normalization system from accidentally over-normalizing
-    return_if(energyInfo->S0toS2EnergyBarrier >= energyInfo->S2toS0EnergyBarrier);
-    metaData->RawMaxJumpProbability = getMaxOfTwo(metaData->RawMaxJumpProbability, CalculateExp(simContext, -energyInfo->S2toS0EnergyBarrier));
+    var directionPool = getDirectionPoolAt(simContext, directionPoolId);
+    directionPool->RawMaxJumpProbability = getMaxOfTwo(directionPool->RawMaxJumpProbability, probability);
 }
 
 // Action for cases where the jump selection has been statistically accepted
@@ -312,6 +410,70 @@ static inline void OnKmcEventIsFrequencySkipped(SCONTEXT_PARAMETER)
     simContext->CycleResult = MC_SKIPPED_CYCLE;
 }
 
+// Advances the simulated time span by an exponentially distributed residence time of the current rate catalog state
+static inline void AdvanceSimulatedTimeByResidenceTime(SCONTEXT_PARAMETER)
+{
+    let rateCatalog = getKmcRateCatalog(simContext);
+    var metaData = getMainStateMetaData(simContext);
+    let totalRate = GetKmcRateCatalogTotalRate(rateCatalog) * rateCatalog->RateToHzFactor;
+    metaData->SimulatedTime -= log(1.0 - GetNextRandomDoubleFromContextRng(simContext)) / totalRate;
+}
+
+// Action for cases where the rejection-free jump selection is executed
+static inline void OnRejectionFreeKmcEventIsAccepted(SCONTEXT_PARAMETER)
+{
+    var activeCounters = getActiveCounters(simContext);
+    var cycleCounters = getMainCycleCounters(simContext);
+
+    ++activeCounters->McsCount;
+    ++cycleCounters->McsCount;
+
+    AdvanceSimulatedTimeByResidenceTime(simContext);
+    AdvanceKmcTransitionTrackingSystem(simContext);
+    AdvanceKmcSystemToFinalState(simContext);
+    UpdateTransitionPoolAfterKmcSystemAdvance(simContext);
+    UpdateKmcRateCatalogAfterSystemAdvance(simContext);
+    simContext->CycleResult = MC_ACCEPTED_CYCLE;
+}
+
+// Action for cases where the rejection-free jump selection enables to leave a currently unstable state
+static inline void OnRejectionFreeKmcEventStartStateIsUnstable(SCONTEXT_PARAMETER)
+{
+    var counters = getActiveCounters(simContext);
+
+    ++counters->UnstableStartCount;
+    AdvanceKmcTransitionTrackingSystem(simContext);
+    AdvanceKmcSystemToFinalState(simContext);
+    UpdateTransitionPoolAfterKmcSystemAdvance(simContext);
+    UpdateKmcRateCatalogAfterSystemAdvance(simContext);
+    simContext->CycleResult = MC_STARTUNSTABLE_CYCLE;
+}
+
+// Action for cases where the sector jump selection has been statistically accepted (No selection pool and simulated time update)
+static inline void OnSectorKmcEventIsAccepted(SCONTEXT_PARAMETER)
+{
+    var activeCounters = getActiveCounters(simContext);
+    var cycleCounters = getMainCycleCounters(simContext);
+
+    ++activeCounters->McsCount;
+    ++cycleCounters->McsCount;
+
+    AdvanceKmcTransitionTrackingSystem(simContext);
+    AdvanceKmcSystemToFinalState(simContext);
+    simContext->CycleResult = MC_ACCEPTED_CYCLE;
+}
+
+// Action for cases where the sector jump selection enables to leave a currently unstable state (No selection pool update)
+static inline void OnSectorKmcEventStartStateIsUnstable(SCONTEXT_PARAMETER)
+{
+    var counters = getActiveCounters(simContext);
+
+    ++counters->UnstableStartCount;
+    AdvanceKmcTransitionTrackingSystem(simContext);
+    AdvanceKmcSystemToFinalState(simContext);
+    simContext->CycleResult = MC_STARTUNSTABLE_CYCLE;
+}
+
 // Pre-check of the attempt frequency factor using another double roll [0;1]
 static inline bool_t CheckKmcEventFrequencySkip(SCONTEXT_PARAMETER)
 {
@@ -324,6 +486,13 @@ static inline bool_t CheckKmcEventFrequencySkip(SCONTEXT_PARAMETER)
     #endif
 }
 
+// Records the probability of the current jump on the quantile normalization system
+static inline void TrackKmcQuantileNormalizationSample(SCONTEXT_PARAMETER)
+{
+    let probability = GetBackjumpSafeRawJumpProbability(simContext);
+    if (probability >= 0.0) AddKmcNormalizationSample(getKmcNormalizationSystem(simContext), probability);
+}
+
 void ExecuteKmcSimulationCycle(SCONTEXT_PARAMETER)
 {
     SetNextKmcJumpSelectionOnContext(simContext);
@@ -338,8 +507,14 @@ void ExecuteKmcSimulationCycle(SCONTEXT_PARAMETER)
             return;
         }
         #endif
+        if (simContext->IsKmcEarlyRejectionActive)
+        {
+            SetEnvelopeCheckedKmcEventEvaluationOnContext(simContext);
+            return;
+        }
         SetKmcJumpPropertiesOnContext(simContext);
         SetEnergeticKmcEventEvaluationOnContext(simContext);
+        if (simContext->IsQuantileKmcNormalizationActive) TrackKmcQuantileNormalizationSample(simContext);
         return;
     }
 
@@ -360,9 +535,11 @@ void ExecuteKmcAutoOptimizingSimulationCycle(SCONTEXT_PARAMETER)
             return;
         }
         #endif
+        // Note: An accepted jump changes the pool affiliation of the start environment, thus the pool id is stored before the evaluation
+        let directionPoolId = JUMPPATH[0]->PoolId;
         SetKmcJumpPropertiesOnContext(simContext);
         SetEnergeticKmcEventEvaluationOnContext(simContext);
-        UpdateMaxJumpProbabilityBackjumpSafe(simContext);
+        UpdateMaxJumpProbabilityBackjumpSafe(simContext, directionPoolId);
         return;
     }
 
@@ -385,6 +562,22 @@ error_t RunOneKmcExecutionBlock(SCONTEXT_PARAMETER)
     return SIMERROR;
 }
 
+error_t RunOneRejectionFreeKmcExecutionBlock(SCONTEXT_PARAMETER)
+{
+    var counters = getMainCycleCounters(simContext);
+    for (;counters->McsCount < counters->NextExecutionPhaseGoalMcsCount;)
+    {
+        let countPerLoop = counters->CycleCountPerExecutionLoop;
+        for (int64_t i = 0; i < countPerLoop; ++i)
+        {
+            ExecuteRejectionFreeKmcSimulationCycle(simContext);
+        }
+        counters->CycleCount += countPerLoop;
+        return_if(UpdateAndEvaluateKmcAbortConditions(simContext) != STATE_FLG_CONTINUE, ERR_OK);
+    }
+    return SIMERROR;
+}
+
 error_t RunOneKmcAutoOptimizationExecutionBlock(SCONTEXT_PARAMETER)
 {
     var counters = getMainCycleCounters(simContext);
@@ -419,6 +612,47 @@ void ExecuteSharedMcBlockFinisher(SCONTEXT_PARAMETER)
     assert_success(SIMERROR, "Simulation aborted due to error in the external output plugin.");
 }
 
+// Adds the observable of the finished main run block to the precision abort system and updates the relative error estimate
+static void UpdatePrecisionAbortSystem(SCONTEXT_PARAMETER)
+{
+    var precisionSystem = getPrecisionAbortSystem(simContext);
+    return_if(precisionSystem->BlockValues.Begin == NULL || StateFlagsAreSet(simContext, STATE_FLG_PRERUN));
+
+    let observableSum = CalculatePrecisionAbortObservableSum(simContext);
+    let simulatedTime = getMainStateMetaData(simContext)->SimulatedTime;
+
+    // Note: MMC blocks contribute the mean of the lattice energy samples, KMC blocks the observable rate and the first KMC block after a start or resume only defines the reference
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_MMC))
+    {
+        if (precisionSystem->BlockSampleCount > 0 && !list_IsFull(precisionSystem->BlockValues))
+            list_PushBack(precisionSystem->BlockValues, precisionSystem->BlockSampleSum / (double) precisionSystem->BlockSampleCount);
+        precisionSystem->BlockSampleSum = 0.0;
+        precisionSystem->BlockSampleCount = 0;
+    }
+    else if (isfinite(precisionSystem->LastObservableSum) && !list_IsFull(precisionSystem->BlockValues))
+    {
+        let deltaTime = simulatedTime - precisionSystem->LastSimulatedTime;
+        if (deltaTime > 0.0)
+            list_PushBack(precisionSystem->BlockValues, (observableSum - precisionSystem->LastObservableSum) / deltaTime);
+    }
+    precisionSystem->LastObservableSum = observableSum;
+    precisionSystem->LastSimulatedTime = simulatedTime;
+    return_if(span_Length(precisionSystem->BlockValues) < PRECISION_BLOCKCOUNT_MIN);
+
+    let mean = CalculateBlockAveragingMean(&precisionSystem->BlockValues);
+    precisionSystem->AbsoluteError = CalculateBlockAveragingStandardError(&precisionSystem->BlockValues);
+    precisionSystem->RelativeError = (fabs(mean) > 0.0) ? precisionSystem->AbsoluteError / fabs(mean) : INFINITY;
+}
+
+// Adds the current lattice energy as a sample of the running MMC block to the precision abort system
+static inline void SampleMmcPrecisionAbortEnergy(SCONTEXT_PARAMETER)
+{
+    var precisionSystem = getPrecisionAbortSystem(simContext);
+    return_if(precisionSystem->BlockValues.Begin == NULL);
+    precisionSystem->BlockSampleSum += getMainStateMetaData(simContext)->LatticeEnergy;
+    ++precisionSystem->BlockSampleCount;
+}
+
 error_t FinishKmcExecutionBlock(SCONTEXT_PARAMETER)
 {
     if (!StateFlagsAreSet(simContext, STATE_FLG_PRERUN))
@@ -426,6 +660,7 @@ error_t FinishKmcExecutionBlock(SCONTEXT_PARAMETER)
         AdvanceMainCycleCounterToNextStepGoal(simContext);
     }
     ExecuteSharedMcBlockFinisher(simContext);
+    UpdatePrecisionAbortSystem(simContext);
     return SIMERROR;
 }
 
@@ -478,12 +713,18 @@ void ExecuteMmcSimulationCycle(SCONTEXT_PARAMETER)
 error_t RunOneMmcExecutionBlock(SCONTEXT_PARAMETER)
 {
     var counters = getMainCycleCounters(simContext);
+    var latticeEnergy = &getMainStateMetaData(simContext)->LatticeEnergy;
+    let factors = getPhysicalFactors(simContext);
+    let energyInfo = getJumpEnergyInfo(simContext);
     for (;counters->McsCount < counters->NextExecutionPhaseGoalMcsCount;)
     {
         let countPerLoop = counters->CycleCountPerExecutionLoop;
+        // Note: The lattice energy is tracked incrementally as for the replica exchange, the block finisher removes the accumulated rounding drift
         for (int64_t i = 0; i < countPerLoop; i++)
         {
             ExecuteMmcSimulationCycle(simContext);
+            continue_if(simContext->CycleResult != MC_ACCEPTED_CYCLE);
+            *latticeEnergy += factors->EnergyFactorKtToEv * energyInfo->S0toS2EnergyBarrier;
         }
         counters->CycleCount += countPerLoop;
         return_if(UpdateAndEvaluateMmcAbortConditions(simContext) != STATE_FLG_CONTINUE, ERR_OK);
@@ -491,10 +732,39 @@ error_t RunOneMmcExecutionBlock(SCONTEXT_PARAMETER)
     return SIMERROR;
 }
 
+// Get the alpha factor of the annealing pre-run. The effective temperature decreases geometrically from the start factor to the job temperature
+static inline double GetMmcAnnealingAlpha(SCONTEXT_PARAMETER)
+{
+    let counters = getMainCycleCounters(simContext);
+    let progress = getMinOfTwo(1.0, (double) counters->McsCount / (double) counters->PrerunGoalMcs);
+    return pow(MMC_PRERUN_TEMPERATURE_FACTOR, progress - 1.0);
+}
+
+error_t RunOneMmcAnnealingExecutionBlock(SCONTEXT_PARAMETER)
+{
+    var counters = getMainCycleCounters(simContext);
+    let countPerLoop = getMaxOfTwo(1LL, counters->PrerunGoalMcs / CYCLE_BLOCKCOUNT);
+    let stepGoalMcs = counters->McsCount + counters->McsCountPerExecutionPhase;
+    for (;(counters->McsCount < counters->PrerunGoalMcs) && (counters->McsCount < stepGoalMcs);)
+    {
+        let alpha = GetMmcAnnealingAlpha(simContext);
+        for (int64_t i = 0; i < countPerLoop; ++i)
+        {
+            ExecuteMmcSimulationCycleWithAlpha(simContext, alpha);
+        }
+        counters->CycleCount += countPerLoop;
+    }
+    return ERR_OK;
+}
+
 error_t FinishMmcExecutionBlock(SCONTEXT_PARAMETER)
 {
-    AdvanceMainCycleCounterToNextStepGoal(simContext);
+    if (!StateFlagsAreSet(simContext, STATE_FLG_PRERUN))
+    {
+        AdvanceMainCycleCounterToNextStepGoal(simContext);
+    }
     ExecuteSharedMcBlockFinisher(simContext);
+    UpdatePrecisionAbortSystem(simContext);
     return SIMERROR;
 }
 
@@ -504,14 +774,15 @@ static inline bool_t UpdateAndEvaluateTimeoutAbortCondition(SCONTEXT_PARAMETER)
     let jobInfo = getDbModelJobInfo(simContext);
     var runInfo = getRuntimeInformation(simContext);
     var metaData = getMainStateMetaData(simContext);
-    var newClock = clock();
+    // Note: The thread clock relative to the routine start keeps the limit independent of other jobs running in the same process
+    var newClock = GetCallingThreadClock();
     let deltaClock = newClock - runInfo->PreviousBlockFinishClock;
 
     metaData->TimePerBlock = (double) deltaClock / CLOCKS_PER_SEC;
     metaData->TimePerBlock = (metaData->TimePerBlock <= 0.0) ? (1.0 / CLOCKS_PER_SEC) : metaData->TimePerBlock;
     metaData->ProgramRunTime += metaData->TimePerBlock;
 
-    var nextBlockEtaClock = newClock + deltaClock;
+    var nextBlockEtaClock = newClock - runInfo->MainRoutineStartClock + deltaClock;
     runInfo->PreviousBlockFinishClock = newClock;
 
     bool_t isTimeout = nextBlockEtaClock > (jobInfo->TimeLimit * CLOCKS_PER_SEC);
@@ -539,8 +810,18 @@ static inline bool_t UpdateAndEvaluateMcsAbortCondition(SCONTEXT_PARAMETER)
     return (counters->McsCount >= counters->TotalSimulationGoalMcsCount);
 }
 
-// Evaluates the general abort conditions and returns the corresponding state flag
-static error_t EvaluateGeneralAbortConditions(SCONTEXT_PARAMETER)
+// Evaluates if the relative or absolute standard error of the block averaged observable is below the respective precision target
+static inline bool_t EvaluatePrecisionAbortCondition(SCONTEXT_PARAMETER)
+{
+    let precisionSystem = getPrecisionAbortSystem(simContext);
+    let target = getPrecisionAbortTarget(simContext);
+    let absoluteTarget = getPrecisionAbortAbsolute(simContext);
+    // Note: The relative error diverges for a block mean close to zero, e.g. a vanishing mobility, only the absolute target can end such runs
+    return ((target > 0.0) && (precisionSystem->RelativeError < target))
+        || ((absoluteTarget > 0.0) && (precisionSystem->AbsoluteError < absoluteTarget));
+}
+
+error_t UpdateAndEvaluateRuntimeAbortConditions(SCONTEXT_PARAMETER)
 {
     if (UpdateAndEvaluateTimeoutAbortCondition(simContext))
     {
@@ -555,11 +836,25 @@ static error_t EvaluateGeneralAbortConditions(SCONTEXT_PARAMETER)
         setMainStateFlags(simContext, STATE_FLG_RATEABORT | STATE_FLG_CONDABORT);
         return STATE_FLG_RATEABORT;
     }
+    return STATE_FLG_CONTINUE;
+}
+
+// Evaluates the general abort conditions and returns the corresponding state flag
+static error_t EvaluateGeneralAbortConditions(SCONTEXT_PARAMETER)
+{
+    let runtimeResult = UpdateAndEvaluateRuntimeAbortConditions(simContext);
+    return_if(runtimeResult != STATE_FLG_CONTINUE, runtimeResult);
+
     if (UpdateAndEvaluateMcsAbortCondition(simContext))
     {
         setMainStateFlags(simContext, STATE_FLG_COMPLETED | STATE_FLG_CONDABORT);
         return STATE_FLG_COMPLETED;
     }
+    if (EvaluatePrecisionAbortCondition(simContext))
+    {
+        setMainStateFlags(simContext, STATE_FLG_PRECISIONABORT | STATE_FLG_CONDABORT);
+        return STATE_FLG_PRECISIONABORT;
+    }
     return STATE_FLG_CONTINUE;
 }
 
@@ -576,7 +871,7 @@ error_t UpdateAndEvaluateKmcAbortConditions(SCONTEXT_PARAMETER)
     error_t result = 0;
     result |= EvaluatePreRunAbortConditions(simContext);
     result |= EvaluateGeneralAbortConditions(simContext);
-    return result;
+    return BroadcastDistributedAbortDecision(simContext, result);
 }
 
 // Checks if the fluctuation in the energy abort buffer indicates a relaxed system
@@ -597,6 +892,9 @@ static inline bool_t CheckMmcEnergyRelaxationAbortCondition(SCONTEXT_PARAMETER)
 error_t UpdateAndEvaluateMmcAbortConditions(SCONTEXT_PARAMETER)
 {
     return_if(EvaluateGeneralAbortConditions(simContext) != STATE_FLG_CONTINUE, STATE_FLG_CONDABORT);
+    // Note: The energy relaxation is not evaluated during the annealing pre-run
+    return_if(StateFlagsAreSet(simContext, STATE_FLG_PRERUN), EvaluatePreRunAbortConditions(simContext));
+    SampleMmcPrecisionAbortEnergy(simContext);
 
     if (CheckMmcEnergyRelaxationAbortCondition(simContext))
     {
@@ -658,6 +956,8 @@ error_t SyncSimulationStateToRunStatus(SCONTEXT_PARAMETER)
 
 error_t SaveCurrentSimulationStateToOutDirectory(SCONTEXT_PARAMETER)
 {
+    // Note: In the distributed mode only the root rank holds the gathered lattice and the merged accumulators
+    return_if(!IsDistributedRootRank(), ERR_OK);
     let stateBuffer = getMainStateBuffer(simContext);
     let targetFile = StateFlagsAreSet(simContext, STATE_FLG_PRERUN)
             ? getPreRunStateFile(simContext)
@@ -852,7 +1152,8 @@ static void SetKmcTransitionStateEnergyAlphaMethod(JumpEnergyInfo_t* restrict en
     energyInfo->S1Energy = energyInfo->S0Energy + energyInfo->RawS1Energy + 0.5 * (deltaConf - deltaAbs) + alpha * deltaAbs;
 }
 
-void SetEnergeticKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+// Sets the KMC transition state energy on the context using the energy plugin or the internal default function
+static inline void SetKmcTransitionStateEnergyOnContext(SCONTEXT_PARAMETER)
 {
     let plugins = getPluginCollection(simContext);
     let energyInfo = getJumpEnergyInfo(simContext);
@@ -866,22 +1167,39 @@ void SetEnergeticKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
     {
         plugins->OnSetTransitionStateEnergy(energyInfo);
     }
+}
 
-    // Calculates the probabilities from the set state energies
-    SetKmcJumpProbabilitiesOnContext(simContext);
+// Handles the unstable start and end cases of the current KMC event. Returns true if the event was handled
+static inline bool_t TryHandleUnstableKmcEventOnContext(SCONTEXT_PARAMETER)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
 
     // Unstable end: Do not advance system, update counter and simulated time
     if (energyInfo->S2toS0EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN)
     {
         OnKmcEventEndStateIsUnstable(simContext);
-        return;
+        return true;
     }
     // Unstable start: Advance system, update counter but not simulated time, do pool update
     if (energyInfo->S0toS2EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN)
     {
         OnKmcEventStartStateIsUnstable(simContext);
-        return;
+        return true;
     }
+    return false;
+}
+
+void SetEnergeticKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
+
+    // Calculates the probabilities from the set state energies
+    SetKmcTransitionStateEnergyOnContext(simContext);
+    SetKmcJumpProbabilitiesOnContext(simContext);
+    return_if(TryHandleUnstableKmcEventOnContext(simContext));
+    if (energyInfo->NormalizedS0toS2TransitionProbability > 1.0 && simContext->IsQuantileKmcNormalizationActive)
+        RaiseKmcQuantileNormalizationToCurrentJump(simContext);
+
     // Successful jump: Advance system, update counters and simulated time, do pool update
     let random = GetNextRandomDoubleFromContextRng(simContext);
     if (energyInfo->NormalizedS0toS2TransitionProbability >= random)
@@ -893,6 +1211,263 @@ void SetEnergeticKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
     OnKmcEventIsRejected(simContext);
 }
 
+// Checks if the current KMC event is rejected by the passed random number for every S2 correction within the energy envelope of the active rule
+static bool_t KmcEventIsRejectedByEnergyEnvelope(SCONTEXT_PARAMETER, const double random)
+{
+    let jumpCollection = getActiveJumpCollection(simContext);
+    let jumpRuleId = (int32_t) (getActiveJumpRule(simContext) - jumpCollection->JumpRules.Begin);
+    let energyInfo = getJumpEnergyInfo(simContext);
+    let envelope = getJumpEnergyEnvelopeAt(simContext, (int32_t) (jumpCollection - getJumpCollections(simContext)->Begin), jumpRuleId);
+
+    // Note: The start, transition base, field and uncorrected final energies are cheap lookups, only the S2 correction is bounded by the envelope
+    SetKmcStartTransitionBaseAndFieldEnergyStatesOnContext(simContext);
+    SetFinalKmcStateEnergyOnContext(simContext);
+    let minDeltaConf = energyInfo->S2Energy + envelope->MinS2Correction - energyInfo->S0Energy;
+    let maxDeltaConf = energyInfo->S2Energy + envelope->MaxS2Correction - energyInfo->S0Energy;
+    let minBarrierWithoutField = energyInfo->RawS1Energy + 0.5 * minDeltaConf;
+    let minBackBarrierWithoutField = energyInfo->RawS1Energy - 0.5 * maxDeltaConf;
+
+    // Note: If one of the unstable cases is possible the full evaluation has to decide
+    return_if(minBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN || minBackBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN, false);
+    let maxProbability = CalculateExp(simContext, -(minBarrierWithoutField + energyInfo->ElectricFieldEnergy)) * GetCurrentProbabilityPreFactor(simContext);
+    return maxProbability < random;
+}
+
+void SetEnvelopeCheckedKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+{
+    // Rejected jump: The random number is drawn first and the full evaluation is skipped if the best case probability is already below it
+    let random = GetNextRandomDoubleFromContextRng(simContext);
+    if (KmcEventIsRejectedByEnergyEnvelope(simContext, random))
+    {
+        OnKmcEventIsRejected(simContext);
+        return;
+    }
+
+    // Note: The start, transition base, field and uncorrected final energies of the envelope check are kept, only the S2 correction is missing
+    let energyInfo = getJumpEnergyInfo(simContext);
+    KMC_SetActiveJumpStatus(simContext);
+    SetCorrectedFinalKmcStateEnergyOnContext(simContext);
+    SetKmcTransitionStateEnergyOnContext(simContext);
+    SetKmcJumpProbabilitiesOnContext(simContext);
+    return_if(TryHandleUnstableKmcEventOnContext(simContext));
+
+    // Successful jump: Advance system, update counters and simulated time, do pool update
+    if (energyInfo->NormalizedS0toS2TransitionProbability >= random)
+    {
+        OnKmcEventIsAccepted(simContext);
+        return;
+    }
+    // Rejected jump: Do not advance system, update counter and simulated time, no pool update
+    OnKmcEventIsRejected(simContext);
+}
+
+/* Rejection-free KMC routines */
+
+// Set the KMC jump evaluation results on the context for the rejection-free mode where each selection is executed
+static void SetRejectionFreeKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
+
+    SetKmcTransitionStateEnergyOnContext(simContext);
+    SetKmcJumpProbabilitiesOnContext(simContext);
+
+    // Unstable start: Advance system, update counter but not simulated time, do pool and catalog update
+    if (energyInfo->S0toS2EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN)
+    {
+        OnRejectionFreeKmcEventStartStateIsUnstable(simContext);
+        return;
+    }
+    // Executed jump: Advance system, update counters and simulated time, do pool and catalog update
+    OnRejectionFreeKmcEventIsAccepted(simContext);
+}
+
+void ExecuteRejectionFreeKmcSimulationCycle(SCONTEXT_PARAMETER)
+{
+    SetNextRejectionFreeKmcJumpSelectionOnContext(simContext);
+    SetKmcJumpPathPropertiesOnContext(simContext);
+
+    // Note: Slots without a valid rule have a zero rate and cannot be selected
+    TrySetActiveKmcJumpRuleOnContext(simContext);
+    debug_assert(getActiveJumpRule(simContext) != NULL);
+
+    SetKmcJumpPropertiesOnContext(simContext);
+    SetRejectionFreeKmcEventEvaluationOnContext(simContext);
+}
+
+void SetNextRejectionFreeKmcJumpSelectionOnContext(SCONTEXT_PARAMETER)
+{
+    var cycleState = getCycleState(simContext);
+    cycleState->ActiveStateCode.Value = 0ULL;
+
+    RateWeightedSelectNextKmcJumpSelection(simContext);
+    SetActivePathStartEnvironment(simContext);
+    SetActiveJumpDirectionAndCollection(simContext);
+    SetActiveCounterCollection(simContext);
+}
+
+// Evaluates the energies and probabilities of the KMC jump [EnvironmentId][RelativeJumpId] on the context without system advance. Returns false if the jump is blocked
+static bool_t TrySetKmcJumpEvaluationByIdsOnContext(SCONTEXT_PARAMETER, const int32_t environmentId, const int32_t relativeJumpId)
+{
+    var cycleState = getCycleState(simContext);
+
+    cycleState->ActiveStateCode.Value = 0ULL;
+    cycleState->ActiveSelectionInfo.EnvironmentId = environmentId;
+    cycleState->ActiveSelectionInfo.RelativeJumpId = relativeJumpId;
+
+    SetActivePathStartEnvironment(simContext);
+    SetActiveJumpDirectionAndCollection(simContext);
+    SetKmcJumpPathPropertiesOnContext(simContext);
+    return_if(TrySetActiveKmcJumpRuleOnContext(simContext) == NULL, false);
+
+    SetKmcJumpPropertiesOnContext(simContext);
+    SetKmcTransitionStateEnergyOnContext(simContext);
+    SetKmcJumpProbabilitiesOnContext(simContext);
+    return true;
+}
+
+double EvaluateKmcJumpNormalizationProbabilityByIds(SCONTEXT_PARAMETER, const int32_t environmentId, const int32_t relativeJumpId)
+{
+    return_if(!TrySetKmcJumpEvaluationByIdsOnContext(simContext, environmentId, relativeJumpId), 0.0);
+
+    // Note: Identical to the backjump safe update of the auto optimization pre-run, values above the jump limit do not affect the normalization
+    return getMaxOfTwo(0.0, GetBackjumpSafeRawJumpProbability(simContext));
+}
+
+double EvaluateKmcJumpRateByIds(SCONTEXT_PARAMETER, const int32_t environmentId, const int32_t relativeJumpId)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
+    return_if(!TrySetKmcJumpEvaluationByIdsOnContext(simContext, environmentId, relativeJumpId), 0.0);
+
+    // Unstable end states are never entered by the default KMC routine and are thus excluded by a zero rate
+    return_if(energyInfo->S2toS0EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN, 0.0);
+    return getActiveJumpRule(simContext)->FrequencyFactor * energyInfo->RawS0toS2TransitionProbability;
+}
+
+/* Sublattice parallel KMC routines */
+
+// Set the KMC jump evaluation results on the context for a sector cycle of the sublattice parallel mode
+static void SetSectorKmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
+
+    SetKmcTransitionStateEnergyOnContext(simContext);
+    SetKmcJumpProbabilitiesOnContext(simContext);
+
+    // Unstable end: Do not advance system, update counter
+    if (energyInfo->S2toS0EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN)
+    {
+        OnKmcEventEndStateIsUnstable(simContext);
+        return;
+    }
+    // Unstable start: Advance system, update counter
+    if (energyInfo->S0toS2EnergyBarrierWithoutField <= MC_CONST_JUMPLIMIT_MIN)
+    {
+        OnSectorKmcEventStartStateIsUnstable(simContext);
+        return;
+    }
+    // Successful jump: Advance system, update counters
+    let random = GetNextRandomDoubleFromContextRng(simContext);
+    if (energyInfo->NormalizedS0toS2TransitionProbability >= random)
+    {
+        OnSectorKmcEventIsAccepted(simContext);
+        return;
+    }
+    // Rejected jump: Do not advance system, update counter
+    OnKmcEventIsRejected(simContext);
+}
+
+void ExecuteSectorKmcSimulationCycle(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, const int32_t slotsPerEnvironment)
+{
+    var cycleState = getCycleState(simContext);
+    cycleState->ActiveStateCode.Value = 0ULL;
+
+    if (!TryUniformSelectNextKmcJumpSlot(simContext, environmentIds, slotsPerEnvironment))
+    {
+        simContext->CycleResult = MC_NULLSLOT_CYCLE;
+        return;
+    }
+
+    SetActivePathStartEnvironment(simContext);
+    SetActiveJumpDirectionAndCollection(simContext);
+    SetActiveCounterCollection(simContext);
+    SetKmcJumpPathPropertiesOnContext(simContext);
+
+    if (TrySetActiveKmcJumpRuleOnContext(simContext))
+    {
+        #if defined(OPT_PRECHECK_FREQUENCY)
+        if (CheckKmcEventFrequencySkip(simContext))
+        {
+            OnKmcEventIsFrequencySkipped(simContext);
+            return;
+        }
+        #endif
+        SetKmcJumpPropertiesOnContext(simContext);
+        SetSectorKmcEventEvaluationOnContext(simContext);
+        return;
+    }
+
+    OnKmcEventIsSiteBlocked(simContext);
+}
+
+/* Sublattice parallel MMC routines */
+
+// Action for cases where the sector MMC jump selection has been statistically accepted (No selection pool and abort buffer update)
+static inline void OnSectorMmcEventIsAccepted(SCONTEXT_PARAMETER)
+{
+    var activeCounters = getActiveCounters(simContext);
+    var cycleCounters = getMainCycleCounters(simContext);
+
+    ++activeCounters->McsCount;
+    ++cycleCounters->McsCount;
+
+    AdvanceMmcSystemToFinalState(simContext);
+    simContext->CycleResult = MC_ACCEPTED_CYCLE;
+}
+
+// Set the MMC jump evaluation results on the context for a sector cycle of the sublattice parallel mode
+static void SetSectorMmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
+{
+    let energyInfo = getJumpEnergyInfo(simContext);
+
+    SetMmcJumpProbabilitiesOnContext(simContext);
+
+    // Handle case where the jump is statistically accepted
+    let random = GetNextRandomDoubleFromContextRng(simContext);
+    if (energyInfo->NormalizedS0toS2TransitionProbability >= random)
+    {
+        OnSectorMmcEventIsAccepted(simContext);
+        return;
+    }
+    // Handle case where the jump is statistically rejected
+    OnMmcEventIsRejected(simContext);
+}
+
+void ExecuteSectorMmcSimulationCycle(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, const int32_t slotsPerEnvironment)
+{
+    var cycleState = getCycleState(simContext);
+    cycleState->ActiveStateCode.Value = 0ULL;
+
+    if (!TryUniformSelectNextMmcJumpSlot(simContext, environmentIds, slotsPerEnvironment))
+    {
+        simContext->CycleResult = MC_NULLSLOT_CYCLE;
+        return;
+    }
+
+    SetActivePathStartEnvironment(simContext);
+    SetActiveCounterCollection(simContext);
+    SetActiveJumpDirectionAndCollection(simContext);
+    SetMmcJumpPathPropertiesOnContext(simContext);
+
+    if (TrySetActiveMmcJumpRuleOnContext(simContext))
+    {
+        SetMmcJumpPropertiesOnContext(simContext);
+        SetSectorMmcEventEvaluationOnContext(simContext);
+        return;
+    }
+
+    OnMmcEventIsSiteBlocked(simContext);
+}
+
 void SetNextMmcJumpSelectionOnContext(SCONTEXT_PARAMETER)
 {
     UniformSelectNextMmcJumpSelection(simContext);
@@ -935,7 +1510,7 @@ void SetMmcJumpProbabilitiesOnContext(SCONTEXT_PARAMETER)
 
     energyInfo->S0toS2EnergyBarrier = energyInfo->S2Energy - energyInfo->S0Energy;
     energyInfo->RawS0toS2TransitionProbability = CalculateExp(simContext, -energyInfo->S0toS2EnergyBarrier);
-    energyInfo->NormalizedS0toS2TransitionProbability = energyInfo->RawS0toS2TransitionProbability;
+    energyInfo->NormalizedS0toS2TransitionProbability = energyInfo->RawS0toS2TransitionProbability * GetMmcSelectionProposalRatio(simContext);
 }
 
 void SetEnergeticMmcEventEvaluationOnContext(SCONTEXT_PARAMETER)
@@ -988,7 +1563,7 @@ void OnEnergeticMmcJumpEvaluationWithAlpha(SCONTEXT_PARAMETER, double alpha)
 
     // Handle case where the jump is statistically accepted
     let random = GetNextRandomDoubleFromContextRng(simContext);
-    if (energyInfo->RawS0toS2TransitionProbability >= random)
+    if (energyInfo->RawS0toS2TransitionProbability * GetMmcSelectionProposalRatio(simContext) >= random)
     {
         OnMmcEventIsAccepted(simContext);
         return;
@@ -996,3 +1571,31 @@ void OnEnergeticMmcJumpEvaluationWithAlpha(SCONTEXT_PARAMETER, double alpha)
     // Handle case where the jump is statistically rejected
     OnMmcEventIsRejected(simContext);
 }
+
+bool_t TrySetNextMmcJumpEnergiesOnContext(SCONTEXT_PARAMETER)
+{
+    var energyInfo = getJumpEnergyInfo(simContext);
+
+    SetNextMmcJumpSelectionOnContext(simContext);
+    SetMmcJumpPathPropertiesOnContext(simContext);
+
+    if (TrySetActiveMmcJumpRuleOnContext(simContext))
+    {
+        SetMmcJumpPropertiesOnContext(simContext);
+        energyInfo->S0toS2EnergyBarrier = energyInfo->S2Energy - energyInfo->S0Energy;
+        return true;
+    }
+
+    OnMmcEventIsSiteBlocked(simContext);
+    return false;
+}
+
+void SetExternalMmcEventEvaluationOnContext(SCONTEXT_PARAMETER, const bool_t isAccepted)
+{
+    if (isAccepted)
+    {
+        OnMmcEventIsAccepted(simContext);
+        return;
+    }
+    OnMmcEventIsRejected(simContext);
+}
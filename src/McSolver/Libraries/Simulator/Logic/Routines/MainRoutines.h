@@ -19,6 +19,9 @@
 // Prepares the simulation context for the main simulation routine
 void PrepareSimulationContextForMainRoutine(SCONTEXT_PARAMETER);
 
+// Advances the step goal beyond the current mcs count and sets the runtime clocks to the current time (Required after a reset of the cycle counters)
+void SyncMainRoutineStartConditions(SCONTEXT_PARAMETER);
+
 // Synchronizes the main simulation state to the current simulation status
 error_t SyncSimulationStateToRunStatus(SCONTEXT_PARAMETER);
 
@@ -36,6 +39,9 @@ error_t SaveCurrentSimulationStateToOutDirectory(SCONTEXT_PARAMETER);
 
 /* Main simulation routine functions with errors */
 
+// Checks if the simulation goal of the main simulation routine is already reached
+bool_t IsMainSimulationRoutineCompleted(SCONTEXT_PARAMETER);
+
 // Top level entry point for the main simulation routine including a potential pre-run
 error_t StartMainSimulationRoutine(SCONTEXT_PARAMETER);
 
@@ -61,6 +67,9 @@ error_t StartKmcMainRoutine(SCONTEXT_PARAMETER);
 // Run the kmc simulation for one execution block
 error_t RunOneKmcExecutionBlock(SCONTEXT_PARAMETER);
 
+// Run the kmc simulation for one execution block using the rejection-free event selection
+error_t RunOneRejectionFreeKmcExecutionBlock(SCONTEXT_PARAMETER);
+
 // Finishes a kmc execution phase
 error_t FinishKmcExecutionBlock(SCONTEXT_PARAMETER);
 
@@ -72,12 +81,15 @@ error_t FinishMainKmcRoutine(SCONTEXT_PARAMETER);
 
 /* MMC routine */
 
-// Start the MMC pre run routine (Not implemented)
+// Start the MMC pre run routine that anneals the lattice from an elevated effective temperature down to the job temperature
 error_t StartMmcPreRunRoutine(SCONTEXT_PARAMETER);
 
-// Finishes the MMC pre run routine (Not implemented)
+// Finishes the MMC pre run routine
 error_t FinishMmcPreRunRoutine(SCONTEXT_PARAMETER);
 
+// Run the annealing mmc simulation for one execution block of the pre run
+error_t RunOneMmcAnnealingExecutionBlock(SCONTEXT_PARAMETER);
+
 // Run the mmc simulation for one execution block
 error_t RunOneMmcExecutionBlock(SCONTEXT_PARAMETER);
 
@@ -90,6 +102,9 @@ error_t FinishMmcExecutionBlock(SCONTEXT_PARAMETER);
 // Updates and evaluates the abort conditions for a nmc simulation
 error_t UpdateAndEvaluateMmcAbortConditions(SCONTEXT_PARAMETER);
 
+// Updates and evaluates only the timeout and rate abort conditions and returns the corresponding state flag
+error_t UpdateAndEvaluateRuntimeAbortConditions(SCONTEXT_PARAMETER);
+
 // Finishes the main mmc routine
 error_t FinishMmcMainRoutine(SCONTEXT_PARAMETER);
 
@@ -116,9 +131,40 @@ void SetKmcJumpPropertiesOnContext(SCONTEXT_PARAMETER);
 // Set the KMC jump evaluation results on the context for cases where energetic evaluation is required
 void SetEnergeticKmcEventEvaluationOnContext(SCONTEXT_PARAMETER);
 
+// Set the KMC jump evaluation results on the context with an early rejection by the energy envelope of the active rule before the full energetic evaluation
+void SetEnvelopeCheckedKmcEventEvaluationOnContext(SCONTEXT_PARAMETER);
+
 // Set the KMC jump probabilities on the context by the default model calculation
 void SetKmcJumpProbabilitiesOnContext(SCONTEXT_PARAMETER);
 
+/* Rejection-free KMC simulation non-error sub-routines */
+
+// Executes one cycle of the rejection-free KMC simulation routine with the passed simulation context
+void ExecuteRejectionFreeKmcSimulationCycle(SCONTEXT_PARAMETER);
+
+// Set the next rate weighted KMC jump selection from the rate catalog on the context
+void SetNextRejectionFreeKmcJumpSelectionOnContext(SCONTEXT_PARAMETER);
+
+// Evaluates the rate of the KMC jump [EnvironmentId][RelativeJumpId] in units of the attempt frequency modulus without system advance (Zero for blocked or end unstable jumps)
+double EvaluateKmcJumpRateByIds(SCONTEXT_PARAMETER, int32_t environmentId, int32_t relativeJumpId);
+
+// Evaluates the raw probability of the KMC jump [EnvironmentId][RelativeJumpId] that is relevant for the jump normalization without system advance
+// (Includes the backjump probability as the auto optimization pre-run, zero for blocked jumps or jumps above the jump limit)
+double EvaluateKmcJumpNormalizationProbabilityByIds(SCONTEXT_PARAMETER, int32_t environmentId, int32_t relativeJumpId);
+
+/* Sublattice parallel KMC simulation non-error sub-routines */
+
+// Executes one cycle of the KMC simulation on a uniform jump slot of the passed sector environments (Does not update the selection pool and the simulated time)
+void ExecuteSectorKmcSimulationCycle(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, int32_t slotsPerEnvironment);
+
+/* Sublattice parallel MMC simulation non-error sub-routines */
+
+// Executes one cycle of the MMC simulation on a uniform jump slot of the passed sector environments with a partner of the same sector (Does not update the selection pool and the abort buffer)
+void ExecuteSectorMmcSimulationCycle(SCONTEXT_PARAMETER, const IdMappingSpan_t*restrict environmentIds, int32_t slotsPerEnvironment);
+
+// Writes the summed delta energy in [kT] of the passed number of accepted MMC jumps to the abort buffer (If the abort tolerance is equal or below 0, the buffer write is skipped)
+void WriteMmcEnergyChangeSumToAbortBuffer(SCONTEXT_PARAMETER, double energyChange, int64_t jumpCount);
+
 /* MMC simulation non-error sub-routines */
 
 // Executes one cycle of the MMC simulation routine with the passed simulation context
@@ -151,4 +197,10 @@ void ExecuteMmcSimulationCycleWithAlpha(SCONTEXT_PARAMETER, double alpha);
 void SetMmcJumpProbabilitiesOnContextWithAlpha(SCONTEXT_PARAMETER, double alpha);
 
 // Set the MMC jump evaluation results on the context for cases where energetic evaluation is required (Exp factor is multiplied with alpha)
-void OnEnergeticMmcJumpEvaluationWithAlpha(SCONTEXT_PARAMETER, double alpha);
\ No newline at end of file
+void OnEnergeticMmcJumpEvaluationWithAlpha(SCONTEXT_PARAMETER, double alpha);
+
+// Selects the next MMC jump and sets the state energies and the S0 to S2 energy change in [kT] on the context without evaluation. Returns false if the selection is site-blocking
+bool_t TrySetNextMmcJumpEnergiesOnContext(SCONTEXT_PARAMETER);
+
+// Applies an externally decided acceptance or rejection to the MMC jump that was prepared by the energy setter
+void SetExternalMmcEventEvaluationOnContext(SCONTEXT_PARAMETER, bool_t isAccepted);
\ No newline at end of file
@@ -0,0 +1,192 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ParameterSweepRoutines.c	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Parameter sweep routines    //
+//////////////////////////////////////////
+
+#include <string.h>
+#include "ParameterSweepRoutines.h"
+#include "Libraries/Framework/Basic/FileIO.h"
+#include "Libraries/ProgressPrint/ProgressPrint.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Initialization/CmdArgumentResolver.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
+
+// Type for a single point of the parameter sweep
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef struct SweepPoint
+{
+    // The temperature of the point in [K]
+    double  Temperature;
+
+    // The electric field modulus of the point in [V/m]
+    double  FieldModulus;
+
+} SweepPoint_t;
+
+// Type for the point span of the parameter sweep
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(SweepPoint_t, SweepPoints) SweepPoints_t;
+
+// Type for the unconverted electric field factors of the jump directions in [eV * m/V]
+// Layout@ggc_x86_64 => 16@[8,8]
+typedef Span_t(double, SweepFieldFactors) SweepFieldFactors_t;
+
+// Type for the parameter sweep run information
+// Layout@ggc_x86_64 => 40@[16,16,8]
+typedef struct ParameterSweep
+{
+    // The points of the sweep
+    SweepPoints_t       Points;
+
+    // The unconverted field factors of the jump directions (Empty for MMC)
+    SweepFieldFactors_t RawFieldFactors;
+
+    // The I/O directory that contains the sweep point folders
+    char const*         BaseIoPath;
+
+} ParameterSweep_t;
+
+// Builds the sweep points from the command line value lists, missing lists use the job values for all points
+static void BuildParameterSweepPoints(SCONTEXT_PARAMETER, ParameterSweep_t*restrict sweep)
+{
+    let overwrites = getCommandArgumentOverwrites(simContext);
+    let isKmc = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC);
+    let temperatureCount = ParseSweepValueString(overwrites->SweepTemperatures, NULL);
+    let fieldCount = ParseSweepValueString(overwrites->SweepFieldModuli, NULL);
+    let pointCount = getMaxOfTwo(temperatureCount, fieldCount);
+
+    assert_true(temperatureCount == 0 || fieldCount == 0 || temperatureCount == fieldCount, ERR_CMDARGUMENT,
+                "The temperature and field lists of the parameter sweep require the same number of values.");
+    assert_true(isKmc || fieldCount == 0, ERR_CMDARGUMENT, "The field sweep requires a KMC job.");
+
+    double temperatures[pointCount], fieldModuli[pointCount];
+    ParseSweepValueString(overwrites->SweepTemperatures, temperatures);
+    ParseSweepValueString(overwrites->SweepFieldModuli, fieldModuli);
+
+    sweep->Points = span_New(sweep->Points, pointCount);
+    for (int32_t i = 0; i < pointCount; i++)
+    {
+        var point = &span_Get(sweep->Points, i);
+        point->Temperature = (temperatureCount > 0) ? temperatures[i] : getDbModelJobInfo(simContext)->Temperature;
+        point->FieldModulus = (fieldCount > 0) ? fieldModuli[i] : (isKmc ? getDbModelJobHeaderAsKMC(simContext)->ElectricFieldModulus : 0.0);
+        assert_true(point->Temperature > 0.0, ERR_CMDARGUMENT, "The temperatures of the parameter sweep have to be positive.");
+    }
+}
+
+// Stores the unconverted electric field factors of the jump directions as they are lost by the in place conversion to [kT]
+static void CopyRawFieldFactorsToSweep(SCONTEXT_PARAMETER, ParameterSweep_t*restrict sweep)
+{
+    sweep->RawFieldFactors = (SweepFieldFactors_t) {.Begin = NULL, .End = NULL};
+    return_if(!JobInfoFlagsAreSet(simContext, INFO_FLG_KMC));
+
+    let jumpDirections = getJumpDirections(simContext);
+    sweep->RawFieldFactors = span_New(sweep->RawFieldFactors, span_Length(*jumpDirections));
+    for (int32_t i = 0; i < span_Length(*jumpDirections); i++)
+        span_Get(sweep->RawFieldFactors, i) = span_Get(*jumpDirections, i).ElectricFieldFactor;
+}
+
+// Sets the temperature and field of the passed point on the database model job data
+static void SetSweepPointOnDbModel(SCONTEXT_PARAMETER, const SweepPoint_t*restrict point)
+{
+    getDbModelJobInfo(simContext)->Temperature = point->Temperature;
+    if (JobInfoFlagsAreSet(simContext, INFO_FLG_KMC))
+        getDbModelJobHeaderAsKMC(simContext)->ElectricFieldModulus = point->FieldModulus;
+}
+
+// Sets the field factors of the jump directions to the field of the passed point using the current energy conversion factor
+static void SetSweepPointFieldFactors(SCONTEXT_PARAMETER, const ParameterSweep_t*restrict sweep, const SweepPoint_t*restrict point)
+{
+    return_if(!JobInfoFlagsAreSet(simContext, INFO_FLG_KMC));
+    var jumpDirections = getJumpDirections(simContext);
+
+    // Note: Correction by 0.5 as only half of the potential energy can actually affect the migration barrier!
+    let factor = 0.5 * getPhysicalFactors(simContext)->EnergyFactorEvToKt * point->FieldModulus;
+    for (int32_t i = 0; i < span_Length(*jumpDirections); i++)
+        span_Get(*jumpDirections, i).ElectricFieldFactor = span_Get(sweep->RawFieldFactors, i) * factor;
+}
+
+// Finds the id of the last sweep point that has a state file, the series is resumed from this point. Returns zero if no state file exists
+static int32_t FindParameterSweepResumePointId(const ParameterSweep_t*restrict sweep)
+{
+    char path[strlen(sweep->BaseIoPath) + CMD_JOBQUERY_BYTECOUNT + sizeof(CMD_SWEEP_POINTFOLDER_FORMAT "/" FILE_PRERSTATE)];
+    for (int32_t pointId = (int32_t) span_Length(sweep->Points) - 1; pointId > 0; pointId--)
+    {
+        sprintf(path, CMD_SWEEP_POINTFOLDER_FORMAT "/" FILE_MAINSTATE, sweep->BaseIoPath, pointId);
+        return_if(IsAccessibleFile(path), pointId);
+        sprintf(path, CMD_SWEEP_POINTFOLDER_FORMAT "/" FILE_PRERSTATE, sweep->BaseIoPath, pointId);
+        return_if(IsAccessibleFile(path), pointId);
+    }
+    return 0;
+}
+
+// Checks that the parameter sweep is not combined with routines that cache temperature dependent data on initialization
+static void AssertParameterSweepIsSupported(SCONTEXT_PARAMETER)
+{
+    assert_true(!simContext->IsRejectionFreeKmcActive && !simContext->IsSublatticeParallelKmcActive, ERR_CMDARGUMENT,
+                "The parameter sweep mode cannot be combined with the rejection-free or sublattice parallel KMC routines.");
+    assert_true(!simContext->IsReplicaExchangeMmcActive && !simContext->IsSublatticeParallelMmcActive, ERR_CMDARGUMENT,
+                "The parameter sweep mode cannot be combined with the replica exchange or sublattice parallel MMC routines.");
+}
+
+// Prepares the already initialized context for the sweep point with the passed id
+static void PrepareContextForSweepPoint(SCONTEXT_PARAMETER, const ParameterSweep_t*restrict sweep, const int32_t pointId)
+{
+    let point = &span_Get(sweep->Points, pointId);
+    var error = ResolveMocassinSweepPointArguments(simContext, sweep->BaseIoPath, pointId);
+    assert_success(error, "Failed to prepare the I/O directory of a sweep point.");
+
+    error = ResetContextForParameterSweepPoint(simContext, point->Temperature);
+    assert_success(error, "Failed to reset the simulation context for a sweep point.");
+
+    SetSweepPointOnDbModel(simContext, point);
+    SetSweepPointFieldFactors(simContext, sweep, point);
+    SyncMainRoutineStartConditions(simContext);
+}
+
+void StartParameterSweepRoutine(SCONTEXT_PARAMETER)
+{
+    assert_true(GetDistributedRankCount() == 1, ERR_CMDARGUMENT, "The parameter sweep mode cannot be combined with the distributed mode.");
+    assert_true(!simContext->IsWarmStartNormalizationActive, ERR_CMDARGUMENT, "The parameter sweep mode cannot import the normalization of a warm start.");
+
+    ParameterSweep_t sweep = {.BaseIoPath = getFileInformation(simContext)->IODirectoryPath};
+    BuildParameterSweepPoints(simContext, &sweep);
+    CopyRawFieldFactorsToSweep(simContext, &sweep);
+
+    // Note: The first point is initialized as a normal job, this also resumes an interrupted point from its state file
+    let startPointId = FindParameterSweepResumePointId(&sweep);
+    SetSweepPointOnDbModel(simContext, &span_Get(sweep.Points, startPointId));
+    var error = ResolveMocassinSweepPointArguments(simContext, sweep.BaseIoPath, startPointId);
+    assert_success(error, "Failed to prepare the I/O directory of a sweep point.");
+    PrepareSimulationContextForMainRoutine(simContext);
+    AssertParameterSweepIsSupported(simContext);
+
+    for (int32_t pointId = startPointId; pointId < span_Length(sweep.Points); pointId++)
+    {
+        if (pointId != startPointId) PrepareContextForSweepPoint(simContext, &sweep, pointId);
+
+        let point = &span_Get(sweep.Points, pointId);
+        fprintf(stdout, "[Sweep-Info]: Point %i of %i (T=%.2f [K], E=%.4e [V/m]) in %s\n", pointId + 1, (int32_t) span_Length(sweep.Points),
+                point->Temperature, point->FieldModulus, getFileInformation(simContext)->IODirectoryPath);
+        fflush(stdout);
+        if (IsMainSimulationRoutineCompleted(simContext))
+        {
+            fprintf(stdout, "[Sweep-Info]: Point %i is already completed.\n", pointId + 1);
+            continue;
+        }
+
+        StartMainSimulationRoutine(simContext);
+        PrintMocassinSimulationFinishInfo(simContext, stdout);
+        fprintf(stdout, "\n");
+    }
+
+    span_Delete(sweep.RawFieldFactors);
+    span_Delete(sweep.Points);
+}
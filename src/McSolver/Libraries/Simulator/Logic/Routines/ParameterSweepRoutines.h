@@ -0,0 +1,20 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ParameterSweepRoutines.h	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Parameter sweep routines    //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* Parameter sweep routine */
+
+// Runs the temperature/field series of the parameter sweep mode on a single initialized context. Each point is simulated to its own sweep folder
+// below the I/O directory and starts from the final lattice of the previous point (Requires a loaded database model, an existing sweep folder resumes the series)
+void StartParameterSweepRoutine(SCONTEXT_PARAMETER);
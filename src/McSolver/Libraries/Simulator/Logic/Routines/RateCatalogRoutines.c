@@ -0,0 +1,229 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	RateCatalogRoutines.c  		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Rejection-free KMC catalog  //
+//////////////////////////////////////////
+
+#include "RateCatalogRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+
+/* Local helper routines */
+
+// Recalculates the sum tree nodes on the path from the passed node index to the root node
+static inline void PropagateRateSumTreeChange(RateSumTree_t*restrict sumTree, int32_t nodeId)
+{
+    for (nodeId >>= 1; nodeId > 0; nodeId >>= 1)
+        span_Get(*sumTree, nodeId) = span_Get(*sumTree, 2 * nodeId) + span_Get(*sumTree, 2 * nodeId + 1);
+}
+
+// Sets the rate of the passed slot id on the rate catalog and updates the sum tree
+static inline void SetRateCatalogSlotRate(KmcRateCatalog_t*restrict rateCatalog, const int32_t slotId, const double rate)
+{
+    let nodeId = rateCatalog->LeafCount + slotId;
+    return_if(span_Get(rateCatalog->RateSumTree, nodeId) == rate);
+    span_Get(rateCatalog->RateSumTree, nodeId) = rate;
+    PropagateRateSumTreeChange(&rateCatalog->RateSumTree, nodeId);
+}
+
+// Evaluates the current rates of all slots of the passed environment id and writes them to the passed rate buffer
+static void EvaluateEnvironmentSlotRates(SCONTEXT_PARAMETER, const int32_t environmentId, double*restrict rateBuffer)
+{
+    let rateCatalog = getKmcRateCatalog(simContext);
+    let environment = getEnvironmentStateAt(simContext, environmentId);
+    let jumpCount = (environment->PoolId == JPOOL_NOT_SELECTABLE)
+            ? 0
+            : getJumpCountAt(simContext, environment->LatticeVector.D, environment->ParticleId);
+
+    for (int32_t relativeJumpId = 0; relativeJumpId < rateCatalog->SlotsPerEnvironment; ++relativeJumpId)
+    {
+        rateBuffer[relativeJumpId] = (relativeJumpId < jumpCount)
+                ? EvaluateKmcJumpRateByIds(simContext, environmentId, relativeJumpId)
+                : 0.0;
+    }
+}
+
+// Refreshes the rates of all slots of the passed environment id and updates the sum tree
+static void RefreshEnvironmentSlotRates(SCONTEXT_PARAMETER, const int32_t environmentId)
+{
+    var rateCatalog = getKmcRateCatalog(simContext);
+    double rateBuffer[rateCatalog->SlotsPerEnvironment];
+
+    EvaluateEnvironmentSlotRates(simContext, environmentId, rateBuffer);
+    let slotOffset = environmentId * rateCatalog->SlotsPerEnvironment;
+    for (int32_t i = 0; i < rateCatalog->SlotsPerEnvironment; ++i)
+        SetRateCatalogSlotRate(rateCatalog, slotOffset + i, rateBuffer[i]);
+}
+
+// Adds the passed environment id to the refresh pool if it is not already contained
+static inline void AddEnvironmentToRefreshPool(KmcRateCatalog_t*restrict rateCatalog, const int32_t environmentId)
+{
+    return_if(span_Get(rateCatalog->RefreshMarkers, environmentId) != 0);
+    span_Get(rateCatalog->RefreshMarkers, environmentId) = 1;
+    list_PushBack(rateCatalog->RefreshPool, environmentId);
+}
+
+// Adds the passed environment and all jump path start environments that can contain it as a path member to the refresh pool
+static void AddPathOriginsToRefreshPool(SCONTEXT_PARAMETER, KmcRateCatalog_t*restrict rateCatalog, const EnvironmentState_t*restrict environment)
+{
+    let latticeSizes = getLatticeSizeVector(simContext);
+    let positionId = environment->LatticeVector.D;
+    let offsetBegin = span_Get(rateCatalog->PathOriginOffsetBegins, positionId);
+    let offsetEnd = span_Get(rateCatalog->PathOriginOffsetBegins, positionId + 1);
+
+    AddEnvironmentToRefreshPool(rateCatalog, getEnvironmentStateIdByPointer(simContext, environment));
+    for (int32_t i = offsetBegin; i < offsetEnd; ++i)
+    {
+        var originVector = SubtractVector4(&environment->LatticeVector, &span_Get(rateCatalog->PathOriginOffsets, i));
+        PeriodicTrimVector4(&originVector, latticeSizes);
+        let originId = getEnvironmentStateIdByPointer(simContext, getEnvironmentStateByVector4(simContext, &originVector));
+        AddEnvironmentToRefreshPool(rateCatalog, originId);
+    }
+}
+
+/* Initializer routines */
+
+// Counts the jump path members of all jump directions by their position id and writes the begin indices of the path origin offsets
+static void ConstructPathOriginOffsetBegins(SCONTEXT_PARAMETER, IdMappingSpan_t*restrict outOffsetBegins)
+{
+    let positionCount = getLatticeSizeVector(simContext)->D;
+    var offsetBegins = span_New(*outOffsetBegins, positionCount + 1);
+
+    cpp_foreach(jumpDirection, *getJumpDirections(simContext))
+    {
+        cpp_foreach(jumpVector, jumpDirection->JumpSequence)
+            ++span_Get(offsetBegins, jumpDirection->PositionId + jumpVector->D + 1);
+    }
+    for (int32_t i = 1; i <= positionCount; ++i)
+        span_Get(offsetBegins, i) += span_Get(offsetBegins, i - 1);
+
+    *outOffsetBegins = offsetBegins;
+}
+
+void ConstructPathOriginOffsets(SCONTEXT_PARAMETER, PathOriginOffsets_t*restrict outOffsets, IdMappingSpan_t*restrict outOffsetBegins)
+{
+    ConstructPathOriginOffsetBegins(simContext, outOffsetBegins);
+
+    let positionCount = getLatticeSizeVector(simContext)->D;
+    let offsetCount = span_Get(*outOffsetBegins, positionCount);
+    int32_t writeCounters[positionCount];
+    memset(writeCounters, 0, sizeof(writeCounters));
+
+    *outOffsets = span_New(*outOffsets, offsetCount);
+    cpp_foreach(jumpDirection, *getJumpDirections(simContext))
+    {
+        cpp_foreach(jumpVector, jumpDirection->JumpSequence)
+        {
+            let positionId = jumpDirection->PositionId + jumpVector->D;
+            let writeId = span_Get(*outOffsetBegins, positionId) + writeCounters[positionId]++;
+            span_Get(*outOffsets, writeId) = *jumpVector;
+        }
+    }
+}
+
+// Allocates the rate sum tree and refresh buffers of the rate catalog
+static error_t AllocateRateCatalogBuffers(SCONTEXT_PARAMETER, KmcRateCatalog_t*restrict rateCatalog)
+{
+    let environmentCount = (int32_t) array_Length(*getEnvironmentLattice(simContext));
+
+    rateCatalog->SlotsPerEnvironment = FindMaxJumpDirectionCount(getJumpCountMapping(simContext));
+    rateCatalog->LeafCount = environmentCount * rateCatalog->SlotsPerEnvironment;
+    return_if(rateCatalog->LeafCount <= 0, ERR_NOMOBILES);
+
+    rateCatalog->RateSumTree = span_New(rateCatalog->RateSumTree, 2 * rateCatalog->LeafCount);
+    rateCatalog->RefreshPool = list_New(rateCatalog->RefreshPool, environmentCount);
+    rateCatalog->RefreshMarkers = span_New(rateCatalog->RefreshMarkers, environmentCount);
+    return ERR_OK;
+}
+
+// Evaluates the rates of all slots and constructs the sum tree bottom up
+static void PopulateRateSumTree(SCONTEXT_PARAMETER, KmcRateCatalog_t*restrict rateCatalog)
+{
+    let environmentCount = (int32_t) array_Length(*getEnvironmentLattice(simContext));
+    var sumTree = &rateCatalog->RateSumTree;
+
+    for (int32_t environmentId = 0; environmentId < environmentCount; ++environmentId)
+    {
+        let leafOffset = rateCatalog->LeafCount + environmentId * rateCatalog->SlotsPerEnvironment;
+        EvaluateEnvironmentSlotRates(simContext, environmentId, &span_Get(*sumTree, leafOffset));
+    }
+    for (int32_t nodeId = rateCatalog->LeafCount - 1; nodeId > 0; --nodeId)
+        span_Get(*sumTree, nodeId) = span_Get(*sumTree, 2 * nodeId) + span_Get(*sumTree, 2 * nodeId + 1);
+}
+
+void BuildKmcRateCatalog(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsRejectionFreeKmcActive);
+    var rateCatalog = getKmcRateCatalog(simContext);
+
+    rateCatalog->RateToHzFactor = getDbModelJobHeaderAsKMC(simContext)->AttemptFrequencyModulus;
+    let error = AllocateRateCatalogBuffers(simContext, rateCatalog);
+    assert_success(error, "Cannot build the KMC rate catalog, the lattice does not contain any jump slots.");
+
+    ConstructPathOriginOffsets(simContext, &rateCatalog->PathOriginOffsets, &rateCatalog->PathOriginOffsetBegins);
+    PopulateRateSumTree(simContext, rateCatalog);
+
+    printf("[Init-Info]: KMC rate catalog BUILD [SLOT_COUNT=%i, TOTAL_RATE=%e Hz]\n",
+           rateCatalog->LeafCount, GetKmcRateCatalogTotalRate(rateCatalog) * rateCatalog->RateToHzFactor);
+}
+
+/* Simulation routines */
+
+void RateWeightedSelectNextKmcJumpSelection(SCONTEXT_PARAMETER)
+{
+    let rateCatalog = getKmcRateCatalog(simContext);
+    let sumTree = &rateCatalog->RateSumTree;
+    var selectionInfo = getJumpSelectionInfo(simContext);
+    int32_t nodeId;
+    assert_true(GetKmcRateCatalogTotalRate(rateCatalog) > 0.0, ERR_NOMOBILES, "The KMC rate catalog does not contain any executable jump.");
+
+    // Note: Rounding can lead the descent into a zero rate leaf, in that case the roll is repeated
+    do
+    {
+        var random = GetNextRandomDoubleFromContextRng(simContext) * GetKmcRateCatalogTotalRate(rateCatalog);
+        for (nodeId = 1; nodeId < rateCatalog->LeafCount;)
+        {
+            nodeId <<= 1;
+            if (random >= span_Get(*sumTree, nodeId))
+            {
+                random -= span_Get(*sumTree, nodeId);
+                ++nodeId;
+            }
+        }
+    }
+    while (span_Get(*sumTree, nodeId) <= 0.0);
+
+    let slotDiv = div(nodeId - rateCatalog->LeafCount, rateCatalog->SlotsPerEnvironment);
+    selectionInfo->EnvironmentId = slotDiv.quot;
+    selectionInfo->RelativeJumpId = slotDiv.rem;
+}
+
+void UpdateKmcRateCatalogAfterSystemAdvance(SCONTEXT_PARAMETER)
+{
+    var rateCatalog = getKmcRateCatalog(simContext);
+    let jumpLength = getActiveJumpDirection(simContext)->JumpLength;
+
+    // Collect all environments that changed their occupation or energy states through the environment links of the path
+    for (int32_t pathId = 0; pathId < jumpLength; ++pathId)
+    {
+        AddPathOriginsToRefreshPool(simContext, rateCatalog, JUMPPATH[pathId]);
+        cpp_foreach(environmentLink, JUMPPATH[pathId]->EnvironmentLinks)
+        {
+            let environment = getEnvironmentStateAt(simContext, environmentLink->TargetEnvironmentId);
+            AddPathOriginsToRefreshPool(simContext, rateCatalog, environment);
+        }
+    }
+
+    // Note: The rate evaluation overwrites the active cycle state, thus the refresh has to be done after the collection
+    cpp_foreach(environmentId, rateCatalog->RefreshPool)
+    {
+        RefreshEnvironmentSlotRates(simContext, *environmentId);
+        span_Get(rateCatalog->RefreshMarkers, *environmentId) = 0;
+    }
+    list_Clear(rateCatalog->RefreshPool);
+}
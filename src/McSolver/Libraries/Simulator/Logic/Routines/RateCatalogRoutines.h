@@ -0,0 +1,36 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	RateCatalogRoutines.h  		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Rejection-free KMC catalog  //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+// Get the total rate of all slots in the rate catalog in units of the attempt frequency modulus
+static inline double GetKmcRateCatalogTotalRate(const KmcRateCatalog_t*restrict rateCatalog)
+{
+    return span_Get(rateCatalog->RateSumTree, 1);
+}
+
+/* Initializer routines */
+
+// Constructs the path origin offsets that map each path member position back to the possible jump path start vectors and the begin index of each position id
+void ConstructPathOriginOffsets(SCONTEXT_PARAMETER, PathOriginOffsets_t*restrict outOffsets, IdMappingSpan_t*restrict outOffsetBegins);
+
+// Builds the rejection-free KMC rate catalog on the passed context (Has an effect only if the rejection-free mode is active)
+void BuildKmcRateCatalog(SCONTEXT_PARAMETER);
+
+/* Simulation routines */
+
+// Rolls the next KMC jump selection with a probability proportional to the slot rates of the rate catalog
+void RateWeightedSelectNextKmcJumpSelection(SCONTEXT_PARAMETER);
+
+// Refreshes all rate catalog slots affected by the last KMC system advance (Requires the jump path of the advanced transition)
+void UpdateKmcRateCatalogAfterSystemAdvance(SCONTEXT_PARAMETER);
@@ -0,0 +1,240 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ReplicaExchangeRoutines.c	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Replica exchange MMC        //
+//////////////////////////////////////////
+
+#include <pthread.h>
+#include "ReplicaExchangeRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/EnvironmentRoutines.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
+
+// Type for the shared control data of one replica exchange execution block
+typedef struct ReplicaRun ReplicaRun_t;
+
+// Type for a worker of the replica exchange execution. Each worker executes the replica with the same index
+typedef struct ReplicaWorker
+{
+    // The shared control data of the execution block
+    ReplicaRun_t*   Run;
+
+    // The thread handle of the worker
+    pthread_t       Thread;
+
+    // The worker and replica index. Worker zero is executed on the calling thread
+    int32_t         WorkerId;
+
+} ReplicaWorker_t;
+
+// Type for the worker span of a replica exchange execution block
+typedef Span_t(ReplicaWorker_t, ReplicaWorkers) ReplicaWorkers_t;
+
+struct ReplicaRun
+{
+    // The barrier that synchronizes the round start and end of all workers
+    pthread_barrier_t       Barrier;
+
+    // The replica system that is executed
+    MmcReplicaSystem_t*     System;
+
+    // The workers of the execution block
+    ReplicaWorkers_t        Workers;
+
+    // Flag that tells the worker threads to exit
+    bool_t                  IsFinished;
+};
+
+/* Initializer routines */
+
+void BuildMmcReplicaSystem(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsReplicaExchangeMmcActive);
+    var system = getMmcReplicaSystem(simContext);
+    let replicaCount = getMmcReplicaCount(simContext);
+    let targetTemperature = getDbModelJobInfo(simContext)->Temperature;
+    let setMaxTemperature = getMmcReplicaMaxTemperature(simContext);
+    let maxTemperature = (setMaxTemperature > 0.0) ? setMaxTemperature : REPLICA_MAXTEMPERATURE_FACTOR * targetTemperature;
+    assert_true(maxTemperature > targetTemperature, ERR_CMDARGUMENT, "The max replica temperature has to be above the job temperature.");
+
+    system->Replicas = span_New(system->Replicas, replicaCount);
+    system->CyclesPerExchange = getMaxOfTwo(1LL, getNumberOfMobiles(simContext) * REPLICA_EXCHANGE_SWEEPCOUNT);
+    system->ExchangeRoundCount = 0;
+
+    // Note: The geometric temperature ladder yields similar swap acceptance ratios for all neighbor pairs if the heat capacity is approximately constant
+    cpp_foreach(replica, system->Replicas)
+    {
+        let replicaId = (int32_t) (replica - system->Replicas.Begin);
+        replica->Temperature = targetTemperature * pow(maxTemperature / targetTemperature, (double) replicaId / (replicaCount - 1));
+        replica->Alpha = targetTemperature / replica->Temperature;
+        replica->SwapAttemptCount = 0;
+        replica->SwapAcceptCount = 0;
+        replica->Context = (replicaId == 0) ? simContext : ConstructSharedModelWorkerContext(simContext, replicaId);
+    }
+
+    printf("[Init-Info]: MMC replica exchange system BUILD [REPLICA_COUNT=%i, T_TARGET=%.2f, T_MAX=%.2f, CYCLES_PER_EXCHANGE=" FORMAT_I64() "]\n",
+           replicaCount, targetTemperature, maxTemperature, system->CyclesPerExchange);
+}
+
+/* Execution block routines */
+
+// Executes the exchange cycle count on the replica of the passed worker and tracks the lattice energy of the replica
+static void RunReplicaWorkerRound(ReplicaWorker_t*restrict worker)
+{
+    let system = worker->Run->System;
+    let replica = &span_Get(system->Replicas, worker->WorkerId);
+    var context = replica->Context;
+    var latticeEnergy = &getMainStateMetaData(context)->LatticeEnergy;
+    let factors = getPhysicalFactors(context);
+    let energyInfo = getJumpEnergyInfo(context);
+
+    for (int64_t i = 0; i < system->CyclesPerExchange; ++i)
+    {
+        ExecuteMmcSimulationCycleWithAlpha(context, replica->Alpha);
+        continue_if(context->CycleResult != MC_ACCEPTED_CYCLE);
+        *latticeEnergy += factors->EnergyFactorKtToEv * energyInfo->S0toS2EnergyBarrier;
+    }
+}
+
+// Entry point of the worker threads. Executes rounds between two barrier synchronizations until the run is finished
+static void* ReplicaWorkerThreadMain(void* argument)
+{
+    ReplicaWorker_t* worker = argument;
+    for (;;)
+    {
+        pthread_barrier_wait(&worker->Run->Barrier);
+        break_if(worker->Run->IsFinished);
+        RunReplicaWorkerRound(worker);
+        pthread_barrier_wait(&worker->Run->Barrier);
+    }
+    return NULL;
+}
+
+// Executes one round on all replicas, the calling thread acts as worker zero
+static void RunReplicaRound(ReplicaRun_t*restrict run)
+{
+    pthread_barrier_wait(&run->Barrier);
+    RunReplicaWorkerRound(&span_Get(run->Workers, 0));
+    pthread_barrier_wait(&run->Barrier);
+}
+
+// Creates the workers and starts the worker threads of an execution block
+static error_t StartReplicaRun(SCONTEXT_PARAMETER, ReplicaRun_t*restrict run)
+{
+    run->System = getMmcReplicaSystem(simContext);
+    run->IsFinished = false;
+    run->Workers = span_New(run->Workers, span_Length(run->System->Replicas));
+    return_if(pthread_barrier_init(&run->Barrier, NULL, (uint32_t) span_Length(run->Workers)) != 0, ERR_UNKNOWN);
+
+    cpp_foreach(worker, run->Workers)
+    {
+        worker->Run = run;
+        worker->WorkerId = (int32_t) (worker - run->Workers.Begin);
+        continue_if(worker->WorkerId == 0);
+        return_if(pthread_create(&worker->Thread, NULL, ReplicaWorkerThreadMain, worker) != 0, ERR_UNKNOWN);
+    }
+    return ERR_OK;
+}
+
+// Stops and joins the worker threads of an execution block and releases the workers
+static void FinishReplicaRun(ReplicaRun_t*restrict run)
+{
+    run->IsFinished = true;
+    pthread_barrier_wait(&run->Barrier);
+    cpp_offset_foreach(worker, run->Workers, 1)
+        pthread_join(worker->Thread, NULL);
+
+    pthread_barrier_destroy(&run->Barrier);
+    span_Delete(run->Workers);
+}
+
+// Swaps the configurations of two replica contexts. The lattice, the selection pool, the lattice energy and the energy abort buffer are exchanged by value
+static void SwapReplicaConfigurations(SimulationContext_t*restrict lhs, SimulationContext_t*restrict rhs)
+{
+    let lattice = lhs->DynamicModel.EnvironmentLattice;
+    lhs->DynamicModel.EnvironmentLattice = rhs->DynamicModel.EnvironmentLattice;
+    rhs->DynamicModel.EnvironmentLattice = lattice;
+
+    let selectionPool = lhs->SelectionPool;
+    lhs->SelectionPool = rhs->SelectionPool;
+    rhs->SelectionPool = selectionPool;
+
+    var lhsEnergy = &getMainStateMetaData(lhs)->LatticeEnergy;
+    var rhsEnergy = &getMainStateMetaData(rhs)->LatticeEnergy;
+    let energy = *lhsEnergy;
+    *lhsEnergy = *rhsEnergy;
+    *rhsEnergy = energy;
+
+    // Note: The abort buffer holds the energy changes of the configuration history, it has to follow the configuration or the relaxation check mixes two histories
+    var lhsBuffer = getLatticeEnergyBuffer(lhs);
+    var rhsBuffer = getLatticeEnergyBuffer(rhs);
+    let energyBuffer = *lhsBuffer;
+    *lhsBuffer = *rhsBuffer;
+    *rhsBuffer = energyBuffer;
+}
+
+// Attempts the configuration swaps of the neighbor pairs of the current round. Accepts with min(1, exp[(alpha_i - alpha_j) * (E_i - E_j) / kT])
+static void ExchangeReplicaConfigurations(SCONTEXT_PARAMETER, MmcReplicaSystem_t*restrict system)
+{
+    let energyFactor = getPhysicalFactors(simContext)->EnergyFactorEvToKt;
+    for (int32_t id = system->ExchangeRoundCount % 2; id + 1 < span_Length(system->Replicas); id += 2)
+    {
+        var lower = &span_Get(system->Replicas, id);
+        let upper = &span_Get(system->Replicas, id + 1);
+        let lowerEnergy = getMainStateMetaData(lower->Context)->LatticeEnergy;
+        let upperEnergy = getMainStateMetaData(upper->Context)->LatticeEnergy;
+        let exponent = (lower->Alpha - upper->Alpha) * energyFactor * (lowerEnergy - upperEnergy);
+
+        ++lower->SwapAttemptCount;
+        continue_if(exponent < 0.0 && exp(exponent) < GetNextRandomDoubleFromContextRng(simContext));
+        SwapReplicaConfigurations(lower->Context, upper->Context);
+        ++lower->SwapAcceptCount;
+    }
+    ++system->ExchangeRoundCount;
+}
+
+error_t RunOneReplicaExchangeMmcExecutionBlock(SCONTEXT_PARAMETER)
+{
+    var system = getMmcReplicaSystem(simContext);
+    var counters = getMainCycleCounters(simContext);
+    ReplicaRun_t run;
+
+    // Note: The replica energies are tracked incrementally, a resynchronization per block removes the accumulated rounding drift
+    cpp_offset_foreach(replica, system->Replicas, 1)
+        ResynchronizeEnvironmentEnergyStatus(replica->Context);
+
+    SIMERROR = StartReplicaRun(simContext, &run);
+    assert_success(SIMERROR, "Failed to start the worker threads of the replica exchange MMC routine.");
+
+    for (;counters->McsCount < counters->NextExecutionPhaseGoalMcsCount;)
+    {
+        RunReplicaRound(&run);
+        counters->CycleCount += system->CyclesPerExchange;
+        ExchangeReplicaConfigurations(simContext, system);
+        break_if(UpdateAndEvaluateMmcAbortConditions(simContext) != STATE_FLG_CONTINUE);
+    }
+
+    FinishReplicaRun(&run);
+    return SIMERROR;
+}
+
+void PrintMmcReplicaExchangeInfo(SCONTEXT_PARAMETER, file_t* fstream)
+{
+    let system = getMmcReplicaSystem(simContext);
+    fprintf(fstream, "<REPLICA_EXCHANGE_DUMP>\n");
+    cpp_foreach(replica, system->Replicas)
+    {
+        let acceptRatio = (replica->SwapAttemptCount > 0) ? (double) replica->SwapAcceptCount / (double) replica->SwapAttemptCount : 0.0;
+        fprintf(fstream, "Replica %3i => T=%10.2f [K], Alpha=%.4f, E(Lattice)=%+.6e [eV], Swap acceptance (next)=%6.2f %%\n",
+                (int32_t) (replica - system->Replicas.Begin), replica->Temperature, replica->Alpha,
+                getMainStateMetaData(replica->Context)->LatticeEnergy, 100.0 * acceptRatio);
+    }
+    fprintf(fstream, "\n");
+    fflush(fstream);
+}
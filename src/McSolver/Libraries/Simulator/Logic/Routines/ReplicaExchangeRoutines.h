@@ -0,0 +1,27 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	ReplicaExchangeRoutines.h	//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Replica exchange MMC        //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+/* Initializer routines */
+
+// Builds the temperature replicas of the replica exchange MMC mode (Has an effect only if the mode is active)
+void BuildMmcReplicaSystem(SCONTEXT_PARAMETER);
+
+/* Simulation routines */
+
+// Run the mmc simulation for one execution block using the replica exchange execution with one thread per replica
+error_t RunOneReplicaExchangeMmcExecutionBlock(SCONTEXT_PARAMETER);
+
+// Prints the temperature ladder and the swap acceptance ratios of the replica exchange MMC mode to the passed stream
+void PrintMmcReplicaExchangeInfo(SCONTEXT_PARAMETER, file_t* fstream);
@@ -32,7 +32,11 @@ error_t SetCycleCounterStateToDefault(SCONTEXT_PARAMETER, CycleCounterState_t *c
     let kmcHeader = JobInfoFlagsAreSet(simContext, INFO_FLG_KMC) ? getDbModelJobHeaderAsKMC(simContext) : NULL;
     return_if(mobileCount == 0, ERR_NOMOBILES);
 
-    counters->PrerunGoalMcs = (kmcHeader != NULL) ? kmcHeader->PreRunMcsp * mobileCount : 0;
+    // Note: A warm start with imported normalization or the direct normalization skips the KMC pre-run, the goal is reduced accordingly to keep it identical on a resume
+    let isKmcPreRunSkipped = simContext->IsWarmStartNormalizationActive || simContext->IsDirectKmcNormalizationActive;
+    let kmcPreRunMcsp = (kmcHeader != NULL && !isKmcPreRunSkipped) ? kmcHeader->PreRunMcsp : 0;
+    let preRunMcsp = (kmcHeader != NULL) ? kmcPreRunMcsp : getMmcPreRunMcsp(simContext);
+    counters->PrerunGoalMcs = (int64_t) preRunMcsp * mobileCount;
     counters->TotalSimulationGoalMcsCount = counters->PrerunGoalMcs + jobInfo->TargetMcsp * mobileCount;
     return_if(counters->TotalSimulationGoalMcsCount == 0, ERR_DATACONSISTENCY);
 
@@ -94,6 +98,62 @@ Vector3_t CalculateMobileTrackerEnsembleShift(SCONTEXT_PARAMETER, byte_t particl
     return result;
 }
 
+double CalculatePrecisionAbortObservableSum(SCONTEXT_PARAMETER)
+{
+    return_if(JobInfoFlagsAreSet(simContext, INFO_FLG_MMC), getMainStateMetaData(simContext)->LatticeEnergy);
+
+    let meta = getDbStructureModelMetaData(simContext);
+    let isFieldProjected = fabs(getDbModelJobHeaderAsKMC(simContext)->ElectricFieldModulus) > 0.0;
+    double result = 0.0;
+
+    cpp_foreach(envState, *getEnvironmentLattice(simContext))
+    {
+        continue_if(envState->MobileTrackerId <= INVALID_INDEX);
+
+        var tracker = *getMobileTrackerAt(simContext, envState->MobileTrackerId);
+        tracker = TransformFractionalToCartesian(&tracker, &meta->CellVectors);
+        result += isFieldProjected
+                ? meta->ParticleCharges[envState->ParticleId] * CalcVector3DotProduct(&tracker, &meta->NormElectricFieldVector)
+                : CalcVector3DotProduct(&tracker, &tracker);
+    }
+    return result;
+}
+
+double CalculateBlockAveragingMean(const PrecisionBlockValues_t*restrict blockValues)
+{
+    let count = span_Length(*blockValues);
+    return_if(count == 0, NAN);
+
+    double mean = 0.0;
+    cpp_foreach(value, *blockValues) mean += *value;
+    return mean / (double) count;
+}
+
+double CalculateBlockAveragingStandardError(const PrecisionBlockValues_t*restrict blockValues)
+{
+    double values[CYCLE_BLOCKCOUNT];
+    int64_t count = getMinOfTwo(span_Length(*blockValues), CYCLE_BLOCKCOUNT);
+    return_if(count < PRECISION_BINNINGCOUNT_MIN, INFINITY);
+    memcpy(values, blockValues->Begin, (size_t) count * sizeof(double));
+
+    double mean = 0.0, maxError = 0.0;
+    for (int64_t i = 0; i < count; i++) mean += values[i];
+    mean /= (double) count;
+
+    // Note: Correlated blocks underestimate the error, the blocks are merged pairwise and the maximum error of all binning levels is used
+    while (count >= PRECISION_BINNINGCOUNT_MIN)
+    {
+        double variance = 0.0;
+        for (int64_t i = 0; i < count; i++) variance += (values[i] - mean) * (values[i] - mean);
+        variance /= (double) (count * (count - 1));
+        maxError = getMaxOfTwo(maxError, sqrt(variance));
+
+        count /= 2;
+        for (int64_t i = 0; i < count; i++) values[i] = 0.5 * (values[2 * i] + values[2 * i + 1]);
+    }
+    return maxError;
+}
+
 Vector3_t CalculateStaticTrackerEnsembleShift(SCONTEXT_PARAMETER, byte_t particleId)
 {
     Vector3_t result = {.A = 0, .B = 0, .C = 0};
@@ -102,7 +102,9 @@ static inline double GetCurrentTimeStepPerJumpAttempt(SCONTEXT_PARAMETER)
     let pool = getJumpSelectionPool(simContext);
     let dofFactor = (getDbModelJobInfo(simContext)->JobFlags & INFO_FLG_DUALDOF) ? 2.0 : 1.0;
 
-    return dofFactor * factors->TotalJumpNormalization / (header->AttemptFrequencyModulus * (double) pool->SelectableJumpCount);
+    let jumpCount = simContext->IsGroupKmcNormalizationActive ? pool->WeightedJumpCount : (double) pool->SelectableJumpCount;
+
+    return dofFactor * factors->TotalJumpNormalization / (header->AttemptFrequencyModulus * jumpCount);
 }
 
 // Calculates the basic normalization factor from the max jump probability
@@ -141,16 +143,25 @@ static inline double GetCurrentElectricFieldJumpInfluence(SCONTEXT_PARAMETER)
     return -(direction->ElectricFieldFactor * rule->ElectricFieldFactor);
 }
 
+// Get the selection weight of the direction pool of the currently selected start environment (One if the grouped normalization is inactive)
+static inline double GetActiveKmcSelectionWeight(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsGroupKmcNormalizationActive, 1.0);
+    let environment = getEnvironmentStateAt(simContext, getJumpSelectionInfo(simContext)->EnvironmentId);
+    return getDirectionPoolAt(simContext, environment->PoolId)->SelectionWeight;
+}
+
 // Calculates the probability pre factor using the current cycle state
 static inline double GetCurrentProbabilityPreFactor(SCONTEXT_PARAMETER)
 {
     let factors = getPhysicalFactors(simContext);
+    let normalization = factors->TotalJumpNormalization / GetActiveKmcSelectionWeight(simContext);
 
     #if defined (OPT_PRECHECK_FREQUENCY)
-    return factors->TotalJumpNormalization;
+    return normalization;
     #else
     let jumpRule = getActiveJumpRule(simContext);
-    return factors->TotalJumpNormalization * jumpRule->FrequencyFactor;
+    return normalization * jumpRule->FrequencyFactor;
     #endif
 }
 
@@ -189,6 +200,16 @@ error_t SetPhysicalSimulationFactorsToDefault(SCONTEXT_PARAMETER, PhysicalInfo_t
 // Get the linear or square displacement (cartesian) vector of the mobile tracker ensemble of the passed particle in [Ang]/[Ang^2]
 Vector3_t CalculateMobileTrackerEnsembleShift(SCONTEXT_PARAMETER, byte_t particleId, bool_t isSquared, double* r3value);
 
+// Get the observable sum of the statistical precision abort. This is the charge weighted field projected displacement of all mobile trackers in [Ang] (KMC with field),
+// the sum of the squared displacements of all mobile trackers in [Ang^2] (KMC without field) or the lattice energy in [eV] (MMC)
+double CalculatePrecisionAbortObservableSum(SCONTEXT_PARAMETER);
+
+// Get the mean of the passed block values (Returns NaN if no values exist)
+double CalculateBlockAveragingMean(const PrecisionBlockValues_t*restrict blockValues);
+
+// Get the absolute standard error of the mean of the passed block values by a binning analysis (Returns infinity if the values do not allow an estimate)
+double CalculateBlockAveragingStandardError(const PrecisionBlockValues_t*restrict blockValues);
+
 // Get the linear displacement vector of the static tracker ensemble of the passed particle
 Vector3_t CalculateStaticTrackerEnsembleShift(SCONTEXT_PARAMETER, byte_t particleId);
 
@@ -0,0 +1,513 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	SublatticeKmcRoutines.c		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Sublattice parallel KMC/MMC //
+//////////////////////////////////////////
+
+#include <pthread.h>
+#include "SublatticeKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Helper/Constants.h"
+#include "Libraries/Simulator/Logic/Routines/HelperRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+
+// Type for the shared control data of one sublattice parallel execution block
+typedef struct SublatticeRun SublatticeRun_t;
+
+// Type for a worker of the sublattice parallel execution. Owns a shallow context copy with thread local cycle state and meta data
+typedef struct SublatticeWorker
+{
+    // The worker context. Shares all model and lattice data with the main context
+    SimulationContext_t     Context;
+
+    // The private meta data of the worker context that absorbs the time writes of the shared event handlers
+    StateMetaData_t         MetaData;
+
+    // The shared control data of the execution block
+    SublatticeRun_t*        Run;
+
+    // The thread handle of the worker
+    pthread_t               Thread;
+
+    // The worker index. Worker zero is executed on the calling thread
+    int32_t                 WorkerId;
+
+} SublatticeWorker_t;
+
+// Type for the worker span of a sublattice parallel execution block
+typedef Span_t(SublatticeWorker_t, SublatticeWorkers) SublatticeWorkers_t;
+
+struct SublatticeRun
+{
+    // The barrier that synchronizes the phase start and end of all workers
+    pthread_barrier_t       Barrier;
+
+    // The sector system that is executed
+    KmcSublatticeSystem_t*  System;
+
+    // The workers of the execution block
+    SublatticeWorkers_t     Workers;
+
+    // The sublattice color (0 = even sectors, 1 = odd sectors) of the current phase
+    int32_t                 ActiveColor;
+
+    // Flag that tells the worker threads to exit
+    bool_t                  IsFinished;
+};
+
+/* Local helper routines */
+
+// Finds the max unit cell distance along the passed axis that is spanned by any jump sequence
+static int32_t FindMaxJumpReachOnAxis(SCONTEXT_PARAMETER, const int32_t axis)
+{
+    int32_t result = 0;
+    cpp_foreach(jumpDirection, *getJumpDirections(simContext))
+    {
+        cpp_foreach(jumpVector, jumpDirection->JumpSequence)
+            result = getMaxOfTwo(result, abs(GetVector4AxisValue(jumpVector, axis)));
+    }
+    return result;
+}
+
+// Finds the max unit cell distance along the passed axis that is spanned by any environment link (Uses the minimum image convention)
+static int32_t FindMaxLinkReachOnAxis(SCONTEXT_PARAMETER, const int32_t axis)
+{
+    let axisSize = GetVector4AxisValue(getLatticeSizeVector(simContext), axis);
+    int32_t result = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        let origin = GetVector4AxisValue(&environment->LatticeVector, axis);
+        cpp_foreach(environmentLink, environment->EnvironmentLinks)
+        {
+            let target = getEnvironmentStateAt(simContext, environmentLink->TargetEnvironmentId);
+            let distance = abs(GetVector4AxisValue(&target->LatticeVector, axis) - origin);
+            result = getMaxOfTwo(result, getMinOfTwo(distance, axisSize - distance));
+        }
+    }
+    return result;
+}
+
+// Finds the largest even sector count along the passed axis that yields equally sized sectors of at least the passed width. Returns zero if none exists
+static int32_t FindMaxSectorCountOnAxis(SCONTEXT_PARAMETER, const int32_t axis, const int32_t minWidth)
+{
+    let axisSize = GetVector4AxisValue(getLatticeSizeVector(simContext), axis);
+    for (int32_t sectorCount = axisSize / minWidth; sectorCount >= SUBLATTICE_SECTORCOUNT_MIN; --sectorCount)
+    {
+        if ((sectorCount % 2 == 0) && (axisSize % sectorCount == 0)) return sectorCount;
+    }
+    return 0;
+}
+
+// Selects the sector axis and width with the highest sector count. Returns the sector count or zero if the lattice cannot be cut
+static int32_t SetSectorGeometryOnSublatticeSystem(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    int32_t maxSectorCount = 0;
+    for (int32_t axis = 0; axis < 3; ++axis)
+    {
+        // Note: Events write up to (jump + link) reach from their start, two events in sectors of equal color are separated by one full sector
+        let reach = FindMaxJumpReachOnAxis(simContext, axis) + FindMaxLinkReachOnAxis(simContext, axis);
+        let minWidth = getMaxOfTwo(1, 2 * reach);
+        let sectorCount = FindMaxSectorCountOnAxis(simContext, axis, minWidth);
+        continue_if(sectorCount <= maxSectorCount);
+
+        maxSectorCount = sectorCount;
+        system->SectorAxis = axis;
+        system->SectorWidth = GetVector4AxisValue(getLatticeSizeVector(simContext), axis) / sectorCount;
+    }
+    return maxSectorCount;
+}
+
+// Checks if the passed environment can provide jump slots at any point of the simulation
+static inline bool_t EnvironmentCanProvideJumpSlots(const EnvironmentState_t*restrict environment)
+{
+    return environment->EnvironmentDefinition->SelectionParticleMask != 0;
+}
+
+// Writes the slot providing environment ids onto the sectors using the current sector shift. The sector id spans have to be allocated with the correct size
+static void FillSublatticeSectorEnvironmentIds(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    int32_t environmentCounts[span_Length(system->Sectors)];
+    memset(environmentCounts, 0, sizeof(environmentCounts));
+
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        continue_if(!EnvironmentCanProvideJumpSlots(environment));
+        let sectorId = GetEnvironmentSectorId(system, environment);
+        var sector = &span_Get(system->Sectors, sectorId);
+        span_Get(sector->EnvironmentIds, environmentCounts[sectorId]++) = getEnvironmentStateIdByPointer(simContext, environment);
+    }
+}
+
+// Allocates the sectors and distributes the slot providing environment ids onto them
+static void ConstructSublatticeSectors(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system, const int32_t sectorCount)
+{
+    int32_t environmentCounts[sectorCount];
+    memset(environmentCounts, 0, sizeof(environmentCounts));
+
+    system->Sectors = span_New(system->Sectors, sectorCount);
+    system->SectorShift = 0;
+    cpp_foreach(environment, *getEnvironmentLattice(simContext))
+    {
+        continue_if(!EnvironmentCanProvideJumpSlots(environment));
+        ++environmentCounts[GetEnvironmentSectorId(system, environment)];
+    }
+
+    for (int32_t i = 0; i < sectorCount; ++i)
+    {
+        var sector = &span_Get(system->Sectors, i);
+        sector->EnvironmentIds = span_New(sector->EnvironmentIds, environmentCounts[i]);
+        sector->Counters = span_New(sector->Counters, span_Length(*getMainStateCounters(simContext)));
+        sector->GlobalTrackers = span_New(sector->GlobalTrackers, span_Length(*getGlobalMovementTrackers(simContext)));
+        sector->JumpStatistics = span_New(sector->JumpStatistics, span_Length(*getJumpStatistics(simContext)));
+    }
+
+    FillSublatticeSectorEnvironmentIds(simContext, system);
+}
+
+void BuildKmcSublatticeSystem(SCONTEXT_PARAMETER)
+{
+    return_if(!simContext->IsSublatticeParallelKmcActive && !simContext->IsSublatticeParallelMmcActive);
+    var system = getKmcSublatticeSystem(simContext);
+    let isMmc = simContext->IsSublatticeParallelMmcActive;
+    let modeName = isMmc ? "MMC" : "KMC";
+
+    let sectorCount = SetSectorGeometryOnSublatticeSystem(simContext, system);
+    if (sectorCount == 0)
+    {
+        assert_true(GetDistributedRankCount() <= 1, ERR_VALIDATION, "Cannot run the distributed KMC mode, the lattice cannot be cut into sublattice sectors.");
+        printf("[Init-Info]: %s sublattice system FAILURE => The lattice cannot be cut into %i or more sectors, using the serial routine.\n", modeName, SUBLATTICE_SECTORCOUNT_MIN);
+        simContext->IsSublatticeParallelKmcActive = false;
+        simContext->IsSublatticeParallelMmcActive = false;
+        return;
+    }
+
+    system->SlotsPerEnvironment = FindMaxJumpDirectionCount(getJumpCountMapping(simContext));
+    ConstructSublatticeSectors(simContext, system, sectorCount);
+
+    let sectorSlotCount = span_Length(span_Get(system->Sectors, 0).EnvironmentIds) * system->SlotsPerEnvironment;
+    system->CyclesPerPhase = getMaxOfTwo(1LL, sectorSlotCount / SUBLATTICE_PHASE_SLOTDIVISOR);
+
+    let error = SetDistributedSectorRangeOnSublatticeSystem(simContext, system);
+    assert_success(error, "Cannot run the distributed KMC mode, the number of MPI ranks exceeds the number of sublattice sectors.");
+    let threadCount = isMmc ? getMmcThreadCount(simContext) : getKmcThreadCount(simContext);
+    system->ThreadCount = getMaxOfTwo(1, getMinOfTwo(threadCount, (system->SectorEnd - system->SectorBegin) / 2));
+
+    printf("[Init-Info]: %s sublattice system BUILD [SECTOR_COUNT=%i, SECTOR_AXIS=%i, SECTOR_WIDTH=%i, THREAD_COUNT=%i, CYCLES_PER_PHASE=" FORMAT_I64() "]\n",
+           modeName, sectorCount, system->SectorAxis, system->SectorWidth, system->ThreadCount, system->CyclesPerPhase);
+}
+
+/* Execution block routines */
+
+// Calculates the simulated time span of a full sweep. Each sector slot attempt corresponds to the time step per slot of the full lattice
+static double CalculateSublatticeTimePerSweep(SCONTEXT_PARAMETER, const KmcSublatticeSystem_t*restrict system)
+{
+    let factors = getPhysicalFactors(simContext);
+    let header = getDbModelJobHeaderAsKMC(simContext);
+    let dofFactor = JobInfoFlagsAreSet(simContext, INFO_FLG_DUALDOF) ? 2.0 : 1.0;
+    let sectorSlotCount = (double) (span_Length(span_Get(system->Sectors, 0).EnvironmentIds) * system->SlotsPerEnvironment);
+
+    return (double) system->CyclesPerPhase * dofFactor * factors->TotalJumpNormalization / (header->AttemptFrequencyModulus * sectorSlotCount);
+}
+
+// Seeds the sector random number generator streams from the main generator and resets the sector jump statistics to the main histogram limits
+static void PrepareSublatticeSectorsForBlock(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    var mainRng = getMainRng(simContext);
+    cpp_foreach(sector, system->Sectors)
+    {
+        let state = ((uint64_t) Pcg32NextRandom(mainRng) << 32U) | Pcg32NextRandom(mainRng);
+        Pcg32SeedGenerator(&sector->Rng, state, (uint64_t) (sector - system->Sectors.Begin));
+
+        for (int32_t i = 0; i < span_Length(sector->JumpStatistics); ++i)
+        {
+            var statistic = &span_Get(sector->JumpStatistics, i);
+            *statistic = span_Get(*getJumpStatistics(simContext), i);
+            JumpHistogram_t* histograms[] = {&statistic->EdgeEnergyHistogram, &statistic->PosConfEnergyHistogram, &statistic->NegConfEnergyHistogram, &statistic->TotalEnergyHistogram};
+            for (int32_t j = 0; j < 4; ++j)
+            {
+                histograms[j]->OverflowCount = 0;
+                histograms[j]->UnderflowCount = 0;
+                memset(histograms[j]->CountBuffer, 0, sizeof(histograms[j]->CountBuffer));
+            }
+        }
+    }
+}
+
+// Adds the counts of the passed source jump histogram to the target jump histogram
+static inline void AddJumpHistogramCounts(JumpHistogram_t*restrict target, const JumpHistogram_t*restrict source)
+{
+    target->OverflowCount += source->OverflowCount;
+    target->UnderflowCount += source->UnderflowCount;
+    for (int32_t i = 0; i < STATE_JUMPSTAT_SIZE; ++i) target->CountBuffer[i] += source->CountBuffer[i];
+}
+
+// Merges the sector cycle counters of all ranks into the main cycle counters and advances the simulated time by one sweep
+static void MergeSublatticeSweepIntoMainState(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    var counters = getMainCycleCounters(simContext);
+    int64_t sweepCounts[2] = {0, 0};
+    cpp_foreach(sector, system->Sectors)
+    {
+        sweepCounts[0] += sector->McsCount;
+        sweepCounts[1] += sector->CycleCount;
+        sector->McsCount = 0;
+        sector->CycleCount = 0;
+    }
+    SumReduceDistributedInt64Values(system, sweepCounts, 2);
+    counters->McsCount += sweepCounts[0];
+    counters->CycleCount += sweepCounts[1];
+    getMainStateMetaData(simContext)->SimulatedTime += system->TimePerSweep;
+}
+
+// Merges the sector cycle counters and energy changes of one MMC phase into the main cycle counters, the lattice energy and the energy abort buffer
+static void MergeSublatticeMmcPhaseIntoMainState(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    var counters = getMainCycleCounters(simContext);
+    int64_t mcsCount = 0, cycleCount = 0;
+    double energyChange = 0.0;
+    cpp_foreach(sector, system->Sectors)
+    {
+        mcsCount += sector->McsCount;
+        cycleCount += sector->CycleCount;
+        energyChange += sector->EnergyChange;
+        sector->McsCount = 0;
+        sector->CycleCount = 0;
+        sector->EnergyChange = 0.0;
+    }
+    counters->McsCount += mcsCount;
+    counters->CycleCount += cycleCount;
+    getMainStateMetaData(simContext)->LatticeEnergy += getPhysicalFactors(simContext)->EnergyFactorKtToEv * energyChange;
+    WriteMmcEnergyChangeSumToAbortBuffer(simContext, energyChange, mcsCount);
+}
+
+// Merges the sector local counters, trackers and jump statistics of the owned sectors into the main state in sector order and clears the sector counters and trackers
+static void MergeSublatticeSectorsIntoMainState(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    let ownedSectors = span_Split(system->Sectors, system->SectorBegin, system->SectorEnd);
+    cpp_foreach(sector, ownedSectors)
+    {
+        for (int32_t i = 0; i < span_Length(sector->Counters); ++i)
+        {
+            var target = &span_Get(*getMainStateCounters(simContext), i);
+            let source = &span_Get(sector->Counters, i);
+            target->SkipCount += source->SkipCount;
+            target->McsCount += source->McsCount;
+            target->RejectionCount += source->RejectionCount;
+            target->SiteBlockingCount += source->SiteBlockingCount;
+            target->UnstableStartCount += source->UnstableStartCount;
+            target->UnstableEndCount += source->UnstableEndCount;
+        }
+        for (int32_t i = 0; i < span_Length(sector->GlobalTrackers); ++i)
+        {
+            vector3VectorOp(span_Get(*getGlobalMovementTrackers(simContext), i), span_Get(sector->GlobalTrackers, i), +=);
+        }
+        for (int32_t i = 0; i < span_Length(sector->JumpStatistics); ++i)
+        {
+            var target = &span_Get(*getJumpStatistics(simContext), i);
+            let source = &span_Get(sector->JumpStatistics, i);
+            AddJumpHistogramCounts(&target->EdgeEnergyHistogram, &source->EdgeEnergyHistogram);
+            AddJumpHistogramCounts(&target->PosConfEnergyHistogram, &source->PosConfEnergyHistogram);
+            AddJumpHistogramCounts(&target->NegConfEnergyHistogram, &source->NegConfEnergyHistogram);
+            AddJumpHistogramCounts(&target->TotalEnergyHistogram, &source->TotalEnergyHistogram);
+        }
+        memset(sector->Counters.Begin, 0, span_ByteCount(sector->Counters));
+        memset(sector->GlobalTrackers.Begin, 0, span_ByteCount(sector->GlobalTrackers));
+    }
+}
+
+// Binds the passed sector to the worker context by redirecting the rng and the accumulating main state spans to the sector
+static inline void BindSectorToWorkerContext(SimulationContext_t*restrict context, const KmcSector_t*restrict sector)
+{
+    context->Rng = sector->Rng;
+    context->MainState.Counters = sector->Counters;
+    context->MainState.GlobalTrackers = sector->GlobalTrackers;
+    context->MainState.JumpStatistics = sector->JumpStatistics;
+    context->CycleState.MainCounters.McsCount = 0;
+}
+
+// Executes the KMC cycles of one phase on the passed sector. Returns the number of non-null cycles
+static int64_t RunSublatticeKmcSectorCycles(SimulationContext_t*restrict context, const KmcSublatticeSystem_t*restrict system, KmcSector_t*restrict sector)
+{
+    int64_t cycleCount = 0;
+    for (int64_t i = 0; i < system->CyclesPerPhase; ++i)
+    {
+        ExecuteSectorKmcSimulationCycle(context, &sector->EnvironmentIds, system->SlotsPerEnvironment);
+        cycleCount += (context->CycleResult != MC_NULLSLOT_CYCLE);
+        LogDistributedSectorPathChanges(context, sector);
+    }
+    return cycleCount;
+}
+
+// Executes the MMC cycles of one phase on the passed sector and sums the energy changes of accepted cycles. Returns the number of non-null cycles
+static int64_t RunSublatticeMmcSectorCycles(SimulationContext_t*restrict context, const KmcSublatticeSystem_t*restrict system, KmcSector_t*restrict sector)
+{
+    let energyInfo = getJumpEnergyInfo(context);
+    int64_t cycleCount = 0;
+    for (int64_t i = 0; i < system->CyclesPerPhase; ++i)
+    {
+        ExecuteSectorMmcSimulationCycle(context, &sector->EnvironmentIds, system->SlotsPerEnvironment);
+        cycleCount += (context->CycleResult != MC_NULLSLOT_CYCLE);
+        continue_if(context->CycleResult != MC_ACCEPTED_CYCLE);
+        sector->EnergyChange += energyInfo->S0toS2EnergyBarrier;
+    }
+    return cycleCount;
+}
+
+// Executes all sectors of the active color that are owned by the rank and assigned to the passed worker
+static void RunSublatticeWorkerPhase(SublatticeWorker_t*restrict worker)
+{
+    let run = worker->Run;
+    let system = run->System;
+    let threadCount = (int32_t) span_Length(run->Workers);
+    let firstSectorId = system->SectorBegin + ((system->SectorBegin + run->ActiveColor) % 2);
+    var context = &worker->Context;
+
+    // Note: Sector assignment is static and each sector owns its rng stream, the results do not depend on the thread or rank count
+    for (int32_t sectorId = firstSectorId + 2 * worker->WorkerId; sectorId < system->SectorEnd; sectorId += 2 * threadCount)
+    {
+        var sector = &span_Get(system->Sectors, sectorId);
+
+        BindSectorToWorkerContext(context, sector);
+        let cycleCount = context->IsSublatticeParallelMmcActive
+                ? RunSublatticeMmcSectorCycles(context, system, sector)
+                : RunSublatticeKmcSectorCycles(context, system, sector);
+
+        sector->Rng = context->Rng;
+        sector->McsCount += context->CycleState.MainCounters.McsCount;
+        sector->CycleCount += cycleCount;
+    }
+}
+
+// Entry point of the worker threads. Executes phases between two barrier synchronizations until the run is finished
+static void* SublatticeWorkerThreadMain(void* argument)
+{
+    SublatticeWorker_t* worker = argument;
+    for (;;)
+    {
+        pthread_barrier_wait(&worker->Run->Barrier);
+        break_if(worker->Run->IsFinished);
+        RunSublatticeWorkerPhase(worker);
+        pthread_barrier_wait(&worker->Run->Barrier);
+    }
+    return NULL;
+}
+
+// Executes one phase of the passed color on all workers and exchanges the boundary changes with the neighboring ranks, the calling thread acts as worker zero
+static void RunSublatticePhase(SCONTEXT_PARAMETER, SublatticeRun_t*restrict run, const int32_t color)
+{
+    run->ActiveColor = color;
+    pthread_barrier_wait(&run->Barrier);
+    RunSublatticeWorkerPhase(&span_Get(run->Workers, 0));
+    pthread_barrier_wait(&run->Barrier);
+    ExchangeDistributedSublatticePhaseChanges(simContext);
+}
+
+// Executes one phase of the passed color on all workers and merges the phase results into the main state, the calling thread acts as worker zero
+static void RunSublatticeMmcPhase(SCONTEXT_PARAMETER, SublatticeRun_t*restrict run, const int32_t color)
+{
+    run->ActiveColor = color;
+    pthread_barrier_wait(&run->Barrier);
+    RunSublatticeWorkerPhase(&span_Get(run->Workers, 0));
+    pthread_barrier_wait(&run->Barrier);
+    MergeSublatticeMmcPhaseIntoMainState(simContext, run->System);
+}
+
+// Shifts the sector borders by a random number of unit cells and redistributes the sector environment ids
+static void ShiftSublatticeSectors(SCONTEXT_PARAMETER, KmcSublatticeSystem_t*restrict system)
+{
+    // Note: Each sector covers the same number of unit cell slabs for any shift, thus the sector id spans keep their size
+    let axisSize = system->SectorWidth * (int32_t) span_Length(system->Sectors);
+    system->SectorShift = GetNextCeiledRandomFromContextRng(simContext, axisSize);
+    FillSublatticeSectorEnvironmentIds(simContext, system);
+}
+
+// Creates the workers and starts the worker threads of an execution block
+static error_t StartSublatticeRun(SCONTEXT_PARAMETER, SublatticeRun_t*restrict run)
+{
+    run->System = getKmcSublatticeSystem(simContext);
+    run->IsFinished = false;
+    run->Workers = span_New(run->Workers, run->System->ThreadCount);
+    return_if(pthread_barrier_init(&run->Barrier, NULL, (uint32_t) run->System->ThreadCount) != 0, ERR_UNKNOWN);
+
+    cpp_foreach(worker, run->Workers)
+    {
+        worker->Context = *simContext;
+        worker->MetaData = *getMainStateMetaData(simContext);
+        worker->Context.MainState.Meta.Data = &worker->MetaData;
+        worker->Run = run;
+        worker->WorkerId = (int32_t) (worker - run->Workers.Begin);
+        continue_if(worker->WorkerId == 0);
+        return_if(pthread_create(&worker->Thread, NULL, SublatticeWorkerThreadMain, worker) != 0, ERR_UNKNOWN);
+    }
+    return ERR_OK;
+}
+
+// Stops and joins the worker threads of an execution block and releases the workers
+static void FinishSublatticeRun(SublatticeRun_t*restrict run)
+{
+    run->IsFinished = true;
+    pthread_barrier_wait(&run->Barrier);
+    cpp_offset_foreach(worker, run->Workers, 1)
+        pthread_join(worker->Thread, NULL);
+
+    pthread_barrier_destroy(&run->Barrier);
+    span_Delete(run->Workers);
+}
+
+error_t RunOneSublatticeKmcExecutionBlock(SCONTEXT_PARAMETER)
+{
+    var system = getKmcSublatticeSystem(simContext);
+    var counters = getMainCycleCounters(simContext);
+    SublatticeRun_t run;
+
+    system->TimePerSweep = CalculateSublatticeTimePerSweep(simContext, system);
+    PrepareSublatticeSectorsForBlock(simContext, system);
+    SetDistributedReferenceState(simContext);
+    SIMERROR = StartSublatticeRun(simContext, &run);
+    assert_success(SIMERROR, "Failed to start the worker threads of the sublattice parallel KMC routine.");
+
+    for (;counters->McsCount < counters->NextExecutionPhaseGoalMcsCount;)
+    {
+        // Note: The order of the two sublattices is randomized for each sweep to avoid a systematic bias at the sector borders
+        let firstColor = GetNextCeiledRandomFromContextRng(simContext, 2);
+        RunSublatticePhase(simContext, &run, firstColor);
+        RunSublatticePhase(simContext, &run, 1 - firstColor);
+
+        MergeSublatticeSweepIntoMainState(simContext, system);
+        break_if(UpdateAndEvaluateKmcAbortConditions(simContext) != STATE_FLG_CONTINUE);
+    }
+
+    FinishSublatticeRun(&run);
+    MergeSublatticeSectorsIntoMainState(simContext, system);
+    MergeDistributedSublatticeStates(simContext);
+    return SIMERROR;
+}
+
+error_t RunOneSublatticeMmcExecutionBlock(SCONTEXT_PARAMETER)
+{
+    var system = getKmcSublatticeSystem(simContext);
+    var counters = getMainCycleCounters(simContext);
+    SublatticeRun_t run;
+
+    PrepareSublatticeSectorsForBlock(simContext, system);
+    SIMERROR = StartSublatticeRun(simContext, &run);
+    assert_success(SIMERROR, "Failed to start the worker threads of the sublattice parallel MMC routine.");
+
+    for (;counters->McsCount < counters->NextExecutionPhaseGoalMcsCount;)
+    {
+        // Note: Exchange partners are restricted to the sector of the start, the random border shift makes the sweep sequence ergodic
+        ShiftSublatticeSectors(simContext, system);
+        let firstColor = GetNextCeiledRandomFromContextRng(simContext, 2);
+        RunSublatticeMmcPhase(simContext, &run, firstColor);
+        RunSublatticeMmcPhase(simContext, &run, 1 - firstColor);
+        break_if(UpdateAndEvaluateMmcAbortConditions(simContext) != STATE_FLG_CONTINUE);
+    }
+
+    FinishSublatticeRun(&run);
+    MergeSublatticeSectorsIntoMainState(simContext, system);
+    return SIMERROR;
+}
@@ -0,0 +1,46 @@
+//////////////////////////////////////////
+// Project: C Monte Carlo Simulator		//
+// File:	SublatticeKmcRoutines.h		//
+// Author:	Sebastian Eisele			//
+//			Workgroup Martin, IPC       //
+//			RWTH Aachen University      //
+//			© 2018 Sebastian Eisele     //
+// Short:   Sublattice parallel KMC/MMC //
+//////////////////////////////////////////
+
+#pragma once
+#include "Libraries/Framework/Errors/McErrors.h"
+#include "Libraries/Framework/Basic/BaseTypes.h"
+#include "Libraries/Simulator/Data/SimContext/SimulationContextAccess.h"
+
+// Get the value of the passed vector for the passed axis index (0 = A, 1 = B, 2 = C)
+static inline int32_t GetVector4AxisValue(const Vector4_t*restrict vector, const int32_t axis)
+{
+    return (axis == 0) ? vector->A : (axis == 1) ? vector->B : vector->C;
+}
+
+// Get the sector id of the unit cell of the passed vector on the passed sublattice system (Includes the cyclic sector shift)
+static inline int32_t GetVector4SectorId(const KmcSublatticeSystem_t*restrict system, const Vector4_t*restrict vector)
+{
+    let axisSize = system->SectorWidth * (int32_t) span_Length(system->Sectors);
+    return ((GetVector4AxisValue(vector, system->SectorAxis) + system->SectorShift) % axisSize) / system->SectorWidth;
+}
+
+// Get the sector id of the passed environment on the passed sublattice system (Includes the cyclic sector shift)
+static inline int32_t GetEnvironmentSectorId(const KmcSublatticeSystem_t*restrict system, const EnvironmentState_t*restrict environment)
+{
+    return GetVector4SectorId(system, &environment->LatticeVector);
+}
+
+/* Initializer routines */
+
+// Builds the sector system of the sublattice parallel KMC or MMC mode (Has an effect only if a mode is active, deactivates the mode if the lattice cannot be cut into sectors)
+void BuildKmcSublatticeSystem(SCONTEXT_PARAMETER);
+
+/* Simulation routines */
+
+// Run the kmc simulation for one execution block using the sublattice parallel execution on the set number of threads
+error_t RunOneSublatticeKmcExecutionBlock(SCONTEXT_PARAMETER);
+
+// Run the mmc simulation for one execution block using the sublattice parallel execution on the set number of threads
+error_t RunOneSublatticeMmcExecutionBlock(SCONTEXT_PARAMETER);
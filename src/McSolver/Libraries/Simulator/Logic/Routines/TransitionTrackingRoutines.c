@@ -295,4 +295,34 @@ double FindDynamicJumpHistogramMaxValue(const DynamicJumpHistogram_t*restrict ju
     }
 
     return jumpHistogram->Header->MinValue + (double) id * jumpHistogram->Header->Stepping;
-}
\ No newline at end of file
+}
+
+// Sums the counter values of a dynamic jump histogram (Overflow and underflow counts are excluded)
+static int64_t SumDynamicJumpHistogramCounts(const DynamicJumpHistogram_t*restrict jumpHistogram)
+{
+    int64_t result = 0;
+    cpp_foreach(counter, jumpHistogram->Counters) result += *counter;
+    return result;
+}
+
+double CalculateDynamicJumpHistogramOverlap(const DynamicJumpHistogram_t*restrict lhs, const DynamicJumpHistogram_t*restrict rhs)
+{
+    let lhsTotal = SumDynamicJumpHistogramCounts(lhs);
+    let rhsTotal = SumDynamicJumpHistogramCounts(rhs);
+    return_if(lhsTotal == 0 || rhsTotal == 0, 0.0);
+
+    // Note: The bins of the right histogram are looked up at the center of each bin of the left one, thus both histograms should have similar stepping
+    double overlap = 0.0;
+    for (int64_t i = 0; i < lhs->Header->EntryCount; i++)
+    {
+        let energy = lhs->Header->MinValue + ((double) i + 0.5) * lhs->Header->Stepping;
+        continue_if(energy < rhs->Header->MinValue);
+        let rhsId = (int64_t) ((energy - rhs->Header->MinValue) * rhs->Header->SteppingInverse);
+        continue_if(rhsId >= rhs->Header->EntryCount);
+
+        let lhsValue = (double) span_Get(lhs->Counters, i) / (double) lhsTotal;
+        let rhsValue = (double) span_Get(rhs->Counters, rhsId) / (double) rhsTotal;
+        overlap += getMinOfTwo(lhsValue, rhsValue);
+    }
+    return overlap;
+}
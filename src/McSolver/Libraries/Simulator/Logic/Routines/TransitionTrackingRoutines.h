@@ -80,7 +80,7 @@ static inline DynamicJumpHistogram_t ctor_DynamicJumpHistogram_FromBuffer(const
     if (buffer == NULL) return (DynamicJumpHistogram_t) {0,{0,0}};
     let entryCount = ((DynamicJumpHistogramHeader_t*) buffer)->EntryCount;
     var histogram = ctor_DynamicJumpHistogram(entryCount);
-    memcpy(&histogram.Header, buffer, sizeof(DynamicJumpHistogramHeader_t) + span_ByteCount(histogram.Counters));
+    memcpy(histogram.Header, buffer, sizeof(DynamicJumpHistogramHeader_t) + span_ByteCount(histogram.Counters));
     return histogram;
 }
 
@@ -112,4 +112,7 @@ error_t ChangeDynamicJumpHistogramSamplingAreaByRange(DynamicJumpHistogram_t*res
 double CalculateDynamicJumpHistogramMeanEnergy(const DynamicJumpHistogram_t*restrict jumpHistogram);
 
 // Finds the energy value with the highest number of counts in the provided histogram
-double FindDynamicJumpHistogramMaxValue(const DynamicJumpHistogram_t*restrict jumpHistogram);
\ No newline at end of file
+double FindDynamicJumpHistogramMaxValue(const DynamicJumpHistogram_t*restrict jumpHistogram);
+
+// Calculates the overlap coefficient of the normalized counts of two dynamic jump histograms. Returns a value between 0 (disjoint) and 1 (identical)
+double CalculateDynamicJumpHistogramOverlap(const DynamicJumpHistogram_t*restrict lhs, const DynamicJumpHistogram_t*restrict rhs);
\ No newline at end of file
@@ -8,11 +8,42 @@
 // Short:   Main simulation entry point //
 //////////////////////////////////////////
 
+#include <pthread.h>
 #include "Libraries/Framework/Basic/RoutineLoading.h"
 #include "Libraries/ProgressPrint/ProgressPrint.h"
 #include "Libraries/JobLoader/JobLoader.h"
 #include "Libraries/Simulator/Logic/Routines/MainRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/DistributedKmcRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/ParameterSweepRoutines.h"
+#include "Libraries/Simulator/Logic/Routines/EnsembleRoutines.h"
 #include "Libraries/Simulator/Logic/Initialization/CmdArgumentResolver.h"
+#include "Libraries/Simulator/Logic/Initialization/SimulationContextInitialization.h"
+
+// Type for the shared data of the job batch mode that is accessed by all batch worker threads
+typedef struct JobBatchRun
+{
+    // The batch context that holds the resolved command line arguments
+    const SimulationContext_t*  BatchContext;
+
+    // The model cache that provides the shared sub-models of the batch jobs
+    JobDbModelCache_t           ModelCache;
+
+    // The job queue of the worker mode (NULL if the job ids are claimed from the job id span)
+    JobQueue_t*                 Queue;
+
+    // The job ids of the batch
+    IdMappingSpan_t             JobIds;
+
+    // The index of the next job that is not yet claimed by a worker
+    int32_t                     NextJobIndex;
+
+    // The number of jobs that were run by the workers of this process
+    int32_t                     RunJobCount;
+
+    // The mutex that protects the job claiming
+    pthread_mutex_t             Mutex;
+
+} JobBatchRun_t;
 
 // Internal main function that requires argv to be in utf8 encoding
 static int InternalMain(int argc, char const * const *argv);
@@ -38,12 +69,172 @@ int main(int argc, char const * const *argv)
 }
 #endif
 
+// Runs a single job of the batch on a new simulation context and frees the job specific data afterwards
+static void RunJobOfBatch(JobBatchRun_t*restrict batchRun, const int32_t jobId)
+{
+    var simContext = ctor_SimulationContext();
+    var error = ResolveMocassinBatchJobArguments(&simContext, batchRun->BatchContext, jobId);
+    assert_success(error, "Failed to prepare the I/O directory of a batch job.");
+
+    LoadMocassinSimulationDatabaseModelToContextFromCache(&simContext, &batchRun->ModelCache);
+    PrepareSimulationContextForMainRoutine(&simContext);
+
+    var routine = TryFindMocassinExtensionRoutine(getCustomRoutineUuid(&simContext),
+                                                  getFileInformation(&simContext)->ExtensionLookupPath);
+    if (routine != NULL)
+    {
+        fprintf(stdout, "[Batch-Info]: Job %i enters the specified custom routine.\n", jobId);
+        routine(&simContext);
+    }
+    else if (IsMainSimulationRoutineCompleted(&simContext))
+    {
+        fprintf(stdout, "[Batch-Info]: Job %i is already completed.\n", jobId);
+    }
+    else
+    {
+        StartMainSimulationRoutine(&simContext);
+        PrintMocassinSimulationFinishInfo(&simContext, stdout);
+    }
+    fflush(stdout);
+
+    DeleteSimulationContextDynamicBuffers(&simContext);
+    DeleteMocassinCachedDatabaseModelOfContext(&simContext);
+    DeleteMocassinBatchJobArguments(&simContext);
+}
+
+// Claims the next job of the batch from the job queue or the job id span. Returns a negative job id if all jobs are claimed
+static int32_t ClaimNextJobOfBatch(JobBatchRun_t*restrict batchRun)
+{
+    if (batchRun->Queue != NULL)
+    {
+        int32_t jobId;
+        let error = ClaimNextJobOfQueue(batchRun->Queue, &jobId);
+        assert_success(error, "Failed to claim the next job from the job queue.");
+        return jobId;
+    }
+
+    pthread_mutex_lock(&batchRun->Mutex);
+    let jobIndex = batchRun->NextJobIndex++;
+    pthread_mutex_unlock(&batchRun->Mutex);
+    return (jobIndex < span_Length(batchRun->JobIds)) ? span_Get(batchRun->JobIds, jobIndex) : -1;
+}
+
+// Batch worker thread entry that claims and runs jobs of the batch until all jobs are claimed
+static void* JobBatchWorkerThreadMain(void* args)
+{
+    JobBatchRun_t* batchRun = args;
+    for (;;)
+    {
+        let jobId = ClaimNextJobOfBatch(batchRun);
+        break_if(jobId < 0);
+
+        let startTime = time(NULL);
+        RunJobOfBatch(batchRun, jobId);
+        pthread_mutex_lock(&batchRun->Mutex);
+        batchRun->RunJobCount++;
+        pthread_mutex_unlock(&batchRun->Mutex);
+        continue_if(batchRun->Queue == NULL);
+
+        let error = FinishJobOfQueue(batchRun->Queue, jobId, difftime(time(NULL), startTime));
+        assert_success(error, "Failed to mark a finished job on the job queue.");
+    }
+    return NULL;
+}
+
+// Runs all jobs of the set job id range or job queue on the set number of threads with shared sub-models, the calling thread acts as worker zero
+static void RunMocassinJobBatch(SCONTEXT_PARAMETER)
+{
+    error_t error;
+    JobQueue_t jobQueue;
+    let fileInfo = getFileInformation(simContext);
+    assert_true(GetDistributedRankCount() == 1, ERR_CMDARGUMENT, "The job batch mode cannot be combined with the distributed mode.");
+    assert_true(!isParameterSweepModeRequested(simContext), ERR_CMDARGUMENT, "The job batch mode cannot be combined with the parameter sweep mode.");
+    assert_true(!isEnsembleModeRequested(simContext), ERR_CMDARGUMENT, "The job batch mode cannot be combined with the ensemble mode.");
+
+    // Note: The worker mode also accepts a single job id, then the queue is filled by other workers or a previous run
+    JobBatchRun_t batchRun = {.BatchContext = simContext, .NextJobIndex = 0, .RunJobCount = 0, .Queue = NULL};
+    let jobIdQuery = (fileInfo->JobBatchQuery != NULL) ? fileInfo->JobBatchQuery : fileInfo->JobDbQuery;
+    var jobCount = ParseJobIdRangeString(jobIdQuery, NULL);
+    assert_true(jobCount > 0, ERR_CMDARGUMENT, "The worker mode requires a numeric job id or a job id range.");
+    batchRun.JobIds = span_New(batchRun.JobIds, jobCount);
+    ParseJobIdRangeString(jobIdQuery, batchRun.JobIds.Begin);
+
+    if (isJobQueueModeRequested(simContext))
+    {
+        int32_t queueSize;
+        error = OpenJobQueue(&jobQueue, fileInfo->JobQueuePath, batchRun.JobIds.Begin, jobCount, &queueSize);
+        assert_success(error, "Failed to open or create the job queue of the worker mode.");
+        batchRun.Queue = &jobQueue;
+        jobCount = getMaxOfTwo(jobCount, queueSize);
+        fprintf(stdout, "[Init-Info]: Working on a job queue of %i jobs (%s).\n", queueSize, fileInfo->JobQueuePath);
+    }
+
+    error = OpenJobDbModelCache(&batchRun.ModelCache, fileInfo->JobDbPath, jobCount);
+    assert_success(error, "Failed to open the database model cache of the job batch.");
+    error = pthread_mutex_init(&batchRun.Mutex, NULL) == 0 ? ERR_OK : ERR_UNKNOWN;
+    assert_success(error, "Failed to create the job claiming mutex of the job batch.");
+
+    let threadCount = getMinOfTwo(getBatchThreadCount(simContext), jobCount);
+    pthread_t threads[threadCount];
+    fprintf(stdout, "[Init-Info]: Running a batch of up to %i jobs on %i threads.\n", jobCount, threadCount);
+    fflush(stdout);
+
+    for (int32_t i = 1; i < threadCount; i++)
+    {
+        error = pthread_create(&threads[i], NULL, JobBatchWorkerThreadMain, &batchRun) == 0 ? ERR_OK : ERR_UNKNOWN;
+        assert_success(error, "Failed to start a worker thread of the job batch.");
+    }
+    JobBatchWorkerThreadMain(&batchRun);
+    for (int32_t i = 1; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+
+    fprintf(stdout, "[Batch-Info]: Finished a batch of %i jobs using %i structure, %i energy and %i transition models.\n", batchRun.RunJobCount,
+            (int32_t) span_Length(batchRun.ModelCache.StructureModels), (int32_t) span_Length(batchRun.ModelCache.EnergyModels),
+            (int32_t) span_Length(batchRun.ModelCache.TransitionModels));
+
+    CloseJobDbModelCache(&batchRun.ModelCache);
+    if (batchRun.Queue != NULL) CloseJobQueue(batchRun.Queue);
+    pthread_mutex_destroy(&batchRun.Mutex);
+    span_Delete(batchRun.JobIds);
+}
+
 static int InternalMain(int argc, char const * const *argv)
 {
     // General preparations for routine execution
+    StartDistributedProcessEnvironment();
     var simContext = ctor_SimulationContext();
     ResolveMocassinCommandLineArguments(&simContext, argc, argv);
+
+    // Run the jobs of a set job id range or a job queue with shared sub-models if the batch or worker mode is requested
+    if (isJobBatchModeRequested(&simContext) || isJobQueueModeRequested(&simContext))
+    {
+        RunMocassinJobBatch(&simContext);
+        FinishDistributedProcessEnvironment();
+        return 0;
+    }
+
     LoadMocassinSimulationDatabaseModelToContext(&simContext);
+
+    // Run the temperature/field series on a single context if the parameter sweep mode is requested
+    if (isParameterSweepModeRequested(&simContext))
+    {
+        let routine = TryFindMocassinExtensionRoutine(getCustomRoutineUuid(&simContext), getFileInformation(&simContext)->ExtensionLookupPath);
+        assert_true(routine == NULL, ERR_CMDARGUMENT, "The parameter sweep mode cannot be combined with a custom extension routine.");
+        StartParameterSweepRoutine(&simContext);
+        FinishDistributedProcessEnvironment();
+        return 0;
+    }
+
+    // Run the independent walkers of the job with a shared model and merged statistics if the ensemble mode is requested
+    if (isEnsembleModeRequested(&simContext))
+    {
+        let routine = TryFindMocassinExtensionRoutine(getCustomRoutineUuid(&simContext), getFileInformation(&simContext)->ExtensionLookupPath);
+        assert_true(routine == NULL, ERR_CMDARGUMENT, "The ensemble mode cannot be combined with a custom extension routine.");
+        StartEnsembleRoutine(&simContext);
+        FinishDistributedProcessEnvironment();
+        return 0;
+    }
+
     PrepareSimulationContextForMainRoutine(&simContext);
 
     // Load and jump into a custom extension routine if valid data exists
@@ -54,12 +245,15 @@ static int InternalMain(int argc, char const * const *argv)
         fprintf(stdout, "[Init-Info]: Entering specified custom routine.\n");
         PrintMocassinSimulationStartInfo(&simContext, stdout);
         fflush(stdout);
-        return (routine(&simContext), 0);
+        routine(&simContext);
+        FinishDistributedProcessEnvironment();
+        return 0;
     }
 
     // Jump into the usual KMC/MMM system if no extension routine data exist
     StartMainSimulationRoutine(&simContext);
     PrintMocassinSimulationFinishInfo(&simContext, stdout);
+    FinishDistributedProcessEnvironment();
 
     #if defined(MC_AWAIT_TERMINATION_OK)
     getchar();
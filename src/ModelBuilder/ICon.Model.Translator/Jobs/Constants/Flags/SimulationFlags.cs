@@ -52,7 +52,28 @@ namespace Mocassin.Model.Translator.Jobs
         /// <summary>
         ///     Marks a simulation to use the fast exponential approximation by N. Schraudolph
         /// </summary>
-        UseFastExp = 1 << 6
+        UseFastExp = 1 << 6,
+
+        /// <summary>
+        ///     Marks a kinetic simulation to use the rejection-free (n-fold way) event selection
+        /// </summary>
+        UseRejectionFree = 1 << 7,
+
+        /// <summary>
+        ///     Marks a simulation to select only jumps that have a jump rule for the current path occupation (KMC) or only
+        ///     exchanges with a valid partner particle (MMC)
+        /// </summary>
+        UseSelectionMasks = 1 << 8,
+
+        /// <summary>
+        ///     Marks a simulation to select jumps from a flat jump slot table with a single bounded random number
+        /// </summary>
+        UseFlatSlotTable = 1 << 9,
+
+        /// <summary>
+        ///     Marks a KMC simulation to reject jumps by per rule energy envelopes before the final state energy calculation
+        /// </summary>
+        UseEarlyRejection = 1 << 10
     }
 
     /// <summary>
@@ -75,7 +96,28 @@ namespace Mocassin.Model.Translator.Jobs
         /// <summary>
         ///     Marks a simulation to use the fast exponential approximation by N. Schraudolph
         /// </summary>
-        UseFastExp = SimulationExecutionFlags.UseFastExp
+        UseFastExp = SimulationExecutionFlags.UseFastExp,
+
+        /// <summary>
+        ///     Marks a kinetic simulation to use the rejection-free (n-fold way) event selection
+        /// </summary>
+        UseRejectionFree = SimulationExecutionFlags.UseRejectionFree,
+
+        /// <summary>
+        ///     Marks a simulation to select only jumps that have a jump rule for the current path occupation (KMC) or only
+        ///     exchanges with a valid partner particle (MMC)
+        /// </summary>
+        UseSelectionMasks = SimulationExecutionFlags.UseSelectionMasks,
+
+        /// <summary>
+        ///     Marks a simulation to select jumps from a flat jump slot table with a single bounded random number
+        /// </summary>
+        UseFlatSlotTable = SimulationExecutionFlags.UseFlatSlotTable,
+
+        /// <summary>
+        ///     Marks a KMC simulation to reject jumps by per rule energy envelopes before the final state energy calculation
+        /// </summary>
+        UseEarlyRejection = SimulationExecutionFlags.UseEarlyRejection
     }
 
     /// <summary>
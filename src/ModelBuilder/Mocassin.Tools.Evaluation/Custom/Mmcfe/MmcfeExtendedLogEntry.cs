@@ -25,7 +25,8 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
 
         /// <summary>
         ///     Creates an <see cref="MmcfeExtendedLogEntry" /> from a <see cref="MmcfeLogEntry" /> and
-        ///     <see cref="MmcfeLogMetaEntry" />. This implicitly adds the particle count string to the meta entry
+        ///     <see cref="MmcfeLogMetaEntry" />. This implicitly adds the particle count string to the meta entry if the log
+        ///     entry has a state
         /// </summary>
         /// <param name="logEntry"></param>
         /// <param name="metaEntry"></param>
@@ -36,7 +37,8 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
             if (logEntry == null) throw new ArgumentNullException(nameof(logEntry));
             if (metaEntry == null) throw new ArgumentNullException(nameof(metaEntry));
 
-            metaEntry.ParticleCountInfo = BuildParticleCountString(logEntry.StateBytes);
+            if (logEntry.StateBytes != null && logEntry.StateBytes.Length != 0)
+                metaEntry.ParticleCountInfo = BuildParticleCountString(logEntry.StateBytes);
             return new MmcfeExtendedLogEntry
             {
                 MetaEntry = metaEntry,
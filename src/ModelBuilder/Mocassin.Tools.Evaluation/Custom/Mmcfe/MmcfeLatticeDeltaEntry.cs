@@ -0,0 +1,52 @@
+﻿using System;
+using System.ComponentModel.DataAnnotations.Schema;
+using Mocassin.Model.Translator;
+
+namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
+{
+    /// <summary>
+    ///     The <see cref="EntityBase" /> implementation for the lattice changes of an MMCFE log entry that was written
+    ///     without a state in the delta log storage mode
+    /// </summary>
+    public class MmcfeLatticeDeltaEntry : EntityBase
+    {
+        /// <summary>
+        ///     Get the size of a single lattice change in the binary representation
+        /// </summary>
+        public static int ChangeByteCount { get; } = 8;
+
+        /// <summary>
+        ///     Get or set the id of the <see cref="MmcfeLogEntry" /> that the changes belong to
+        /// </summary>
+        [Column("LogEntryId")]
+        public int LogEntryId { get; set; }
+
+        /// <summary>
+        ///     Get or set the id of the previous <see cref="MmcfeLogEntry" /> that the changes are relative to
+        /// </summary>
+        [Column("PreviousEntryId")]
+        public int PreviousEntryId { get; set; }
+
+        /// <summary>
+        ///     Get or set the binary representation of the lattice changes as (int, byte, 3 byte padding) entries
+        /// </summary>
+        [Column("Changes")]
+        public byte[] ChangeBytes { get; set; }
+
+        /// <summary>
+        ///     Applies the lattice changes to the provided lattice <see cref="Span{T}" />
+        /// </summary>
+        /// <param name="lattice"></param>
+        public void ApplyTo(Span<byte> lattice)
+        {
+            if (ChangeBytes == null) return;
+            if (ChangeBytes.Length % ChangeByteCount != 0) throw new InvalidOperationException("Lattice change byte array has wrong size.");
+
+            for (var offset = 0; offset < ChangeBytes.Length; offset += ChangeByteCount)
+            {
+                var environmentId = BitConverter.ToInt32(ChangeBytes, offset);
+                lattice[environmentId] = ChangeBytes[offset + sizeof(int)];
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
-﻿using Microsoft.EntityFrameworkCore;
+﻿using System;
+using Microsoft.EntityFrameworkCore;
 using Mocassin.Framework.SQLiteCore;
 
 namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
@@ -13,6 +14,11 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         /// </summary>
         public DbSet<MmcfeLogEntry> LogEntries { get; set; }
 
+        /// <summary>
+        ///     Get or set the <see cref="DbSet{TEntity}" /> of <see cref="MmcfeLatticeDeltaEntry" /> (Only exists in the delta log storage mode)
+        /// </summary>
+        public DbSet<MmcfeLatticeDeltaEntry> LatticeDeltas { get; set; }
+
         /// <inheritdoc />
         public MmcfeLogDbContext(string optionsBuilderParameterString)
             : base(optionsBuilderParameterString)
@@ -23,7 +29,28 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         protected override void OnModelCreating(ModelBuilder modelBuilder)
         {
             modelBuilder.Entity<MmcfeLogEntry>().ToTable("LogEntries");
+            modelBuilder.Entity<MmcfeLatticeDeltaEntry>().ToTable("LatticeDeltas");
             base.OnModelCreating(modelBuilder);
         }
+
+        /// <summary>
+        ///     Checks if the database contains the lattice delta table that is written in the delta log storage mode
+        /// </summary>
+        /// <returns></returns>
+        public bool HasLatticeDeltaTable()
+        {
+            var connection = Database.GetDbConnection();
+            try
+            {
+                connection.Open();
+                using var command = connection.CreateCommand();
+                command.CommandText = "SELECT COUNT(*) FROM sqlite_master WHERE type='table' AND name='LatticeDeltas'";
+                return Convert.ToInt64(command.ExecuteScalar()) > 0;
+            }
+            finally
+            {
+                connection.Close();
+            }
+        }
     }
 }
\ No newline at end of file
@@ -15,6 +15,11 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         /// </summary>
         public ReadOnlyDbContext DataContext { get; }
 
+        /// <summary>
+        ///     Get a boolean flag if the log database contains lattice deltas of the delta log storage mode
+        /// </summary>
+        public bool HasLatticeDeltas { get; }
+
         /// <summary>
         ///     Creates a ne <see cref="MmcfeLogEvaluationContext" /> using the provided <see cref="MmcfeLogDbContext" />
         /// </summary>
@@ -22,6 +27,7 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         public MmcfeLogEvaluationContext(MmcfeLogDbContext dataContext)
         {
             DataContext = dataContext?.AsReadOnly() ?? throw new ArgumentNullException(nameof(dataContext));
+            HasLatticeDeltas = dataContext.HasLatticeDeltaTable();
         }
 
         /// <inheritdoc />
@@ -34,7 +40,7 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         ///     Gets a non-tracking <see cref="IQueryable{T}" /> of the <see cref="MmcfeLogEntry" /> set
         /// </summary>
         /// <returns></returns>
-        public IQueryable<MmcfeLogEntry> LogSet() => DataContext.Set<MmcfeLogEntry>();
+        public IQueryable<MmcfeLogEntry> LogSet() => HasLatticeDeltas ? RestoreDeltaStates(DataContext.Set<MmcfeLogEntry>()) : DataContext.Set<MmcfeLogEntry>();
 
         /// <summary>
         ///     Gets a <see cref="IQueryable{T}" /> of <see cref="MmcfeLogReader" /> for all <see cref="MmcfeLogEntry" />
@@ -43,6 +49,52 @@ namespace Mocassin.Tools.Evaluation.Custom.Mmcfe
         /// <returns></returns>
         public IQueryable<MmcfeLogReader> FullReaderSet() => CreateReaders(LogSet());
 
+        /// <summary>
+        ///     Restores the states of the delta <see cref="MmcfeLogEntry" /> entities from the preceding entries and the
+        ///     <see cref="MmcfeLatticeDeltaEntry" /> set. The restored states hold the lattice of the entry and the remaining
+        ///     data of the last key entry
+        /// </summary>
+        /// <param name="entries"></param>
+        /// <returns></returns>
+        private IQueryable<MmcfeLogEntry> RestoreDeltaStates(IQueryable<MmcfeLogEntry> entries)
+        {
+            var deltas = DataContext.Set<MmcfeLatticeDeltaEntry>().ToDictionary(x => x.LogEntryId);
+            var result = entries.OrderBy(x => x.Id).ToList();
+            MmcfeLogEntry previous = null;
+            foreach (var entry in result)
+            {
+                if (deltas.TryGetValue(entry.Id, out var delta))
+                {
+                    if (previous == null || delta.PreviousEntryId != previous.Id)
+                        throw new InvalidOperationException($"The lattice delta of log entry {entry.Id} has no preceding state.");
+                    entry.StateBytes = RestoreStateBytes(previous.StateBytes, delta);
+                }
+
+                previous = entry;
+            }
+
+            return result.AsQueryable();
+        }
+
+        /// <summary>
+        ///     Creates the state bytes of a delta entry by applying the <see cref="MmcfeLatticeDeltaEntry" /> to a copy of the
+        ///     state bytes of the preceding entry
+        /// </summary>
+        /// <param name="previousStateBytes"></param>
+        /// <param name="delta"></param>
+        /// <returns></returns>
+        private static byte[] RestoreStateBytes(byte[] previousStateBytes, MmcfeLatticeDeltaEntry delta)
+        {
+            if (previousStateBytes == null || previousStateBytes.Length == 0)
+                throw new InvalidOperationException($"The lattice delta of log entry {delta.LogEntryId} has no preceding state.");
+
+            var stateBytes = (byte[]) previousStateBytes.Clone();
+            using var stateReader = McsContentReader.Create(stateBytes);
+            var latticeOffset = stateReader.Header.LatticeOffset;
+            delta.ApplyTo(stateBytes.AsSpan(latticeOffset, stateReader.Header.CountersOffset - latticeOffset));
+            return stateBytes;
+        }
+
         /// <summary>
         ///     Creates a <see cref="IQueryable{T}" /> of <see cref="MmcfeLogReader" /> from a <see cref="IQueryable{T}" /> of
         ///     <see cref="MmcfeLogEntry" />
@@ -16,7 +16,7 @@ namespace Mocassin.Tools.UAccess.Readers
         private BinaryStructureReader ParameterReader { get; }
 
         /// <summary>
-        ///     Get the <see cref="McsContentReader" /> for the simulation state
+        ///     Get the <see cref="McsContentReader" /> for the simulation state (Null if the log entry has no state)
         /// </summary>
         public McsContentReader StateReader { get; }
 
@@ -35,7 +35,7 @@ namespace Mocassin.Tools.UAccess.Readers
         private MmcfeLogReader(BinaryStructureReader parameterReader, McsContentReader stateReader, DynamicHistogramReader energyHistogramReader)
         {
             ParameterReader = parameterReader ?? throw new ArgumentNullException(nameof(parameterReader));
-            StateReader = stateReader ?? throw new ArgumentNullException(nameof(stateReader));
+            StateReader = stateReader;
             EnergyHistogramReader = energyHistogramReader ?? throw new ArgumentNullException(nameof(energyHistogramReader));
         }
 
@@ -43,7 +43,7 @@ namespace Mocassin.Tools.UAccess.Readers
         public void Dispose()
         {
             ParameterReader.Dispose();
-            StateReader.Dispose();
+            StateReader?.Dispose();
             EnergyHistogramReader.Dispose();
         }
 
@@ -55,7 +55,7 @@ namespace Mocassin.Tools.UAccess.Readers
 
         /// <summary>
         ///     Creates a new <see cref="MmcfeLogReader" /> for the provided set of binary representations and performs consistency
-        ///     checks
+        ///     checks. An empty state binary representation is allowed for log entries of the histogram log storage mode
         /// </summary>
         /// <param name="stateBytes"></param>
         /// <param name="histogramBytes"></param>
@@ -64,7 +64,7 @@ namespace Mocassin.Tools.UAccess.Readers
         public static MmcfeLogReader Create(byte[] stateBytes, byte[] histogramBytes, byte[] parameterBytes)
         {
             var histogramReader = DynamicHistogramReader.Create(histogramBytes);
-            var stateReader = McsContentReader.Create(stateBytes);
+            var stateReader = stateBytes == null || stateBytes.Length == 0 ? null : McsContentReader.Create(stateBytes);
             if (parameterBytes.Length != Marshal.SizeOf<CMmcfeParams>()) throw new InvalidOperationException("Parameter byte array has wrong size.");
             var parameterReader = new BinaryStructureReader(parameterBytes);
             return new MmcfeLogReader(parameterReader, stateReader, histogramReader);